@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include "libcuebin/cueParser.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace cuebin;
+
+namespace {
+
+std::string msf(int lba)
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%02d:%02d:%02d", lba / 4500, lba / 75 % 60, lba % 75);
+    return buf;
+}
+
+std::string smallSheet()
+{
+    return "FILE \"game.bin\" BINARY\n"
+           "  TRACK 01 MODE2/2352\n"
+           "    INDEX 01 00:00:00\n";
+}
+
+// Ripper logs and tool metadata, as found in sheets from EAC and redump
+std::string remHeavySheet()
+{
+    std::string text = "REM GENRE \"Role Playing\"\nREM DATE 1997\nREM DISCID 0A0B0C0D\n";
+    for (int i = 0; i < 5000; ++i) {
+        text += "REM COMMENT \"ExactAudioCopy v1.6 log line " + std::to_string(i) + "\"\n";
+    }
+    text += smallSheet();
+    return text;
+}
+
+// One file, 99 tracks, each with the full set of per-track directives
+std::string fullTrackSheet()
+{
+    std::string text = "CATALOG 0000000000000\nPERFORMER \"Square\"\nTITLE \"Disc\"\n"
+                       "FILE \"game.bin\" BINARY\n";
+    for (int t = 1; t <= 99; ++t) {
+        char num[4];
+        std::snprintf(num, sizeof(num), "%02d", t);
+        text += std::string("  TRACK ") + num + (t == 1 ? " MODE2/2352\n" : " AUDIO\n");
+        text += "    TITLE \"Track " + std::string(num) + "\"\n";
+        text += "    PERFORMER \"Composer\"\n";
+        text += "    ISRC JPSQ09700" + std::string(num) + "0\n";
+        text += "    FLAGS DCP\n";
+        if (t > 1) text += "    INDEX 00 " + msf(t * 3000 - 150) + "\n";
+        text += "    INDEX 01 " + msf(t * 3000) + "\n";
+    }
+    return text;
+}
+
+void runParse(benchmark::State& state, const std::string& text)
+{
+    for (auto _ : state) {
+        auto sheet = CueParser::parseString(text);
+        benchmark::DoNotOptimize(sheet);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+
+void BM_ParseSmall(benchmark::State& state) { runParse(state, smallSheet()); }
+void BM_ParseRemHeavy(benchmark::State& state) { runParse(state, remHeavySheet()); }
+void BM_Parse99Tracks(benchmark::State& state) { runParse(state, fullTrackSheet()); }
+
+} // anonymous namespace
+
+BENCHMARK(BM_ParseSmall);
+BENCHMARK(BM_ParseRemHeavy);
+BENCHMARK(BM_Parse99Tracks);
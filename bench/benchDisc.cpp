@@ -0,0 +1,194 @@
+#include <benchmark/benchmark.h>
+#include "libcuebin/disc.hpp"
+
+#include "benchImages.hpp"
+
+#include <array>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+// Benchmarks taking a backend argument pass it as the IoBackend value
+constexpr int STREAM = static_cast<int>(IoBackend::Stream);
+constexpr int MMAP = static_cast<int>(IoBackend::Mmap);
+constexpr int POSITIONAL = static_cast<int>(IoBackend::Positional);
+
+const char* backendName(IoBackend backend)
+{
+    switch (backend) {
+        case IoBackend::Stream: return "stream";
+        case IoBackend::Mmap: return "mmap";
+        case IoBackend::Positional: return "positional";
+    }
+    return "";
+}
+
+// Discs are opened once per image and backend and shared by every run and
+// thread. The block cache stays off, as by default, so reads measure the
+// backend itself.
+const Disc* openDisc(benchmark::State& state, const char* cue, IoBackend backend)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<std::string, IoBackend>, std::unique_ptr<Disc>> discs;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = discs[{cue, backend}];
+    if (!slot) {
+        DiscOptions options;
+        options.ioBackend = backend;
+        auto disc = Disc::fromCue(std::filesystem::path(BENCH_IMAGE_DIR) / cue, options);
+        if (!disc) {
+            state.SkipWithError(disc.error().message.c_str());
+            return nullptr;
+        }
+        slot = std::make_unique<Disc>(std::move(*disc));
+    }
+    state.SetLabel(backendName(backend));
+    return slot.get();
+}
+
+std::vector<int32_t> randomLbas(int32_t total, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int32_t> dist(0, total - 1);
+    std::vector<int32_t> lbas(4096);
+    for (auto& lba : lbas) lba = dist(rng);
+    return lbas;
+}
+
+void setSectorsProcessed(benchmark::State& state, int64_t sectorsPerIteration)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * sectorsPerIteration);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sectorsPerIteration
+                            * static_cast<int64_t>(RAW_SECTOR_SIZE));
+}
+
+void BM_FindTrack(benchmark::State& state)
+{
+    const Disc* disc = openDisc(state, benchImages::TRACKS99_CUE, IoBackend::Positional);
+    if (!disc) return;
+    auto lbas = randomLbas(disc->totalSectors(), 1);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(disc->findTrack(lbas[i]));
+        if (++i == lbas.size()) i = 0;
+    }
+    state.SetLabel("99 tracks");
+}
+
+void BM_ReadSectorSequential(benchmark::State& state)
+{
+    const Disc* disc = openDisc(state, benchImages::SINGLE_CUE, static_cast<IoBackend>(state.range(0)));
+    if (!disc) return;
+    int32_t total = disc->totalSectors();
+    int32_t lba = 0;
+    for (auto _ : state) {
+        auto sector = disc->readSector(lba);
+        benchmark::DoNotOptimize(sector);
+        if (++lba == total) lba = 0;
+    }
+    setSectorsProcessed(state, 1);
+}
+
+void BM_ReadSectorRandom(benchmark::State& state)
+{
+    const Disc* disc = openDisc(state, benchImages::SINGLE_CUE, static_cast<IoBackend>(state.range(0)));
+    if (!disc) return;
+    auto lbas = randomLbas(disc->totalSectors(), 2);
+    size_t i = 0;
+    for (auto _ : state) {
+        auto sector = disc->readSector(lbas[i]);
+        benchmark::DoNotOptimize(sector);
+        if (++i == lbas.size()) i = 0;
+    }
+    setSectorsProcessed(state, 1);
+}
+
+// Sequential batches of range(0) sectors
+void BM_ReadSectors(benchmark::State& state)
+{
+    const Disc* disc = openDisc(state, benchImages::SINGLE_CUE, IoBackend::Positional);
+    if (!disc) return;
+    auto count = static_cast<int32_t>(state.range(0));
+    int32_t total = disc->totalSectors();
+    int32_t lba = 0;
+    for (auto _ : state) {
+        auto sectors = disc->readSectors(lba, count);
+        benchmark::DoNotOptimize(sectors);
+        lba += count;
+        if (lba + count > total) lba = 0;
+    }
+    setSectorsProcessed(state, count);
+}
+
+// Same batches into a caller buffer
+void BM_ReadSectorsInto(benchmark::State& state)
+{
+    const Disc* disc = openDisc(state, benchImages::SINGLE_CUE, IoBackend::Positional);
+    if (!disc) return;
+    auto count = static_cast<int32_t>(state.range(0));
+    std::vector<uint8_t> buffer(static_cast<size_t>(count) * RAW_SECTOR_SIZE);
+    int32_t total = disc->totalSectors();
+    int32_t lba = 0;
+    for (auto _ : state) {
+        auto status = disc->readSectorsInto(lba, count, buffer);
+        benchmark::DoNotOptimize(status);
+        lba += count;
+        if (lba + count > total) lba = 0;
+    }
+    setSectorsProcessed(state, count);
+}
+
+// Every thread reads random sectors of the one BIN file
+void BM_ParallelReadSingleFile(benchmark::State& state)
+{
+    const Disc* disc = openDisc(state, benchImages::SINGLE_CUE, static_cast<IoBackend>(state.range(0)));
+    if (!disc) return;
+    auto lbas = randomLbas(disc->totalSectors(), 100 + static_cast<uint32_t>(state.thread_index()));
+    std::array<uint8_t, RAW_SECTOR_SIZE> buffer;
+    size_t i = 0;
+    for (auto _ : state) {
+        auto status = disc->readSectorInto(lbas[i], buffer);
+        benchmark::DoNotOptimize(status);
+        if (++i == lbas.size()) i = 0;
+    }
+    setSectorsProcessed(state, 1);
+}
+
+// Each thread reads random sectors of its own BIN file
+void BM_ParallelReadMultiFile(benchmark::State& state)
+{
+    const Disc* disc = openDisc(state, benchImages::MULTI_CUE, static_cast<IoBackend>(state.range(0)));
+    if (!disc) return;
+    const Track& track = disc->tracks()[static_cast<size_t>(state.thread_index()) % disc->trackCount()];
+    auto lbas = randomLbas(track.lengthSectors(), 200 + static_cast<uint32_t>(state.thread_index()));
+    for (auto& lba : lbas) lba += track.startLba();
+    std::array<uint8_t, RAW_SECTOR_SIZE> buffer;
+    size_t i = 0;
+    for (auto _ : state) {
+        auto status = disc->readSectorInto(lbas[i], buffer);
+        benchmark::DoNotOptimize(status);
+        if (++i == lbas.size()) i = 0;
+    }
+    setSectorsProcessed(state, 1);
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_FindTrack);
+BENCHMARK(BM_ReadSectorSequential)->ArgName("backend")->Arg(STREAM)->Arg(MMAP)->Arg(POSITIONAL);
+BENCHMARK(BM_ReadSectorRandom)->ArgName("backend")->Arg(STREAM)->Arg(MMAP)->Arg(POSITIONAL);
+BENCHMARK(BM_ReadSectors)->ArgName("sectors")->RangeMultiplier(4)->Range(1, 4096);
+BENCHMARK(BM_ReadSectorsInto)->ArgName("sectors")->RangeMultiplier(4)->Range(1, 4096);
+BENCHMARK(BM_ParallelReadSingleFile)->ArgName("backend")->Arg(STREAM)->Arg(POSITIONAL)
+    ->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ParallelReadMultiFile)->ArgName("backend")->Arg(STREAM)->Arg(POSITIONAL)
+    ->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,16 @@
+#pragma once
+
+// Layout of the images makeBenchImages generates into BENCH_IMAGE_DIR
+namespace benchImages {
+
+constexpr const char* SINGLE_CUE = "single.cue";
+constexpr int SINGLE_SECTORS = 64 * 1024; // About 150 MB
+
+constexpr const char* MULTI_CUE = "multi.cue";
+constexpr int MULTI_FILES = 8;
+constexpr int MULTI_SECTORS_PER_FILE = 8 * 1024;
+
+constexpr const char* TRACKS99_CUE = "tracks99.cue";
+constexpr int TRACKS99_SECTORS_PER_TRACK = 300;
+
+} // namespace benchImages
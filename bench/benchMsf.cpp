@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include "libcuebin/msf.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+// Every frame of the first ten minutes, as a CUE sheet would spell it
+std::vector<std::string> msfStrings()
+{
+    std::vector<std::string> out;
+    for (int32_t lba = 0; lba < 10 * MSF::FRAMES_PER_MINUTE; lba += 7) {
+        out.push_back(MSF::fromLba(lba).toString());
+    }
+    return out;
+}
+
+void BM_MsfParse(benchmark::State& state)
+{
+    auto strings = msfStrings();
+    size_t i = 0;
+    for (auto _ : state) {
+        auto msf = MSF::parse(strings[i]);
+        benchmark::DoNotOptimize(msf);
+        if (++i == strings.size()) i = 0;
+    }
+}
+
+void BM_MsfToLba(benchmark::State& state)
+{
+    std::vector<MSF> values;
+    for (int32_t lba = 0; lba < 80 * MSF::FRAMES_PER_MINUTE; lba += 13) values.push_back(MSF::fromLba(lba));
+    size_t i = 0;
+    for (auto _ : state) {
+        MSF msf = values[i];
+        benchmark::DoNotOptimize(msf);
+        int32_t lba = msf.toLba();
+        benchmark::DoNotOptimize(lba);
+        if (++i == values.size()) i = 0;
+    }
+}
+
+void BM_MsfFromLba(benchmark::State& state)
+{
+    int32_t lba = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lba);
+        MSF msf = MSF::fromLba(lba);
+        benchmark::DoNotOptimize(msf);
+        lba = (lba + 13) % (80 * MSF::FRAMES_PER_MINUTE);
+    }
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_MsfParse);
+BENCHMARK(BM_MsfToLba);
+BENCHMARK(BM_MsfFromLba);
@@ -0,0 +1,79 @@
+// Writes the disc images the benchmarks read. BIN files are created sparse
+// (sized, never written), so the images cost no disk space and reads measure
+// the library and the page cache rather than the storage device.
+//
+// Usage: makeBenchImages <output-dir>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "benchImages.hpp"
+
+namespace {
+
+std::string msf(int lba)
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%02d:%02d:%02d", lba / 4500, lba / 75 % 60, lba % 75);
+    return buf;
+}
+
+std::string trackNumber(int t)
+{
+    char buf[4];
+    std::snprintf(buf, sizeof(buf), "%02d", t);
+    return buf;
+}
+
+void sparseFile(const std::filesystem::path& path, int sectors)
+{
+    std::ofstream(path, std::ios::binary | std::ios::trunc);
+    std::filesystem::resize_file(path, static_cast<uintmax_t>(sectors) * 2352);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <output-dir>\n", argv[0]);
+        return 1;
+    }
+    std::filesystem::path dir = argv[1];
+    std::filesystem::create_directories(dir);
+
+    using namespace benchImages;
+
+    // One data track in one large file
+    sparseFile(dir / "single.bin", SINGLE_SECTORS);
+    std::ofstream(dir / SINGLE_CUE) << "FILE \"single.bin\" BINARY\n"
+                                    << "  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+
+    // A data track and audio tracks, one file each
+    {
+        std::ofstream cue(dir / MULTI_CUE);
+        for (int t = 1; t <= MULTI_FILES; ++t) {
+            std::string bin = "multi" + trackNumber(t) + ".bin";
+            sparseFile(dir / bin, MULTI_SECTORS_PER_FILE);
+            cue << "FILE \"" << bin << "\" BINARY\n"
+                << "  TRACK " << trackNumber(t) << (t == 1 ? " MODE2/2352\n" : " AUDIO\n")
+                << "    INDEX 01 00:00:00\n";
+        }
+    }
+
+    // 99 tracks in one file, each with a pregap index
+    {
+        sparseFile(dir / "tracks99.bin", 99 * TRACKS99_SECTORS_PER_TRACK);
+        std::ofstream cue(dir / TRACKS99_CUE);
+        cue << "FILE \"tracks99.bin\" BINARY\n";
+        for (int t = 1; t <= 99; ++t) {
+            int start = (t - 1) * TRACKS99_SECTORS_PER_TRACK;
+            cue << "  TRACK " << trackNumber(t) << (t == 1 ? " MODE2/2352\n" : " AUDIO\n");
+            if (t > 1) cue << "    INDEX 00 " << msf(start) << "\n";
+            cue << "    INDEX 01 " << msf(t > 1 ? start + 150 : start) << "\n";
+        }
+    }
+    return 0;
+}
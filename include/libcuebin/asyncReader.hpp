@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "libcuebin/disc.hpp"
+#include "libcuebin/error.hpp"
+#include "libcuebin/sector.hpp"
+#include "libcuebin/task.hpp"
+
+namespace cuebin {
+
+enum class AsyncBackend {
+    Auto,       // io_uring where available, thread pool otherwise
+    IoUring,    // Linux io_uring; reads bypass the block cache and read-ahead
+    ThreadPool, // Worker threads issuing ordinary Disc reads
+};
+
+struct AsyncReaderOptions {
+    AsyncBackend backend = AsyncBackend::Auto;
+    uint32_t queueDepth = 64; // io_uring submission queue entries
+    uint32_t threadCount = 2; // Thread-pool workers
+};
+
+struct AsyncCompletion {
+    uint64_t id = 0;
+    Status status;
+    const Disc* disc = nullptr;
+    int32_t lba = 0;
+    int32_t count = 0;
+    void* userData = nullptr;
+};
+
+using AsyncCallback = std::function<void(const AsyncCompletion&)>;
+
+// Non-blocking sector reads across any number of discs. Requests are
+// reported either through a per-request callback, invoked on an internal
+// thread, or through a completion queue drained with poll()/wait().
+class AsyncReader {
+public:
+    static Result<AsyncReader> create(const AsyncReaderOptions& options = {});
+
+    ~AsyncReader();
+    AsyncReader(AsyncReader&& other) noexcept;
+    AsyncReader& operator=(AsyncReader&& other) noexcept;
+
+    AsyncReader(const AsyncReader&) = delete;
+    AsyncReader& operator=(const AsyncReader&) = delete;
+
+    // Queues a read of `count` sectors laid out as by Disc::readSectorsInto().
+    // `disc`, `out` and `modes` must stay valid until the request completes.
+    // Returns the request id, or an error if the arguments are invalid.
+    Result<uint64_t> submit(const Disc& disc, int32_t lba, int32_t count,
+                            std::span<uint8_t> out, std::span<TrackMode> modes = {},
+                            AsyncCallback callback = {}, void* userData = nullptr);
+
+    // Moves up to completions.size() finished requests into `completions`
+    // without blocking. Returns the number written.
+    size_t poll(std::span<AsyncCompletion> completions);
+
+    // Like poll(), but blocks until at least `minCompletions` are available
+    // (or nothing is left in flight).
+    size_t wait(std::span<AsyncCompletion> completions, size_t minCompletions = 1);
+
+    // Coroutine versions of Disc::readSector() and Disc::readSectors(). The
+    // awaiting coroutine suspends while the read is in flight and resumes on
+    // `executor` (by default inline on the thread that completed the read).
+    Task<Result<SectorData>> readSector(const Disc& disc, int32_t lba,
+                                        Executor& executor = inlineExecutor());
+    Task<Result<std::vector<SectorData>>> readSectors(const Disc& disc, int32_t lba, int32_t count,
+                                                      Executor& executor = inlineExecutor());
+
+    size_t inFlight() const noexcept;
+
+    // The backend in use; never AsyncBackend::Auto.
+    AsyncBackend backend() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+
+    explicit AsyncReader(std::unique_ptr<Impl> impl);
+};
+
+} // namespace cuebin
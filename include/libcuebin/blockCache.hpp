@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cuebin {
+
+struct BlockCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t bytesUsed = 0;
+    size_t capacityBytes = 0;
+};
+
+// Process-wide cache of BIN file blocks, shared by every Disc that has
+// DiscOptions::useBlockCache enabled. Blocks are keyed by file identity
+// (path, size and modification time) and aligned block index, so discs
+// opened on the same image share entries. Eviction uses the CLOCK algorithm
+// within each shard; the capacity is split evenly across shards.
+class BlockCache {
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+    // Sets the memory budget in bytes, evicting blocks if it shrinks.
+    // A capacity of 0 disables caching process-wide.
+    static void setCapacity(size_t bytes);
+    static size_t capacity() noexcept;
+
+    static BlockCacheStats stats() noexcept;
+    static void resetStats() noexcept;
+
+    // Drops every cached block.
+    static void clear();
+};
+
+} // namespace cuebin
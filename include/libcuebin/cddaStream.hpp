@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "libcuebin/disc.hpp"
+#include "libcuebin/error.hpp"
+
+namespace cuebin {
+
+struct CddaStreamOptions {
+    uint8_t firstTrack = 0; // 0: first audio track of the disc
+    uint8_t lastTrack = 0;  // 0: last audio track of the disc
+
+    // Ring buffer capacity in stereo frames (588 per sector), rounded up to
+    // a power of two. The default holds about three seconds of audio.
+    size_t bufferFrames = 128 * 1024;
+    int32_t chunkSectors = 16; // Sectors per producer read
+};
+
+struct CddaPosition {
+    uint8_t track = 0;
+    uint8_t index = 0; // 0 within pregaps (PREGAP silence and INDEX 00)
+    int32_t lba = 0;
+    uint32_t frameInSector = 0;
+};
+
+// Gapless playback of a run of audio tracks. A producer thread reads the
+// sectors, inserts PREGAP/POSTGAP silence, converts big-endian (MOTOROLA)
+// files to native byte order and fills a single-producer/single-consumer
+// ring buffer. read() is meant for the audio callback: it never locks,
+// allocates or touches a file. Data tracks inside the range are skipped.
+// The Disc must outlive the stream.
+class CddaStream {
+public:
+    static constexpr size_t FRAMES_PER_SECTOR = 588;
+
+    static Result<CddaStream> open(const Disc& disc, const CddaStreamOptions& options = {});
+
+    ~CddaStream();
+    CddaStream(CddaStream&& other) noexcept;
+    CddaStream& operator=(CddaStream&& other) noexcept;
+
+    CddaStream(const CddaStream&) = delete;
+    CddaStream& operator=(const CddaStream&) = delete;
+
+    // Copies interleaved native-endian S16 stereo frames into `out`
+    // (out.size() / 2 frames). Frames the producer has not delivered yet are
+    // zero-filled and counted as an underrun. Returns the number of frames
+    // of stream audio written. Lock-free and allocation-free.
+    size_t read(std::span<int16_t> out) noexcept;
+
+    // Position of the next frame read() will return
+    CddaPosition position() const noexcept;
+
+    size_t bufferedFrames() const noexcept;
+    uint64_t totalFrames() const noexcept;
+    uint64_t underruns() const noexcept;
+
+    // True once every frame has been read, or the producer stopped on an error
+    bool finished() const noexcept;
+    // The producer's read error, if any; meaningful once finished()
+    Status status() const noexcept;
+
+private:
+    struct Impl;
+    explicit CddaStream(std::unique_ptr<Impl> impl);
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cuebin
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "libcuebin/disc.hpp"
+#include "libcuebin/error.hpp"
+
+namespace cuebin {
+
+// Compressed BIN container (".cbc"). The file is cut into fixed-size chunks
+// that are compressed independently and located through an index at the
+// end of the file, so any byte range can be read by inflating only the
+// chunks it touches. A CUE sheet may reference a .cbc file as BINARY (or
+// MOTOROLA); Disc::fromCue() recognizes it by its magic bytes.
+//
+// Layout, all integers little-endian:
+//   header  "CUEBINZ1", u32 version, u32 chunk bytes, u64 data size,
+//           u32 chunk count, u32 reserved, u64 index offset
+//   chunks  compressed chunk payloads
+//   index   per chunk: u64 offset, u32 stored size, u32 CRC32 of the
+//           decompressed bytes, u8 codec, 3 reserved bytes
+enum class ChunkCodec : uint8_t {
+    Zero = 0,         // All zero bytes; nothing stored
+    Stored = 1,       // Uncompressed
+    Deflate = 2,      // zlib stream
+    DeltaDeflate = 3, // CD-DA: per-channel 16-bit sample deltas, then zlib
+};
+
+struct CompressOptions {
+    int32_t chunkSectors = 16; // 2352-byte sectors per chunk, 1-1024
+    int level = 6;             // zlib level, 1-9
+};
+
+struct CompressStats {
+    uint64_t inputBytes = 0;
+    uint64_t outputBytes = 0;
+    uint32_t chunks = 0;
+    uint32_t codecChunks[4] = {}; // Indexed by ChunkCodec
+};
+
+struct ByteExtent {
+    int64_t begin = 0;
+    int64_t end = 0;
+};
+
+// Compresses `source` into `dest`. Chunks lying wholly inside `audio`
+// extents also try the delta codec and keep whichever result is smaller.
+Result<CompressStats> compressFile(const std::filesystem::path& source,
+                                   const std::filesystem::path& dest,
+                                   std::span<const ByteExtent> audio = {},
+                                   const CompressOptions& options = {});
+
+// Compresses every BIN file of `disc` into "<file name>.cbc" next to
+// `cuePath` and writes a CUE sheet there that references the new files.
+// WAVE and AIFF files are not supported.
+Result<CompressStats> compressDisc(const Disc& disc, const std::filesystem::path& cuePath,
+                                   const CompressOptions& options = {});
+
+} // namespace cuebin
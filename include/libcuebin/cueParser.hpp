@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory_resource>
 #include <string_view>
 
 #include "libcuebin/cueTypes.hpp"
@@ -10,8 +11,12 @@ namespace cuebin {
 
 class CueParser {
 public:
-    static Result<CueSheet> parseFile(const std::filesystem::path& path);
-    static Result<CueSheet> parseString(std::string_view content);
+    // The sheet's strings and lists are allocated from `resource`, which
+    // must outlive it. Error messages still use the default resource.
+    static Result<CueSheet> parseFile(const std::filesystem::path& path,
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    static Result<CueSheet> parseString(std::string_view content,
+                                        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 };
 
 } // namespace cuebin
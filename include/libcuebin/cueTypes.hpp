@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "libcuebin/msf.hpp"
@@ -46,33 +48,83 @@ struct CueIndex {
     MSF position;
 };
 
+// The sheet types are allocator-aware: a sheet built with a memory resource
+// (see CueParser) keeps every string and list it owns in that resource, and
+// elements added to its lists inherit it. Copies made without an allocator
+// use the default resource, as with any std::pmr container.
+using CueAllocator = std::pmr::polymorphic_allocator<>;
+
 struct CueTrack {
+    using allocator_type = CueAllocator;
+
     uint8_t number = 0;
     TrackMode mode = TrackMode::Audio;
-    std::vector<CueIndex> indices;
+    std::pmr::vector<CueIndex> indices;
     std::optional<MSF> pregap;
     std::optional<MSF> postgap;
     uint8_t flags = 0;
-    std::optional<std::string> isrc;
-    std::optional<std::string> title;
-    std::optional<std::string> performer;
-    std::optional<std::string> songwriter;
+    std::optional<std::pmr::string> isrc;
+    std::optional<std::pmr::string> title;
+    std::optional<std::pmr::string> performer;
+    std::optional<std::pmr::string> songwriter;
+
+    CueTrack() = default;
+    explicit CueTrack(const allocator_type& alloc) : indices(alloc) {}
+    CueTrack(const CueTrack& other, const allocator_type& alloc = {});
+    CueTrack(CueTrack&& other) noexcept = default;
+    CueTrack(CueTrack&& other, const allocator_type& alloc);
+    CueTrack& operator=(const CueTrack& other) = default;
+    CueTrack& operator=(CueTrack&& other) = default;
+
+    allocator_type get_allocator() const noexcept { return indices.get_allocator(); }
 };
 
 struct CueFile {
-    std::string filename;
+    using allocator_type = CueAllocator;
+
+    std::pmr::string filename;
     FileType type = FileType::Binary;
-    std::vector<CueTrack> tracks;
+    std::pmr::vector<CueTrack> tracks;
+
+    CueFile() = default;
+    explicit CueFile(const allocator_type& alloc) : filename(alloc), tracks(alloc) {}
+    CueFile(const CueFile& other, const allocator_type& alloc = {});
+    CueFile(CueFile&& other) noexcept = default;
+    CueFile(CueFile&& other, const allocator_type& alloc);
+    CueFile& operator=(const CueFile& other) = default;
+    CueFile& operator=(CueFile&& other) = default;
+
+    allocator_type get_allocator() const noexcept { return tracks.get_allocator(); }
 };
 
 struct CueSheet {
-    std::vector<CueFile> files;
-    std::optional<std::string> catalog;
-    std::optional<std::string> cdtextfile;
-    std::optional<std::string> title;
-    std::optional<std::string> performer;
-    std::optional<std::string> songwriter;
-    std::vector<std::string> remarks;
+    using allocator_type = CueAllocator;
+
+    std::pmr::vector<CueFile> files;
+    std::optional<std::pmr::string> catalog;
+    std::optional<std::pmr::string> cdtextfile;
+    std::optional<std::pmr::string> title;
+    std::optional<std::pmr::string> performer;
+    std::optional<std::pmr::string> songwriter;
+    std::pmr::vector<std::pmr::string> remarks;
+
+    CueSheet() = default;
+    explicit CueSheet(const allocator_type& alloc) : files(alloc), remarks(alloc) {}
+    CueSheet(const CueSheet& other, const allocator_type& alloc = {});
+    CueSheet(CueSheet&& other) noexcept = default;
+    CueSheet(CueSheet&& other, const allocator_type& alloc);
+    CueSheet& operator=(const CueSheet& other) = default;
+    CueSheet& operator=(CueSheet&& other) = default;
+
+    allocator_type get_allocator() const noexcept { return files.get_allocator(); }
 };
 
+// Sets an optional string field to `value`, allocating from `alloc`. Plain
+// assignment would allocate a disengaged field from the default resource.
+inline void assignString(std::optional<std::pmr::string>& field, std::string_view value,
+                         const CueAllocator& alloc)
+{
+    field.emplace(value, alloc);
+}
+
 } // namespace cuebin
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include "libcuebin/cueTypes.hpp"
+#include "libcuebin/error.hpp"
+
+namespace cuebin {
+
+// Serializes a CueSheet back to CUE text that CueParser reads back to an
+// equal sheet. Comments other than REM lines are not preserved.
+class CueWriter {
+public:
+    static std::string toString(const CueSheet& sheet);
+    static Status writeFile(const CueSheet& sheet, const std::filesystem::path& path);
+};
+
+} // namespace cuebin
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "libcuebin/error.hpp"
+#include "libcuebin/hash.hpp"
+
+namespace cuebin {
+
+struct DatRom {
+    std::string name;
+    uint64_t size = 0;
+    std::string crc32; // Lower-case hex, empty when absent
+    std::string md5;
+    std::string sha1;
+};
+
+struct DatGame {
+    std::string name;
+    std::vector<DatRom> roms;
+};
+
+struct DatMatch {
+    const DatGame* game = nullptr;
+    size_t matchedRoms = 0;  // ROMs of `game` found among the hashed files or tracks
+    size_t requiredRoms = 0; // ROMs of `game` a disc's data can match: all but its .cue sheets
+
+    // Every data ROM matched. Redump lists its own CUE sheet as a ROM, which
+    // hashDisc() does not hash, since a sheet rarely matches byte for byte.
+    bool complete() const noexcept { return game && requiredRoms > 0 && matchedRoms == requiredRoms; }
+};
+
+// In-memory index of a Logiqx XML DAT (the format used by Redump), keyed
+// by ROM SHA-1, with size + CRC32 as a fallback for entries without one.
+class DatIndex {
+public:
+    static Result<DatIndex> parse(std::string_view xml);
+    static Result<DatIndex> load(const std::filesystem::path& path);
+
+    const std::vector<DatGame>& games() const noexcept { return m_games; }
+
+    // ROMs with this digest, across all games
+    std::vector<const DatRom*> find(const HashDigest& digest) const;
+
+    // Games owning at least one of the hashed files or tracks, best match first
+    std::vector<DatMatch> match(const DiscHashes& hashes) const;
+
+private:
+    struct Entry {
+        uint32_t game;
+        uint32_t rom;
+    };
+
+    std::vector<DatGame> m_games;
+    std::unordered_multimap<std::string, Entry> m_bySha1;
+    std::unordered_multimap<std::string, Entry> m_bySizeCrc;
+
+    void buildIndex();
+    std::vector<Entry> lookup(const HashDigest& digest) const;
+};
+
+} // namespace cuebin
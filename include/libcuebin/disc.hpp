@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <span>
 #include <string>
@@ -11,15 +12,97 @@
 
 #include "libcuebin/cueTypes.hpp"
 #include "libcuebin/error.hpp"
+#include "libcuebin/ioStats.hpp"
 #include "libcuebin/msf.hpp"
 #include "libcuebin/sector.hpp"
+#include "libcuebin/subchannel.hpp"
 #include "libcuebin/track.hpp"
 
 namespace cuebin {
 
+enum class IoBackend {
+    Stream,     // std::ifstream per file, reads serialized by a per-file mutex
+    Mmap,       // Each file mapped once on first access, reads copy from the mapping
+    Positional, // Raw descriptor with positional reads (pread), no per-file lock
+};
+
+struct DiscOptions {
+    IoBackend ioBackend = IoBackend::Stream;
+    // Serve reads through the process-wide BlockCache. Ignored for IoBackend::Mmap.
+    // Off by default: every read is then a single backend read, and the
+    // Into() reads never allocate. A cache miss allocates a 64 KiB block.
+    bool useBlockCache = false;
+
+    // Prefetch ahead of sequential readers (CDDA, XA/STR streaming) on a
+    // background thread. The window adapts between the two bounds.
+    bool readAhead = false;
+    int32_t readAheadMinSectors = 16;
+    int32_t readAheadMaxSectors = 256;
+
+    // Return cooked data sectors (MODE1/2048, MODE2/2336, CDI/2336) as full
+    // 2352-byte raw sectors with sync, header, EDC and ECC synthesized from
+    // the LBA and user data. Off by default: user data then starts at byte 0
+    // and the rest of the sector is zero-filled.
+    bool rawSectors = false;
+
+    // Count reads, bytes, seeks, failures, lock waits and read latency per
+    // file (see Disc::ioStats()). Costs two clock reads per read call.
+    bool ioStats = true;
+
+    // Decompressed chunks kept per compressed (.cbc) file
+    size_t compressedCacheChunks = 8;
+
+    // Binary snapshot of the resolved disc layout (see Disc::saveSnapshot()).
+    // If set, fromCue() loads the disc from it when it is still current,
+    // skipping CUE parsing and file probing, and rewrites it otherwise.
+    std::filesystem::path snapshotPath;
+
+    // Resource for the disc's metadata: the parsed sheet, the track table
+    // and the subchannel layout. Must outlive the Disc. nullptr: the default
+    // resource.
+    std::pmr::memory_resource* memoryResource = nullptr;
+
+    // For callers that must not allocate once the disc is loaded. Every file
+    // is opened by fromCue(), the Stream backend is replaced by Positional,
+    // the block cache is bypassed, and failed reads return Errors without a
+    // message. Read-ahead and compressed (.cbc) images are rejected, and the
+    // reads that return vectors (readSectors(), readUserData(),
+    // readUserDataRange()) fail with Unsupported; every other read is then
+    // allocation-free.
+    bool realTime = false;
+};
+
+struct ReadAheadStats {
+    uint64_t hits = 0;              // Reads served from the prefetched window
+    uint64_t misses = 0;            // Sequential reads that outran the prefetcher
+    uint64_t prefetchedSectors = 0; // Sectors fetched by the background thread
+    int32_t windowSectors = 0;      // Current adaptive window size
+};
+
+struct VerifyOptions {
+    unsigned threadCount = 0;    // 0: one worker per hardware thread
+    int32_t chunkSectors = 1024; // Sectors per sequential read in each worker
+};
+
+struct SectorIssue {
+    int32_t lba = 0;
+    bool repairable = false; // P/Q correction restores a matching EDC
+};
+
+struct VerifyReport {
+    int32_t sectorsChecked = 0;
+    std::vector<SectorIssue> badSectors; // Sorted by LBA
+};
+
+struct DiscHashes;
+struct HashOptions;
+struct CompressOptions;
+struct CompressStats;
+
 class Disc {
 public:
-    static Result<Disc> fromCue(const std::filesystem::path& cuePath);
+    static Result<Disc> fromCue(const std::filesystem::path& cuePath,
+                                const DiscOptions& options = {});
 
     ~Disc();
     Disc(Disc&& other) noexcept;
@@ -34,10 +117,77 @@ public:
     uint8_t firstTrackNumber() const noexcept;
     uint8_t lastTrackNumber() const noexcept;
 
+    // Sectors are addressable from FIRST_LBA, the start of track 1's
+    // two-second pregap, up to the lead-out. Sectors that no file stores (that
+    // pregap, PREGAP and POSTGAP) are synthesized without I/O: silence on
+    // audio tracks, empty Mode 1 or Mode 2 Form 2 sectors on data tracks.
+    static constexpr int32_t FIRST_LBA = -MSF::PREGAP_FRAMES;
+
     int32_t totalSectors() const noexcept;
     Result<SectorData> readSector(int32_t lba) const;
     Result<SectorData> readSector(MSF address) const;
     Result<std::vector<SectorData>> readSectors(int32_t lba, int32_t count) const;
+
+    // Allocation-free reads into caller-provided storage. Each sector is written
+    // as RAW_SECTOR_SIZE bytes (zero-padded for cooked modes), so `out` must hold
+    // count * RAW_SECTOR_SIZE bytes. `modes`, if non-empty, receives one TrackMode
+    // per sector and must hold at least `count` entries. Allocation-free unless
+    // DiscOptions::useBlockCache is set.
+    Status readSectorInto(int32_t lba, std::span<uint8_t> out,
+                          TrackMode* mode = nullptr) const noexcept;
+    Status readSectorsInto(int32_t lba, int32_t count, std::span<uint8_t> out,
+                           std::span<TrackMode> modes = {}) const noexcept;
+
+    // User data only, packed back to back: 2048 bytes per Mode 1 or Mode 2
+    // Form 1 sector, 2324 per Form 2 sector, 2336 per Mode 2 sector without a
+    // valid XA subheader, 2352 per audio sector. The Mode 2 form is read from
+    // each sector's subheader. Bypasses read-ahead.
+    Result<std::vector<uint8_t>> readUserData(int32_t lba) const;
+    Result<std::vector<uint8_t>> readUserDataRange(int32_t lba, int32_t count) const;
+    // Allocation-free variant. `out` must hold every payload of the range
+    // (count * 2352 bytes always suffices); `written` receives the bytes used.
+    Status readUserDataInto(int32_t lba, int32_t count, std::span<uint8_t> out,
+                            size_t* written = nullptr) const noexcept;
+
+    // Checks the EDC of every sector in the MODE1/2352, MODE2/2352, CDI/2352
+    // and */2336 tracks on a pool of worker threads, trying P/Q correction on
+    // mismatches. Reads bypass the block cache and read-ahead; files are not
+    // modified. Fails only if a file cannot be read.
+    Result<VerifyReport> verify(const VerifyOptions& options = {}) const;
+
+    // Deinterleaved subchannel data of `lba` (see libcuebin/subchannel.hpp).
+    // It comes from a .sub file next to the CUE sheet or first BIN when one
+    // exists, from the sector itself on CDG tracks, and is synthesized
+    // otherwise: Q from the track and index layout, P set within pregaps,
+    // R..W zero. LBAs from -150 (the first pregap) through the lead-out are
+    // valid. Allocation-free.
+    Status readSubchannel(int32_t lba, SubchannelData out) const noexcept;
+    // Q channel only; cheap enough to call for every sector played
+    Status readSubchannelQ(int32_t lba, SubchannelQ out) const noexcept;
+    // Q as mastered from the CUE layout, ignoring any stored subchannel data
+    Status synthesizeSubchannelQ(int32_t lba, SubchannelQ out) const noexcept;
+    bool hasSubchannelFile() const noexcept;
+
+    // Writes a versioned binary snapshot of the parsed sheet, track table and
+    // file layout. It records the size and modification time of the CUE sheet
+    // and every file as they were when the disc was loaded; fromCue() ignores
+    // the snapshot once any of them changes.
+    Status saveSnapshot(const std::filesystem::path& path) const;
+
+    // Zeroed stats if read-ahead is disabled
+    ReadAheadStats readAheadStats() const noexcept;
+
+    // I/O counters per file and in total, since load or the last
+    // resetIoStats(). Zeroed if DiscOptions::ioStats is off.
+    DiscIoStats ioStats() const;
+    void resetIoStats() noexcept;
+
+    // Direct view of the sector bytes as stored in the file (sectorSize() bytes,
+    // no padding). Requires IoBackend::Mmap; valid for the lifetime of the Disc.
+    // Unsupported for AIFF audio, whose samples are byte-swapped on read, and
+    // for gap sectors, which no file stores.
+    Result<std::span<const uint8_t>> sectorView(int32_t lba) const;
+    // Track whose file stores `lba`, or nullptr within a gap; a table lookup
     const Track* findTrack(int32_t lba) const noexcept;
     int32_t leadOutLba() const noexcept;
 
@@ -47,10 +197,20 @@ public:
     const CueSheet& cueSheet() const noexcept;
 
 private:
+    friend class AsyncReader;
+    friend Result<DiscHashes> hashDisc(const Disc& disc, const HashOptions& options);
+    friend Result<CompressStats> compressDisc(const Disc& disc, const std::filesystem::path& cuePath,
+                                              const CompressOptions& options);
+
     struct Impl;
-    std::unique_ptr<Impl> m_impl;
+    // Returns the Impl to the memory resource it was allocated from
+    struct ImplDeleter {
+        void operator()(Impl* impl) const noexcept;
+    };
+    using ImplPtr = std::unique_ptr<Impl, ImplDeleter>;
+    ImplPtr m_impl;
 
-    explicit Disc(std::unique_ptr<Impl> impl);
+    explicit Disc(ImplPtr impl);
 };
 
 } // namespace cuebin
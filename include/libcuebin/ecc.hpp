@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "libcuebin/cueTypes.hpp"
+#include "libcuebin/sector.hpp"
+
+namespace cuebin {
+
+// CD-ROM sector layout and error detection/correction codes (ECMA-130).
+// Offsets are into a raw 2352-byte sector.
+static constexpr size_t SYNC_SIZE = 12;
+static constexpr size_t HEADER_OFFSET = 12;
+static constexpr size_t SUBHEADER_OFFSET = 16;  // Mode 2 only, 8 bytes
+static constexpr size_t MODE1_EDC_OFFSET = 2064;
+static constexpr size_t MODE2_FORM1_EDC_OFFSET = 2072;
+static constexpr size_t MODE2_FORM2_EDC_OFFSET = 2348;
+static constexpr size_t ECC_P_OFFSET = 2076;    // 172 bytes
+static constexpr size_t ECC_Q_OFFSET = 2248;    // 104 bytes
+
+// Submode bit in the Mode 2 subheader selecting Form 2
+static constexpr uint8_t SUBMODE_FORM2 = 0x20;
+
+using RawSector = std::span<uint8_t, RAW_SECTOR_SIZE>;
+
+// EDC (CRC-32, polynomial 0x8001801B, reflected) over `data`, continuing from `edc`.
+uint32_t computeEdc(std::span<const uint8_t> data, uint32_t edc = 0) noexcept;
+
+// Writes the P and Q Reed-Solomon parity over bytes 12..2075 of `sector`
+// exactly as laid out; Mode 2 callers zero the header first.
+void computeEcc(RawSector sector) noexcept;
+
+// Corrects up to one byte per P column and Q diagonal in place. Returns
+// false if some codeword held an error it could not locate.
+bool correctEcc(RawSector sector) noexcept;
+
+enum class SectorCheck {
+    Ok,            // EDC matches (or the sector has none)
+    Repairable,    // EDC mismatch fixed by P/Q correction
+    Unrecoverable, // EDC mismatch that correction could not fix
+};
+
+// Checks the EDC of a raw sector read from a track of `mode`, using the
+// Form bit of the subheader for Mode 2 / CD-i. On a mismatch, tries P/Q
+// correction in place; `sector` then holds the repaired bytes.
+SectorCheck checkSector(TrackMode mode, RawSector sector) noexcept;
+
+// Writes the sync pattern and the BCD MSF address/mode header for `lba`.
+void writeSectorHeader(int32_t lba, uint8_t mode, RawSector sector) noexcept;
+
+// Turn a sector whose user data is already in place (from byte 16 for
+// Mode 1, from the subheader at byte 16 for Mode 2) into a complete raw
+// sector: sync, header, EDC and, for Mode 1 / Form 1, ECC.
+void encodeMode1Sector(int32_t lba, RawSector sector) noexcept;
+void encodeMode2Form1Sector(int32_t lba, RawSector sector) noexcept;
+void encodeMode2Form2Sector(int32_t lba, RawSector sector) noexcept;
+
+} // namespace cuebin
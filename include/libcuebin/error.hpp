@@ -15,6 +15,7 @@ enum class ErrorCode {
     MissingTrack,
     DuplicateIndex,
     UnexpectedDirective,
+    InvalidDatFormat,
 
     // I/O errors
     FileNotFound,
@@ -25,6 +26,11 @@ enum class ErrorCode {
     LBAOutOfRange,
     TrackNotFound,
     InvalidArgument,
+    Unsupported,
+
+    // Filesystem errors
+    InvalidFileSystem,
+    PathNotFound,
 };
 
 struct Error {
@@ -43,6 +49,24 @@ struct Error {
     {}
 };
 
+// Allocation-free outcome of a noexcept operation. Unlike Error it carries
+// no message, so hot paths can report failures without touching the heap.
+class Status {
+public:
+    constexpr Status() noexcept = default;
+    constexpr Status(ErrorCode code) noexcept : m_code(code), m_ok(false) {}
+
+    constexpr bool ok() const noexcept { return m_ok; }
+    constexpr explicit operator bool() const noexcept { return ok(); }
+
+    // Only meaningful when !ok()
+    constexpr ErrorCode code() const noexcept { return m_code; }
+
+private:
+    ErrorCode m_code{};
+    bool m_ok = true;
+};
+
 template <typename T>
 class Result {
 public:
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "libcuebin/disc.hpp"
+#include "libcuebin/error.hpp"
+
+namespace cuebin {
+
+// CRC-32 (zlib/PKZIP polynomial) of `data`, continuing from a previous
+// result. Uses carry-less multiply (PCLMULQDQ) when the CPU supports it.
+uint32_t crc32(std::span<const uint8_t> data, uint32_t crc = 0) noexcept;
+
+class Md5 {
+public:
+    Md5() noexcept;
+    void update(std::span<const uint8_t> data) noexcept;
+    std::array<uint8_t, 16> finish() noexcept;
+
+private:
+    void block(const uint8_t* p) noexcept;
+
+    std::array<uint32_t, 4> m_state;
+    std::array<uint8_t, 64> m_buffer{};
+    uint64_t m_length = 0;
+};
+
+class Sha1 {
+public:
+    Sha1() noexcept;
+    void update(std::span<const uint8_t> data) noexcept;
+    std::array<uint8_t, 20> finish() noexcept;
+
+private:
+    void block(const uint8_t* p) noexcept;
+
+    std::array<uint32_t, 5> m_state;
+    std::array<uint8_t, 64> m_buffer{};
+    uint64_t m_length = 0;
+};
+
+struct HashDigest {
+    uint64_t size = 0;
+    uint32_t crc32 = 0;
+    std::array<uint8_t, 16> md5{};
+    std::array<uint8_t, 20> sha1{};
+
+    // Lower-case hex, as written in DAT files
+    std::string crc32Hex() const;
+    std::string md5Hex() const;
+    std::string sha1Hex() const;
+
+    bool operator==(const HashDigest&) const = default;
+};
+
+struct FileHash {
+    std::filesystem::path path;
+    HashDigest digest;
+};
+
+struct TrackHash {
+    uint8_t trackNumber = 0;
+    HashDigest digest; // Bytes of the track in its BIN file, pregap included
+};
+
+struct DiscHashes {
+    std::vector<FileHash> files;
+    std::vector<TrackHash> tracks;
+};
+
+struct HashOptions {
+    size_t chunkBytes = 4 * 1024 * 1024; // Sequential read size
+};
+
+// Hashes every BIN file of `disc` and every track within them in a single
+// sequential read pass per file. CRC32, MD5 and SHA-1 each run on their own
+// worker thread while the next chunk is being read.
+Result<DiscHashes> hashDisc(const Disc& disc, const HashOptions& options = {});
+
+} // namespace cuebin
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace cuebin {
+
+// Read latencies in power-of-two buckets: bucket 0 counts reads under 1 ns,
+// bucket i reads of [2^(i-1), 2^i) ns, and the last bucket everything from
+// 2^(BUCKET_COUNT-2) ns (about 1.1 s) up.
+struct LatencyHistogram {
+    static constexpr size_t BUCKET_COUNT = 32;
+
+    std::array<uint64_t, BUCKET_COUNT> buckets{};
+
+    // Exclusive upper bound of bucket `i` in nanoseconds; UINT64_MAX for the last
+    static constexpr uint64_t bucketUpperBoundNs(size_t i) noexcept
+    {
+        return i + 1 < BUCKET_COUNT ? uint64_t{1} << i : UINT64_MAX;
+    }
+
+    uint64_t count() const noexcept;
+    // Upper bound of the bucket holding quantile `q` (0..1) of the reads,
+    // 0 if there are none
+    uint64_t quantileNs(double q) const noexcept;
+};
+
+struct IoCounters {
+    uint64_t sectorsRead = 0;
+    uint64_t bytesRead = 0;
+    uint64_t readCalls = 0;
+    uint64_t seeks = 0;        // Reads not starting where the file's previous read ended
+    uint64_t failedReads = 0;  // Reads the backend could not serve at all
+    uint64_t lazyOpens = 0;    // Files opened on first access
+    uint64_t mutexWaitNs = 0;  // Time blocked on the Stream backend's per-file lock
+    LatencyHistogram latency;  // Of each read call, block cache lookups included
+
+    IoCounters& operator+=(const IoCounters& other) noexcept;
+};
+
+struct FileIoStats {
+    std::filesystem::path path;
+    IoCounters counters;
+};
+
+// Reads made through a Disc's read APIs and its read-ahead thread.
+// AsyncReader, verify() and hashDisc() use their own descriptors and are
+// not counted.
+struct DiscIoStats {
+    IoCounters total;               // Sum over all files
+    std::vector<FileIoStats> files; // One per FILE entry, in sheet order
+};
+
+} // namespace cuebin
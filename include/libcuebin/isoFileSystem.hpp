@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libcuebin/disc.hpp"
+#include "libcuebin/error.hpp"
+
+namespace cuebin {
+
+struct IsoFileInfo {
+    std::string name;      // Without the ";1" version suffix
+    uint32_t extentLba = 0;
+    uint32_t size = 0;     // Bytes
+    bool isDirectory = false;
+};
+
+// A regular file on an IsoFileSystem. Valid for the lifetime of its Disc.
+class IsoFile {
+public:
+    const IsoFileInfo& info() const noexcept { return m_info; }
+    uint32_t size() const noexcept { return m_info.size; }
+
+    // Reads up to out.size() bytes starting at `offset` and returns the number
+    // read (0 at end of file). Whole sectors are read straight into `out` in
+    // a single multi-sector read.
+    Result<size_t> read(uint64_t offset, std::span<uint8_t> out) const;
+    Result<std::vector<uint8_t>> readAll() const;
+
+private:
+    friend class IsoFileSystem;
+
+    IsoFile(const Disc& disc, IsoFileInfo info) : m_disc(&disc), m_info(std::move(info)) {}
+
+    const Disc* m_disc;
+    IsoFileInfo m_info;
+};
+
+// Read-only ISO9660 view of a data track. The primary volume descriptor and
+// path table are parsed on mount; directory contents are loaded the first
+// time a path inside them is looked up, then served from a hashed index.
+//
+// Paths are case-insensitive, accept '/' or '\' separators, and may carry a
+// device prefix and version suffix ("cdrom:\SYSTEM.CNF;1"). The Disc must
+// outlive the IsoFileSystem. Lookups are thread-safe.
+class IsoFileSystem {
+public:
+    // Mounts the volume on track `trackNumber`, or the first data track if 0.
+    static Result<IsoFileSystem> mount(const Disc& disc, uint8_t trackNumber = 0);
+
+    ~IsoFileSystem();
+    IsoFileSystem(IsoFileSystem&& other) noexcept;
+    IsoFileSystem& operator=(IsoFileSystem&& other) noexcept;
+
+    IsoFileSystem(const IsoFileSystem&) = delete;
+    IsoFileSystem& operator=(const IsoFileSystem&) = delete;
+
+    std::string_view volumeId() const noexcept;
+    uint32_t volumeSectors() const noexcept;
+
+    Result<IsoFileInfo> stat(std::string_view path) const;
+    Result<IsoFile> open(std::string_view path) const;
+    Result<std::vector<IsoFileInfo>> listDirectory(std::string_view path) const;
+
+    // Number of directories whose records have been read so far
+    size_t loadedDirectoryCount() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+
+    explicit IsoFileSystem(std::unique_ptr<Impl> impl);
+};
+
+} // namespace cuebin
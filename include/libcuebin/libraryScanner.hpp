@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "libcuebin/cueTypes.hpp"
+#include "libcuebin/error.hpp"
+
+namespace cuebin {
+
+struct ScanOptions {
+    unsigned threadCount = 0;   // 0: one worker per hardware thread
+    // Files and directories held open at once across all workers. Every
+    // CUE read, BIN stat and container probe takes a slot, which keeps
+    // large scans on network filesystems within the descriptor limit.
+    unsigned maxOpenFiles = 64;
+    bool recursive = true;      // Descend into subdirectories
+    bool followSymlinks = false;
+};
+
+struct CatalogTrack {
+    uint8_t number = 0;
+    TrackMode mode = TrackMode::Audio;
+    int32_t startLba = 0;
+    int32_t lengthSectors = 0;
+};
+
+struct CatalogEntry {
+    std::filesystem::path cuePath;
+    std::optional<std::string> title;
+    int32_t totalSectors = 0;
+    uint32_t firstTrack = 0;  // Index into DiscCatalog::tracks
+    uint8_t trackCount = 0;
+    uint8_t fileCount = 0;
+    std::optional<Error> error; // Set if the sheet failed to parse or validate
+
+    bool ok() const noexcept { return !error.has_value(); }
+};
+
+// Result of a library scan. Tracks of all discs share one array; each
+// entry refers to its slice. Entries are sorted by CUE path.
+struct DiscCatalog {
+    std::vector<CatalogEntry> discs;
+    std::vector<CatalogTrack> tracks;
+    size_t failedCount = 0;
+
+    std::span<const CatalogTrack> tracksOf(const CatalogEntry& entry) const noexcept
+    {
+        return std::span<const CatalogTrack>(tracks).subspan(entry.firstTrack, entry.trackCount);
+    }
+};
+
+// Finds every .cue file under `root` and parses and validates it on a
+// work-stealing pool: directories and sheets are tasks, and idle workers
+// steal from busy ones. Validation is what Disc::fromCue() checks at load
+// (sheet syntax, BIN presence and size, WAVE/AIFF and .cbc headers)
+// without opening the disc. Fails only if `root` is not a directory.
+Result<DiscCatalog> scanLibrary(const std::filesystem::path& root, const ScanOptions& options = {});
+
+// Same, for an explicit list of CUE sheets
+DiscCatalog scanCueSheets(std::span<const std::filesystem::path> cuePaths,
+                          const ScanOptions& options = {});
+
+} // namespace cuebin
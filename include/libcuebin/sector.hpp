@@ -9,6 +9,11 @@ namespace cuebin {
 
 static constexpr size_t RAW_SECTOR_SIZE = 2352;
 
+// User-data payload sizes returned by Disc::readUserData()
+static constexpr size_t MODE1_USER_DATA_SIZE = 2048;      // Mode 1 and Mode 2 Form 1
+static constexpr size_t MODE2_FORM2_USER_DATA_SIZE = 2324;
+static constexpr size_t MODE2_USER_DATA_SIZE = 2336;      // Mode 2 without XA subheader
+
 struct SectorData {
     std::array<uint8_t, RAW_SECTOR_SIZE> data{};
     TrackMode mode = TrackMode::Audio;
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace cuebin {
+
+// Every sector carries 96 bytes of subchannel data split over eight
+// channels P..W. A drive returns them interleaved: each byte holds one bit
+// of every channel (P in bit 7, W in bit 0). Subchannel sidecar files
+// (.sub) store them deinterleaved: 12 bytes of P, then 12 of Q, and so on.
+static constexpr size_t SUBCHANNEL_SIZE = 96;
+static constexpr size_t SUBCHANNEL_CHANNEL_SIZE = 12;
+static constexpr size_t SUBCHANNEL_Q_OFFSET = 12; // Q within the deinterleaved layout
+
+using SubchannelData = std::span<uint8_t, SUBCHANNEL_SIZE>;
+using SubchannelQ = std::span<uint8_t, SUBCHANNEL_CHANNEL_SIZE>;
+
+// Converts between the interleaved and deinterleaved layouts (SSE2 on x86)
+void deinterleaveSubchannel(std::span<const uint8_t, SUBCHANNEL_SIZE> interleaved,
+                            SubchannelData out) noexcept;
+void interleaveSubchannel(std::span<const uint8_t, SUBCHANNEL_SIZE> deinterleaved,
+                          SubchannelData out) noexcept;
+
+// Mode 1 Q channel (ADR 1, current position), all fields BCD:
+//   0 CONTROL << 4 | ADR, 1 track (AA in the lead-out), 2 index,
+//   3-5 MSF relative to INDEX 01 (counting down within the pregap),
+//   6 zero, 7-9 absolute MSF, 10-11 CRC-16 big-endian
+static constexpr uint8_t Q_CONTROL_PREEMPHASIS = 0x1;
+static constexpr uint8_t Q_CONTROL_COPY_PERMITTED = 0x2;
+static constexpr uint8_t Q_CONTROL_DATA = 0x4;
+static constexpr uint8_t Q_CONTROL_FOUR_CHANNEL = 0x8;
+static constexpr uint8_t Q_TRACK_LEAD_OUT = 0xAA;
+
+// CRC-16/CCITT (polynomial 0x1021) over Q bytes 0..9, inverted as recorded
+uint16_t subchannelQCrc(std::span<const uint8_t, 10> q) noexcept;
+// True if bytes 10-11 hold the CRC of bytes 0..9. LibCrypt-protected discs
+// have deliberately broken CRCs on a few sectors.
+bool checkSubchannelQ(std::span<const uint8_t, SUBCHANNEL_CHANNEL_SIZE> q) noexcept;
+
+constexpr uint8_t toBcd(uint8_t value) noexcept
+{
+    return static_cast<uint8_t>((value / 10) << 4 | value % 10);
+}
+
+constexpr uint8_t fromBcd(uint8_t bcd) noexcept
+{
+    return static_cast<uint8_t>((bcd >> 4) * 10 + (bcd & 0x0F));
+}
+
+} // namespace cuebin
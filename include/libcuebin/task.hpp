@@ -0,0 +1,249 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace cuebin {
+
+// Decides where a coroutine resumes once the operation it awaited completes.
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual void post(std::coroutine_handle<> handle) = 0;
+};
+
+// Resumes immediately on whichever thread completed the operation.
+class InlineExecutor final : public Executor {
+public:
+    void post(std::coroutine_handle<> handle) override { handle.resume(); }
+};
+
+inline Executor& inlineExecutor()
+{
+    static InlineExecutor executor;
+    return executor;
+}
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+// Resumes the awaiting coroutine, if any, when a Task finishes.
+struct TaskFinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+    {
+        auto continuation = h.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    TaskFinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+};
+
+} // namespace detail
+
+// Lazily started coroutine producing a T. The body runs when the Task is
+// first co_awaited; the awaiting coroutine resumes when it finishes.
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    struct promise_type : detail::TaskPromiseBase {
+        std::optional<T> value;
+
+        Task get_return_object() noexcept
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        template <typename U>
+        void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+    };
+
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            if (m_handle) m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+    ~Task() { if (m_handle) m_handle.destroy(); }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_handle.promise().continuation = awaiting;
+        return m_handle;
+    }
+
+    T await_resume()
+    {
+        auto& promise = m_handle.promise();
+        if (promise.exception) std::rethrow_exception(promise.exception);
+        return std::move(*promise.value);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+template <>
+class [[nodiscard]] Task<void> {
+public:
+    struct promise_type : detail::TaskPromiseBase {
+        Task get_return_object() noexcept
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        void return_void() noexcept {}
+    };
+
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            if (m_handle) m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+    ~Task() { if (m_handle) m_handle.destroy(); }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_handle.promise().continuation = awaiting;
+        return m_handle;
+    }
+
+    void await_resume()
+    {
+        if (m_handle.promise().exception) std::rethrow_exception(m_handle.promise().exception);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+namespace detail {
+
+struct SyncWaitLatch {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+
+    void signal()
+    {
+        // Notify under the lock: the waiter owns this latch and may destroy
+        // it as soon as it observes `done`
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cv.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return done; });
+    }
+};
+
+struct SyncWaitTask {
+    struct promise_type {
+        SyncWaitLatch* latch = nullptr;
+
+        SyncWaitTask get_return_object() noexcept
+        {
+            return SyncWaitTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        auto final_suspend() const noexcept
+        {
+            struct Signal {
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+                {
+                    h.promise().latch->signal();
+                }
+                void await_resume() const noexcept {}
+            };
+            return Signal{};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    ~SyncWaitTask() { if (handle) handle.destroy(); }
+};
+
+template <typename T>
+SyncWaitTask runSyncWait(Task<T>& task, std::optional<T>& result)
+{
+    result.emplace(co_await task);
+}
+
+inline SyncWaitTask runSyncWait(Task<void>& task)
+{
+    co_await task;
+}
+
+} // namespace detail
+
+// Runs `task` to completion from non-coroutine code, blocking the calling
+// thread until it finishes (possibly on another thread).
+template <typename T>
+T syncWait(Task<T> task)
+{
+    detail::SyncWaitLatch latch;
+    if constexpr (std::is_void_v<T>) {
+        auto waiter = detail::runSyncWait(task);
+        waiter.handle.promise().latch = &latch;
+        waiter.handle.resume();
+        latch.wait();
+    } else {
+        std::optional<T> result;
+        auto waiter = detail::runSyncWait(task, result);
+        waiter.handle.promise().latch = &latch;
+        waiter.handle.resume();
+        latch.wait();
+        return std::move(*result);
+    }
+}
+
+} // namespace cuebin
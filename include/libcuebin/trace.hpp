@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "libcuebin/error.hpp"
+
+namespace cuebin {
+
+// True when libcuebin was built with LIBCUEBIN_TRACING. Otherwise the trace
+// points compile to nothing and an installed observer is never called.
+#ifdef LIBCUEBIN_TRACING
+inline constexpr bool TRACING_ENABLED = true;
+#else
+inline constexpr bool TRACING_ENABLED = false;
+#endif
+
+// Receives the library's trace points. Called synchronously on whichever
+// thread hits the point, often a sector read path, so overrides must be
+// thread-safe, noexcept and cheap. `fileIndex` is the FILE entry's position
+// in its CUE sheet; offsets are byte offsets into that file.
+class TraceObserver {
+public:
+    virtual ~TraceObserver() = default;
+
+    // A disc's file was opened for reading (lazily, on first access)
+    virtual void fileOpen(const std::filesystem::path&, size_t /*fileIndex*/, bool /*ok*/) noexcept {}
+
+    // One backend read of `size` bytes for the sectors starting at `lba`
+    virtual void readBegin(int32_t /*lba*/, int32_t /*sectors*/, size_t /*fileIndex*/,
+                           int64_t /*offset*/, int64_t /*size*/) noexcept {}
+    // `got` is the number of bytes read, or -1 if the offset was unreachable
+    virtual void readEnd(int32_t /*lba*/, int32_t /*sectors*/, size_t /*fileIndex*/,
+                         int64_t /*offset*/, int64_t /*got*/) noexcept {}
+
+    // Block cache lookups, by aligned BlockCache::BLOCK_SIZE block
+    virtual void cacheHit(size_t /*fileIndex*/, int64_t /*blockIndex*/) noexcept {}
+    virtual void cacheMiss(size_t /*fileIndex*/, int64_t /*blockIndex*/) noexcept {}
+
+    // A Disc read API or AsyncReader request failed for the range starting at `lba`
+    virtual void readError(int32_t /*lba*/, int32_t /*sectors*/, ErrorCode) noexcept {}
+
+    // CueParser::parseFile()
+    virtual void parseBegin(const std::filesystem::path&) noexcept {}
+    virtual void parseEnd(const std::filesystem::path&, Status, size_t /*trackCount*/) noexcept {}
+};
+
+// Installs the process-wide observer, or removes it with nullptr. The
+// observer must outlive every call into the library that may reach it.
+void setTraceObserver(TraceObserver* observer) noexcept;
+TraceObserver* traceObserver() noexcept;
+
+} // namespace cuebin
@@ -1,25 +1,28 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
-#include <string>
+#include <span>
 #include <string_view>
-#include <vector>
 
 #include "libcuebin/cueTypes.hpp"
 #include "libcuebin/msf.hpp"
 
 namespace cuebin {
 
+// A disc holds at most 99 tracks (Red Book)
+static constexpr size_t MAX_TRACKS = 99;
+
+// Position of one track on the disc. Indices, title, performer and ISRC are
+// read from the CueTrack the track was laid out from, so a Track is only
+// valid for the lifetime of the Disc (or sheet) it came from.
 class Track {
 public:
     Track(uint8_t number, TrackMode mode, uint16_t sectorSize,
           int32_t startLba, int32_t lengthSectors,
           int32_t pregapSectors, int32_t postgapSectors,
-          std::vector<CueIndex> indices,
-          std::optional<std::string> title,
-          std::optional<std::string> performer,
-          std::optional<std::string> isrc,
+          const CueTrack* source,
           size_t fileIndex, int64_t fileByteOffset,
           int32_t fileStartLba);
 
@@ -34,7 +37,7 @@ public:
     int32_t pregapSectors() const noexcept { return m_pregapSectors; }
     int32_t postgapSectors() const noexcept { return m_postgapSectors; }
 
-    const std::vector<CueIndex>& indices() const noexcept { return m_indices; }
+    std::span<const CueIndex> indices() const noexcept { return m_source->indices; }
 
     bool isAudio() const noexcept { return m_mode == TrackMode::Audio; }
     bool isData() const noexcept { return !isAudio(); }
@@ -56,10 +59,7 @@ private:
     int32_t m_lengthSectors;
     int32_t m_pregapSectors;
     int32_t m_postgapSectors;
-    std::vector<CueIndex> m_indices;
-    std::optional<std::string> m_title;
-    std::optional<std::string> m_performer;
-    std::optional<std::string> m_isrc;
+    const CueTrack* m_source;
     size_t m_fileIndex;
     int64_t m_fileByteOffset;
     int32_t m_fileStartLba;
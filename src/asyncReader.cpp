@@ -0,0 +1,519 @@
+#include "libcuebin/asyncReader.hpp"
+
+#include "discImpl.hpp"
+#include "ioUring.hpp"
+#include "traceInternal.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+#include <sys/uio.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace cuebin {
+
+namespace {
+
+struct Request;
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+// One io_uring read belonging to a request
+struct SegmentOp {
+    Request* request = nullptr;
+    ReadSegment seg;
+    const RawFile* file = nullptr;
+    iovec iov{};
+    std::chrono::steady_clock::time_point submitted; // For the file's latency histogram
+};
+#endif
+
+struct Request {
+    AsyncCompletion completion;
+    AsyncCallback callback;
+    uint8_t* out = nullptr;
+    TrackMode* modes = nullptr;
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+    std::vector<SegmentOp> ops;
+    std::atomic<size_t> pending{0};
+    std::atomic<int> error{-1}; // First failing ErrorCode, or -1
+#endif
+};
+
+// user_data of the NOP that tells the reaper thread to exit
+constexpr uint64_t STOP_TOKEN = 0;
+
+// Submits a read when awaited and resumes the coroutine on `executor` once
+// it completes. If the submission itself is rejected the coroutine does not
+// suspend and `submitError` is set.
+struct ReadAwaiter {
+    AsyncReader& reader;
+    const Disc& disc;
+    int32_t lba;
+    int32_t count;
+    std::span<uint8_t> out;
+    std::span<TrackMode> modes;
+    Executor& executor;
+
+    Status status{};
+    std::optional<Error> submitError{};
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        auto id = reader.submit(disc, lba, count, out, modes,
+            [this, handle](const AsyncCompletion& c) {
+                status = c.status;
+                executor.post(handle);
+            });
+        // On success the callback may already have resumed the coroutine on
+        // another thread; this awaiter must not be touched past this point.
+        if (id) return true;
+        submitError = std::move(id.error());
+        return false;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+Error asyncReadError(ErrorCode code, int32_t lba, int32_t count)
+{
+    return LIBCUEBIN_ERROR(code, "Async read failed for LBA range [" + std::to_string(lba)
+        + ", " + std::to_string(int64_t{lba} + count) + ")");
+}
+
+} // anonymous namespace
+
+struct AsyncReader::Impl {
+    AsyncBackend backend = AsyncBackend::ThreadPool;
+    std::atomic<uint64_t> nextId{1};
+    std::atomic<size_t> inFlight{0};
+
+    std::mutex completionMutex;
+    std::condition_variable completionReady;
+    std::deque<AsyncCompletion> completions;
+
+    // Thread-pool backend
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<std::unique_ptr<Request>> queue;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+    IoUring ring;
+    std::mutex submitMutex;
+    std::thread reaper;
+#endif
+
+    ~Impl();
+
+    void finish(std::unique_ptr<Request> request);
+    void workerLoop();
+    void startIoUring(std::unique_ptr<Request> request);
+    // Completes an io_uring request once its last op is accounted for
+    void finishOps(Request* request);
+    void reaperLoop();
+};
+
+AsyncReader::Impl::~Impl()
+{
+    // Outstanding requests reference caller buffers: let them land first
+    {
+        std::unique_lock<std::mutex> lock(completionMutex);
+        completionReady.wait(lock, [this]() { return inFlight.load() == 0; });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    for (auto& w : workers) w.join();
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+    if (reaper.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(submitMutex);
+            while (!ring.prepareNop(STOP_TOKEN)) ring.submit();
+            ring.submit();
+        }
+        reaper.join();
+    }
+#endif
+}
+
+void AsyncReader::Impl::finish(std::unique_ptr<Request> request)
+{
+    if (request->callback) {
+        request->callback(request->completion);
+        std::lock_guard<std::mutex> lock(completionMutex);
+        inFlight.fetch_sub(1);
+    } else {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        completions.push_back(request->completion);
+        inFlight.fetch_sub(1);
+    }
+    completionReady.notify_all();
+}
+
+void AsyncReader::Impl::workerLoop()
+{
+    while (true) {
+        std::unique_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            request = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        const auto& c = request->completion;
+        std::span<uint8_t> out(request->out, static_cast<size_t>(c.count) * RAW_SECTOR_SIZE);
+        std::span<TrackMode> modes;
+        if (request->modes) modes = std::span<TrackMode>(request->modes, c.count);
+        request->completion.status = c.disc->readSectorsInto(c.lba, c.count, out, modes);
+
+        finish(std::move(request));
+    }
+}
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+
+void AsyncReader::Impl::startIoUring(std::unique_ptr<Request> request)
+{
+    const auto& c = request->completion;
+    const auto& discImpl = *c.disc->m_impl;
+
+    // Open the range's files and size `ops` for its worst case up front, so
+    // that planning inside the noexcept forEachSegment() does neither
+    std::vector<const RawFile*> files(discImpl.fileHandles.size(), nullptr);
+    size_t maxOps = 0;
+    bool compressed = false;
+    int64_t endLba = static_cast<int64_t>(c.lba) + c.count;
+    for (int32_t current = c.lba; current < endLba;) {
+        const LbaExtent* extent = discImpl.findExtent(current);
+        if (!extent) break; // Reported by forEachSegment()
+        auto runEnd = static_cast<int32_t>(std::min<int64_t>(endLba, extent->end));
+        if (!extent->isVirtual()) {
+            const Track& trk = *extent->track;
+            const FileHandle& file = *discImpl.fileHandles[trk.fileIndex()];
+            if (file.compressed) {
+                compressed = true;
+                break;
+            }
+            if (!files[file.index]) files[file.index] = file.asyncFile();
+            // One read per run, or per sector when each carries subchannel data
+            maxOps += trk.sectorSize() > RAW_SECTOR_SIZE ? static_cast<size_t>(runEnd - current) : 1;
+        }
+        current = runEnd;
+    }
+
+    if (compressed) {
+        // Compressed images have no file bytes to hand to the kernel: decode in place
+        std::span<uint8_t> out(request->out, static_cast<size_t>(c.count) * RAW_SECTOR_SIZE);
+        std::span<TrackMode> modes;
+        if (request->modes) modes = std::span<TrackMode>(request->modes, c.count);
+        request->completion.status = c.disc->readSectorsInto(c.lba, c.count, out, modes);
+        finish(std::move(request));
+        return;
+    }
+
+    // Reuse the synchronous LBA-to-file translation to plan the reads
+    Request* raw = request.get();
+    raw->ops.reserve(maxOps);
+    Status planned = discImpl.forEachSegment(c.lba, c.count, request->out, request->modes,
+        [raw, &files](const ReadSegment& seg) noexcept -> Status {
+            const RawFile* file = files[seg.file->index];
+            if (!file) return ErrorCode::FileReadError;
+            SegmentOp op;
+            op.request = raw;
+            op.seg = seg;
+            op.file = file;
+            raw->ops.push_back(op); // Within the reserved capacity
+            return {};
+        });
+
+    if (!planned || raw->ops.empty()) {
+        // Failed, or made only of gap sectors, which planning synthesized
+        if (!planned) LIBCUEBIN_TRACE(readError, c.lba, c.count, planned.code());
+        request->completion.status = planned;
+        finish(std::move(request));
+        return;
+    }
+
+    raw->pending.store(raw->ops.size());
+    request.release(); // Owned by the in-flight ops until the last one completes
+
+    size_t unsent = 0;
+    {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        size_t prepared = 0;
+        bool ok = true;
+        bool flushed = false;
+        while (ok && prepared < raw->ops.size()) {
+            SegmentOp& op = raw->ops[prepared];
+            op.iov.iov_base = op.seg.dst;
+            op.iov.iov_len = static_cast<size_t>(op.seg.bytes);
+            op.submitted = std::chrono::steady_clock::now();
+            if (ring.prepareReadv(op.file->fd(), &op.iov, op.seg.offset, reinterpret_cast<uint64_t>(&op))) {
+                LIBCUEBIN_TRACE(readBegin, op.seg.lba, op.seg.sectors, op.seg.file->index, op.seg.offset,
+                                op.seg.bytes);
+                ++prepared;
+                flushed = false;
+            } else {
+                // Submission queue full: flush it to the kernel and retry once
+                ok = !flushed && ring.submit();
+                flushed = true;
+            }
+        }
+        if (ok) ok = ring.submit();
+        if (!ok) {
+            // Ops the kernel never took will not complete: account for them here
+            size_t dropped = ring.discardUnsubmitted();
+            for (size_t i = prepared - dropped; i < prepared; ++i) {
+                LIBCUEBIN_TRACE(readEnd, raw->ops[i].seg.lba, raw->ops[i].seg.sectors, raw->ops[i].seg.file->index,
+                                raw->ops[i].seg.offset, int64_t{-1});
+            }
+            unsent = dropped + (raw->ops.size() - prepared);
+            spdlog::error("io_uring submission failed, {} of {} reads dropped", unsent, raw->ops.size());
+        }
+    }
+
+    // After the lock: finishing runs the callback, which may submit again
+    if (unsent > 0) {
+        int expected = -1;
+        raw->error.compare_exchange_strong(expected, static_cast<int>(ErrorCode::FileReadError));
+        if (raw->pending.fetch_sub(unsent) == unsent) finishOps(raw);
+    }
+}
+
+void AsyncReader::Impl::finishOps(Request* request)
+{
+    int error = request->error.load();
+    if (error >= 0) {
+        request->completion.status = static_cast<ErrorCode>(error);
+        LIBCUEBIN_TRACE(readError, request->completion.lba, request->completion.count,
+                        static_cast<ErrorCode>(error));
+    }
+    finish(std::unique_ptr<Request>(request));
+}
+
+void AsyncReader::Impl::reaperLoop()
+{
+    IoUring::Completion batch[64];
+    bool stop = false;
+    while (!stop) {
+        size_t n = ring.reap(batch, std::size(batch), true);
+        for (size_t i = 0; i < n; ++i) {
+            if (batch[i].userData == STOP_TOKEN) {
+                stop = true;
+                continue;
+            }
+
+            auto* op = reinterpret_cast<SegmentOp*>(batch[i].userData);
+            Request* request = op->request;
+
+            int64_t bytes = -1;
+            if (batch[i].result >= 0) {
+                bytes = batch[i].result;
+                if (bytes > 0 && bytes < op->seg.bytes) {
+                    // Short read before end of file: finish it synchronously
+                    int64_t more = op->file->readAt(op->seg.offset + bytes, op->seg.dst + bytes,
+                                                    op->seg.bytes - bytes);
+                    if (more > 0) bytes += more;
+                }
+            }
+
+            LIBCUEBIN_TRACE(readEnd, op->seg.lba, op->seg.sectors, op->seg.file->index, op->seg.offset, bytes);
+
+            // Same accounting as a synchronous read, timed from submission
+            const FileHandle& handle = *op->seg.file;
+            if (handle.collectStats) {
+                handle.stats.recordRead(op->seg.offset, op->seg.bytes, bytes, elapsedNs(op->submitted));
+            }
+
+            Status status = ErrorCode::FileReadError;
+            if (bytes >= 0) {
+                handle.countSectors(op->seg.sectors);
+                status = frameSegment(op->seg, bytes);
+            }
+
+            if (!status) {
+                int expected = -1;
+                request->error.compare_exchange_strong(expected, static_cast<int>(status.code()));
+            }
+
+            if (request->pending.fetch_sub(1) == 1) finishOps(request);
+        }
+    }
+}
+
+#else
+
+void AsyncReader::Impl::startIoUring(std::unique_ptr<Request>) {}
+void AsyncReader::Impl::finishOps(Request*) {}
+void AsyncReader::Impl::reaperLoop() {}
+
+#endif
+
+AsyncReader::AsyncReader(std::unique_ptr<Impl> impl) : m_impl(std::move(impl)) {}
+AsyncReader::~AsyncReader() = default;
+AsyncReader::AsyncReader(AsyncReader&& other) noexcept = default;
+AsyncReader& AsyncReader::operator=(AsyncReader&& other) noexcept = default;
+
+Result<AsyncReader> AsyncReader::create(const AsyncReaderOptions& options)
+{
+    auto impl = std::make_unique<Impl>();
+
+    bool wantUring = options.backend != AsyncBackend::ThreadPool;
+    bool haveUring = false;
+#ifdef LIBCUEBIN_HAS_IO_URING
+    if (wantUring) haveUring = impl->ring.init(std::max<uint32_t>(options.queueDepth, 1));
+#endif
+
+    if (options.backend == AsyncBackend::IoUring && !haveUring) {
+        return LIBCUEBIN_ERROR(ErrorCode::Unsupported,
+            "io_uring is not available on this system");
+    }
+
+    if (haveUring) {
+        impl->backend = AsyncBackend::IoUring;
+        impl->reaper = std::thread(&Impl::reaperLoop, impl.get());
+    } else {
+        if (wantUring) spdlog::debug("io_uring unavailable, using thread-pool async reads");
+        impl->backend = AsyncBackend::ThreadPool;
+        uint32_t threads = std::max<uint32_t>(options.threadCount, 1);
+        for (uint32_t i = 0; i < threads; ++i) {
+            impl->workers.emplace_back(&Impl::workerLoop, impl.get());
+        }
+    }
+
+    return AsyncReader(std::move(impl));
+}
+
+Result<uint64_t> AsyncReader::submit(const Disc& disc, int32_t lba, int32_t count,
+                                     std::span<uint8_t> out, std::span<TrackMode> modes,
+                                     AsyncCallback callback, void* userData)
+{
+    if (count <= 0 || out.size() < static_cast<size_t>(count) * RAW_SECTOR_SIZE
+        || (!modes.empty() && modes.size() < static_cast<size_t>(count))) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument,
+            "Async read needs a positive count and room for every sector");
+    }
+    int64_t endLba = static_cast<int64_t>(lba) + count;
+    if (lba < Disc::FIRST_LBA || endLba > disc.totalSectors()) {
+        return LIBCUEBIN_ERROR(ErrorCode::LBAOutOfRange,
+            "LBA range [" + std::to_string(lba) + ", " + std::to_string(endLba)
+            + ") out of range [" + std::to_string(Disc::FIRST_LBA) + ", "
+            + std::to_string(disc.totalSectors()) + ")");
+    }
+
+    auto request = std::make_unique<Request>();
+    uint64_t id = m_impl->nextId.fetch_add(1);
+    request->completion.id = id;
+    request->completion.disc = &disc;
+    request->completion.lba = lba;
+    request->completion.count = count;
+    request->completion.userData = userData;
+    request->callback = std::move(callback);
+    request->out = out.data();
+    request->modes = modes.empty() ? nullptr : modes.data();
+
+    m_impl->inFlight.fetch_add(1);
+
+    if (m_impl->backend == AsyncBackend::IoUring) {
+        m_impl->startIoUring(std::move(request));
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(m_impl->queueMutex);
+            m_impl->queue.push_back(std::move(request));
+        }
+        m_impl->queueReady.notify_one();
+    }
+
+    return id;
+}
+
+size_t AsyncReader::poll(std::span<AsyncCompletion> completions)
+{
+    std::lock_guard<std::mutex> lock(m_impl->completionMutex);
+    size_t n = std::min(completions.size(), m_impl->completions.size());
+    for (size_t i = 0; i < n; ++i) {
+        completions[i] = m_impl->completions.front();
+        m_impl->completions.pop_front();
+    }
+    return n;
+}
+
+size_t AsyncReader::wait(std::span<AsyncCompletion> completions, size_t minCompletions)
+{
+    minCompletions = std::min(minCompletions, completions.size());
+    {
+        std::unique_lock<std::mutex> lock(m_impl->completionMutex);
+        m_impl->completionReady.wait(lock, [&]() {
+            return m_impl->completions.size() >= minCompletions || m_impl->inFlight.load() == 0;
+        });
+    }
+    return poll(completions);
+}
+
+Task<Result<SectorData>> AsyncReader::readSector(const Disc& disc, int32_t lba, Executor& executor)
+{
+    SectorData sector;
+    ReadAwaiter awaiter{*this, disc, lba, 1, sector.data, std::span<TrackMode>(&sector.mode, 1), executor, {}, {}};
+    co_await awaiter;
+
+    if (awaiter.submitError) co_return std::move(*awaiter.submitError);
+    if (!awaiter.status) co_return asyncReadError(awaiter.status.code(), lba, 1);
+    co_return sector;
+}
+
+Task<Result<std::vector<SectorData>>> AsyncReader::readSectors(const Disc& disc, int32_t lba,
+                                                               int32_t count, Executor& executor)
+{
+    if (count <= 0) {
+        co_return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument, "Sector count must be positive");
+    }
+
+    std::vector<uint8_t> buffer(static_cast<size_t>(count) * RAW_SECTOR_SIZE);
+    std::vector<TrackMode> modes(count);
+    ReadAwaiter awaiter{*this, disc, lba, count, buffer, modes, executor, {}, {}};
+    co_await awaiter;
+
+    if (awaiter.submitError) co_return std::move(*awaiter.submitError);
+    if (!awaiter.status) co_return asyncReadError(awaiter.status.code(), lba, count);
+
+    std::vector<SectorData> sectors(count);
+    for (int32_t i = 0; i < count; ++i) {
+        sectors[i].mode = modes[i];
+        std::memcpy(sectors[i].data.data(), buffer.data() + static_cast<size_t>(i) * RAW_SECTOR_SIZE,
+                    RAW_SECTOR_SIZE);
+    }
+    co_return sectors;
+}
+
+size_t AsyncReader::inFlight() const noexcept
+{
+    return m_impl->inFlight.load();
+}
+
+AsyncBackend AsyncReader::backend() const noexcept
+{
+    return m_impl->backend;
+}
+
+} // namespace cuebin
@@ -0,0 +1,158 @@
+#include "audioContainer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace cuebin {
+
+namespace {
+
+uint16_t le16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+uint32_t le32(const uint8_t* p) { return le16(p) | static_cast<uint32_t>(le16(p + 2)) << 16; }
+uint16_t be16(const uint8_t* p) { return static_cast<uint16_t>(p[0] << 8 | p[1]); }
+uint32_t be32(const uint8_t* p) { return static_cast<uint32_t>(be16(p)) << 16 | be16(p + 2); }
+
+// 80-bit IEEE 754 extended precision, as used for the AIFF sample rate
+double extendedToDouble(const uint8_t* p)
+{
+    int exponent = ((p[0] & 0x7F) << 8 | p[1]) - 16383 - 63;
+    uint64_t mantissa = 0;
+    for (int i = 0; i < 8; ++i) mantissa = mantissa << 8 | p[2 + i];
+    double value = std::ldexp(static_cast<double>(mantissa), exponent);
+    return (p[0] & 0x80) ? -value : value;
+}
+
+Error formatError(const std::filesystem::path& path, const std::string& what)
+{
+    return LIBCUEBIN_ERROR(ErrorCode::InvalidFileType, what + ": " + path.string());
+}
+
+Error notCdAudio(const std::filesystem::path& path, unsigned channels, unsigned bits, double rate)
+{
+    return LIBCUEBIN_ERROR(ErrorCode::Unsupported,
+        "Not CD audio (" + std::to_string(channels) + " ch, " + std::to_string(bits) + "-bit, "
+        + std::to_string(static_cast<long>(rate)) + " Hz): " + path.string());
+}
+
+Result<AudioContainer> parseWave(std::ifstream& in, const std::filesystem::path& path, int64_t fileSize)
+{
+    bool haveFormat = false;
+    int64_t pos = 12;
+    while (pos + 8 <= fileSize) {
+        std::array<uint8_t, 8> chunk{};
+        in.seekg(pos);
+        if (!in.read(reinterpret_cast<char*>(chunk.data()), 8)) break;
+        int64_t size = le32(chunk.data() + 4);
+
+        if (std::memcmp(chunk.data(), "fmt ", 4) == 0) {
+            std::array<uint8_t, 16> fmt{};
+            if (size < 16 || !in.read(reinterpret_cast<char*>(fmt.data()), 16)) {
+                return formatError(path, "Truncated WAVE fmt chunk");
+            }
+            uint16_t format = le16(fmt.data());
+            uint16_t channels = le16(fmt.data() + 2);
+            uint32_t rate = le32(fmt.data() + 4);
+            uint16_t bits = le16(fmt.data() + 14);
+            // 1: PCM; 0xFFFE: WAVE_FORMAT_EXTENSIBLE, which CD rips use for the same data
+            if (format != 1 && format != 0xFFFE) {
+                return LIBCUEBIN_ERROR(ErrorCode::Unsupported,
+                    "Compressed WAVE data (format " + std::to_string(format) + "): " + path.string());
+            }
+            if (channels != 2 || bits != 16 || rate != 44100) return notCdAudio(path, channels, bits, rate);
+            haveFormat = true;
+        } else if (std::memcmp(chunk.data(), "data", 4) == 0) {
+            if (!haveFormat) return formatError(path, "WAVE data chunk before fmt chunk");
+            // Writers that stream the data chunk sometimes leave its size unset
+            int64_t available = fileSize - (pos + 8);
+            return AudioContainer{pos + 8, std::min(size, available), false};
+        }
+
+        pos += 8 + size + (size & 1); // Chunks are padded to even sizes
+    }
+    return formatError(path, "No data chunk in WAVE file");
+}
+
+Result<AudioContainer> parseAiff(std::ifstream& in, const std::filesystem::path& path, int64_t fileSize,
+                                 bool aifc)
+{
+    bool haveCommon = false;
+    bool bigEndian = true;
+    int64_t pos = 12;
+    while (pos + 8 <= fileSize) {
+        std::array<uint8_t, 8> chunk{};
+        in.seekg(pos);
+        if (!in.read(reinterpret_cast<char*>(chunk.data()), 8)) break;
+        int64_t size = be32(chunk.data() + 4);
+
+        if (std::memcmp(chunk.data(), "COMM", 4) == 0) {
+            std::array<uint8_t, 22> comm{};
+            size_t want = aifc ? 22 : 18;
+            if (size < static_cast<int64_t>(want)
+                || !in.read(reinterpret_cast<char*>(comm.data()), static_cast<std::streamsize>(want))) {
+                return formatError(path, "Truncated AIFF COMM chunk");
+            }
+            uint16_t channels = be16(comm.data());
+            uint16_t bits = be16(comm.data() + 6);
+            double rate = extendedToDouble(comm.data() + 8);
+            if (aifc) {
+                // "sowt" is the little-endian variant written by macOS tools
+                if (std::memcmp(comm.data() + 18, "sowt", 4) == 0) {
+                    bigEndian = false;
+                } else if (std::memcmp(comm.data() + 18, "NONE", 4) != 0) {
+                    return LIBCUEBIN_ERROR(ErrorCode::Unsupported,
+                        "Compressed AIFF-C data: " + path.string());
+                }
+            }
+            if (channels != 2 || bits != 16 || rate != 44100.0) return notCdAudio(path, channels, bits, rate);
+            haveCommon = true;
+        } else if (std::memcmp(chunk.data(), "SSND", 4) == 0) {
+            if (!haveCommon) return formatError(path, "AIFF SSND chunk before COMM chunk");
+            std::array<uint8_t, 8> header{};
+            if (size < 8 || !in.read(reinterpret_cast<char*>(header.data()), 8)) {
+                return formatError(path, "Truncated AIFF SSND chunk");
+            }
+            int64_t dataOffset = pos + 16 + be32(header.data());
+            int64_t dataSize = std::min<int64_t>(size - 8 - be32(header.data()), fileSize - dataOffset);
+            if (dataSize < 0) return formatError(path, "Invalid AIFF SSND offset");
+            return AudioContainer{dataOffset, dataSize, bigEndian};
+        }
+
+        pos += 8 + size + (size & 1);
+    }
+    return formatError(path, "No SSND chunk in AIFF file");
+}
+
+} // anonymous namespace
+
+Result<AudioContainer> parseAudioContainer(const std::filesystem::path& path, FileType type)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return LIBCUEBIN_ERROR(ErrorCode::FileNotFound, "Cannot open audio file: " + path.string());
+    }
+    in.seekg(0, std::ios::end);
+    int64_t fileSize = static_cast<int64_t>(in.tellg());
+    in.seekg(0);
+
+    std::array<uint8_t, 12> header{};
+    if (!in.read(reinterpret_cast<char*>(header.data()), 12)) {
+        return formatError(path, "Truncated audio file header");
+    }
+
+    if (type == FileType::Wave) {
+        if (std::memcmp(header.data(), "RIFF", 4) != 0 || std::memcmp(header.data() + 8, "WAVE", 4) != 0) {
+            return formatError(path, "Missing RIFF/WAVE header");
+        }
+        return parseWave(in, path, fileSize);
+    }
+
+    if (std::memcmp(header.data(), "FORM", 4) != 0) return formatError(path, "Missing FORM header");
+    if (std::memcmp(header.data() + 8, "AIFF", 4) == 0) return parseAiff(in, path, fileSize, false);
+    if (std::memcmp(header.data() + 8, "AIFC", 4) == 0) return parseAiff(in, path, fileSize, true);
+    return formatError(path, "Not an AIFF file");
+}
+
+} // namespace cuebin
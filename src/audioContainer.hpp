@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include "libcuebin/cueTypes.hpp"
+#include "libcuebin/error.hpp"
+
+namespace cuebin {
+
+// Location of the PCM samples inside a WAVE or AIFF file
+struct AudioContainer {
+    int64_t dataOffset = 0;
+    int64_t dataSize = 0;
+    bool bigEndian = false; // AIFF (and AIFF-C "NONE") store big-endian samples
+};
+
+// Reads the RIFF/FORM header of `path`. Only CD-DA audio is accepted:
+// uncompressed 16-bit stereo PCM at 44.1 kHz.
+Result<AudioContainer> parseAudioContainer(const std::filesystem::path& path, FileType type);
+
+} // namespace cuebin
@@ -0,0 +1,294 @@
+#include "libcuebin/blockCache.hpp"
+#include "blockCacheInternal.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cuebin {
+
+namespace {
+
+constexpr size_t SHARD_COUNT = 16;
+
+struct BlockKey {
+    uint64_t fileId;
+    int64_t blockIndex;
+
+    bool operator==(const BlockKey&) const = default;
+};
+
+struct BlockKeyHash {
+    size_t operator()(const BlockKey& key) const noexcept
+    {
+        // 64-bit mix of both halves (splitmix64 finalizer)
+        uint64_t h = key.fileId * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(key.blockIndex);
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBull;
+        h ^= h >> 31;
+        return static_cast<size_t>(h);
+    }
+};
+
+struct Entry {
+    BlockKey key{};
+    std::unique_ptr<uint8_t[]> data;
+    uint32_t size = 0;
+    bool referenced = false;
+    bool live = false;
+};
+
+struct Shard {
+    std::mutex mutex;
+    std::unordered_map<BlockKey, size_t, BlockKeyHash> index;
+    std::vector<Entry> entries;
+    std::vector<size_t> freeSlots;
+    size_t hand = 0;
+    size_t bytesUsed = 0;
+};
+
+class CacheState {
+public:
+    static CacheState& instance()
+    {
+        static CacheState state;
+        return state;
+    }
+
+    std::array<Shard, SHARD_COUNT> shards;
+    std::atomic<size_t> capacity{BlockCache::DEFAULT_CAPACITY};
+    std::atomic<size_t> bytesUsed{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+
+    // Identifiers of the files open with caching, by content key. Ids are
+    // never reused, so blocks of a forgotten id cannot be served again.
+    struct FileIdRef {
+        uint64_t id = 0;
+        size_t refs = 0;
+    };
+    std::mutex idMutex;
+    std::unordered_map<std::string, FileIdRef> fileIds;
+    std::unordered_map<uint64_t, const std::string*> fileKeys; // Keys of `fileIds`, by id
+    uint64_t nextFileId = 1;
+
+    Shard& shardFor(const BlockKey& key)
+    {
+        return shards[BlockKeyHash{}(key) % SHARD_COUNT];
+    }
+
+    size_t shardBudget() const noexcept
+    {
+        return capacity.load(std::memory_order_relaxed) / SHARD_COUNT;
+    }
+
+    // Evicts the first unreferenced block under the CLOCK hand, clearing
+    // reference bits as it sweeps. Caller holds the shard mutex.
+    bool evictOne(Shard& shard)
+    {
+        size_t n = shard.entries.size();
+        for (size_t step = 0; step < 2 * n; ++step) {
+            auto& e = shard.entries[shard.hand];
+            size_t slot = shard.hand;
+            shard.hand = (shard.hand + 1) % n;
+
+            if (!e.live) continue;
+            if (e.referenced) {
+                e.referenced = false;
+                continue;
+            }
+
+            shard.index.erase(e.key);
+            shard.bytesUsed -= e.size;
+            bytesUsed.fetch_sub(e.size, std::memory_order_relaxed);
+            e.data.reset();
+            e.size = 0;
+            e.live = false;
+            shard.freeSlots.push_back(slot);
+            evictions.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void shrinkTo(Shard& shard, size_t budget)
+    {
+        while (shard.bytesUsed > budget && evictOne(shard)) {}
+    }
+};
+
+} // anonymous namespace
+
+void BlockCache::setCapacity(size_t bytes)
+{
+    auto& state = CacheState::instance();
+    state.capacity.store(bytes, std::memory_order_relaxed);
+
+    size_t budget = state.shardBudget();
+    for (auto& shard : state.shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        state.shrinkTo(shard, budget);
+    }
+}
+
+size_t BlockCache::capacity() noexcept
+{
+    return CacheState::instance().capacity.load(std::memory_order_relaxed);
+}
+
+BlockCacheStats BlockCache::stats() noexcept
+{
+    auto& state = CacheState::instance();
+    BlockCacheStats s;
+    s.hits = state.hits.load(std::memory_order_relaxed);
+    s.misses = state.misses.load(std::memory_order_relaxed);
+    s.evictions = state.evictions.load(std::memory_order_relaxed);
+    s.bytesUsed = state.bytesUsed.load(std::memory_order_relaxed);
+    s.capacityBytes = state.capacity.load(std::memory_order_relaxed);
+    return s;
+}
+
+void BlockCache::resetStats() noexcept
+{
+    auto& state = CacheState::instance();
+    state.hits.store(0, std::memory_order_relaxed);
+    state.misses.store(0, std::memory_order_relaxed);
+    state.evictions.store(0, std::memory_order_relaxed);
+}
+
+void BlockCache::clear()
+{
+    auto& state = CacheState::instance();
+    for (auto& shard : state.shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        state.bytesUsed.fetch_sub(shard.bytesUsed, std::memory_order_relaxed);
+        shard.index.clear();
+        shard.entries.clear();
+        shard.freeSlots.clear();
+        shard.hand = 0;
+        shard.bytesUsed = 0;
+    }
+}
+
+namespace detail {
+
+uint64_t blockCacheFileId(const std::filesystem::path& path, int64_t fileSize)
+{
+    std::error_code ec;
+    auto canonical = std::filesystem::weakly_canonical(path, ec);
+    if (ec) canonical = path;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    auto ticks = ec ? 0 : mtime.time_since_epoch().count();
+
+    std::string key = canonical.string() + '|' + std::to_string(fileSize)
+                    + '|' + std::to_string(ticks);
+
+    auto& state = CacheState::instance();
+    std::lock_guard<std::mutex> lock(state.idMutex);
+    auto [it, inserted] = state.fileIds.try_emplace(std::move(key));
+    if (inserted) {
+        it->second.id = state.nextFileId++;
+        state.fileKeys.emplace(it->second.id, &it->first);
+    }
+    ++it->second.refs;
+    return it->second.id;
+}
+
+void blockCacheReleaseFileId(uint64_t fileId) noexcept
+{
+    auto& state = CacheState::instance();
+    std::lock_guard<std::mutex> lock(state.idMutex);
+    auto key = state.fileKeys.find(fileId);
+    if (key == state.fileKeys.end()) return;
+    auto it = state.fileIds.find(*key->second);
+    if (--it->second.refs > 0) return;
+    state.fileIds.erase(it);
+    state.fileKeys.erase(key);
+}
+
+size_t blockCacheFileIdCount() noexcept
+{
+    auto& state = CacheState::instance();
+    std::lock_guard<std::mutex> lock(state.idMutex);
+    return state.fileIds.size();
+}
+
+int64_t blockCacheLookup(uint64_t fileId, int64_t blockIndex,
+                         int64_t offsetInBlock, uint8_t* dst, int64_t size)
+{
+    auto& state = CacheState::instance();
+    BlockKey key{fileId, blockIndex};
+    auto& shard = state.shardFor(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        state.misses.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+
+    auto& e = shard.entries[it->second];
+    e.referenced = true;
+    state.hits.fetch_add(1, std::memory_order_relaxed);
+
+    int64_t n = std::clamp<int64_t>(static_cast<int64_t>(e.size) - offsetInBlock, 0, size);
+    if (n > 0) std::memcpy(dst, e.data.get() + offsetInBlock, static_cast<size_t>(n));
+    return n;
+}
+
+void blockCacheInsert(uint64_t fileId, int64_t blockIndex,
+                      std::unique_ptr<uint8_t[]> data, uint32_t size)
+{
+    auto& state = CacheState::instance();
+    size_t budget = state.shardBudget();
+    if (size == 0 || size > budget) return;
+
+    BlockKey key{fileId, blockIndex};
+    auto& shard = state.shardFor(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // Another reader may have loaded the same block concurrently
+    if (shard.index.count(key)) return;
+
+    state.shrinkTo(shard, budget - size);
+
+    // Runs under the noexcept reads: if the bookkeeping cannot grow, leave
+    // the shard as it was and let `data` free the block
+    bool fresh = shard.freeSlots.empty();
+    size_t slot = fresh ? shard.entries.size() : shard.freeSlots.back();
+    try {
+        if (fresh) {
+            shard.entries.emplace_back();
+            // Any slot may end up free: keep room so that eviction never allocates
+            shard.freeSlots.reserve(shard.entries.capacity());
+        }
+        shard.index.emplace(key, slot);
+    } catch (const std::bad_alloc&) {
+        if (fresh && shard.entries.size() > slot) shard.entries.pop_back();
+        return;
+    }
+    if (!fresh) shard.freeSlots.pop_back();
+
+    auto& e = shard.entries[slot];
+    e.key = key;
+    e.data = std::move(data);
+    e.size = size;
+    e.referenced = false;
+    e.live = true;
+
+    shard.bytesUsed += size;
+    state.bytesUsed.fetch_add(size, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+} // namespace cuebin
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace cuebin::detail {
+
+// Returns a process-wide identifier for the file's current contents, derived
+// from its canonical path, size and modification time, and takes a reference
+// on it. Every call is paired with blockCacheReleaseFileId().
+uint64_t blockCacheFileId(const std::filesystem::path& path, int64_t fileSize);
+
+// Drops a reference taken by blockCacheFileId(). The last one forgets the
+// file: a later open gets a fresh identifier, and the blocks cached under
+// this one age out of the cache.
+void blockCacheReleaseFileId(uint64_t fileId) noexcept;
+
+// Identifiers currently referenced, for tests
+size_t blockCacheFileIdCount() noexcept;
+
+// Copies `size` bytes at `offsetInBlock` of a cached block into `dst`.
+// Returns the number of bytes copied (short if the block is short),
+// or -1 if the block is not cached.
+int64_t blockCacheLookup(uint64_t fileId, int64_t blockIndex,
+                         int64_t offsetInBlock, uint8_t* dst, int64_t size);
+
+// Hands a freshly loaded block over to the cache. If the cache's own
+// bookkeeping cannot grow, the block is freed instead.
+void blockCacheInsert(uint64_t fileId, int64_t blockIndex,
+                      std::unique_ptr<uint8_t[]> data, uint32_t size);
+
+} // namespace cuebin::detail
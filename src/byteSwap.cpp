@@ -0,0 +1,32 @@
+#include "byteSwap.hpp"
+
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LIBCUEBIN_HAS_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LIBCUEBIN_HAS_NEON 1
+#endif
+
+namespace cuebin {
+
+void swapSampleBytes(uint8_t* data, size_t size) noexcept
+{
+    size_t i = 0;
+#if defined(LIBCUEBIN_HAS_SSE2)
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), v);
+    }
+#elif defined(LIBCUEBIN_HAS_NEON)
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(data + i, vrev16q_u8(vld1q_u8(data + i)));
+    }
+#endif
+    for (; i + 1 < size; i += 2) std::swap(data[i], data[i + 1]);
+}
+
+} // namespace cuebin
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cuebin {
+
+// Swaps the two bytes of every 16-bit sample in place (SSE2/NEON where
+// available). A trailing odd byte is left untouched.
+void swapSampleBytes(uint8_t* data, size_t size) noexcept;
+
+} // namespace cuebin
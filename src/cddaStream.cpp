@@ -0,0 +1,281 @@
+#include "libcuebin/cddaStream.hpp"
+
+#include "byteSwap.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace cuebin {
+
+namespace {
+
+constexpr size_t FRAME_BYTES = 4; // Interleaved S16 stereo
+constexpr auto PRODUCER_POLL = std::chrono::milliseconds(2);
+
+struct Segment {
+    const Track* track = nullptr;
+    int32_t lba = 0;
+    int32_t sectors = 0;
+    uint64_t firstFrame = 0;
+    bool silence = false;     // PREGAP/POSTGAP: not stored in any file
+    bool swapBytes = false;   // Sample byte order differs from the host's
+    uint8_t silenceIndex = 0; // Index reported while in a silent segment
+};
+
+} // anonymous namespace
+
+struct CddaStream::Impl {
+    const Disc* disc = nullptr;
+    std::vector<Segment> segments;
+    uint64_t totalFrames = 0;
+    int32_t chunkSectors = 0;
+
+    std::unique_ptr<uint8_t[]> ring;
+    size_t capacity = 0; // Bytes, power of two
+    std::vector<uint8_t> staging;
+
+    // Byte positions; they only grow, so head - tail is the fill level
+    alignas(64) std::atomic<uint64_t> writePos{0};
+    alignas(64) std::atomic<uint64_t> readPos{0};
+    alignas(64) std::atomic<uint64_t> underruns{0};
+    std::atomic<bool> producerDone{false};
+    std::atomic<bool> stopRequested{false};
+    Status producerStatus; // Published by producerDone
+
+    std::thread producer;
+
+    ~Impl()
+    {
+        stopRequested.store(true, std::memory_order_relaxed);
+        if (producer.joinable()) producer.join();
+    }
+
+    bool waitForSpace(size_t bytes)
+    {
+        while (capacity - (writePos.load(std::memory_order_relaxed)
+                           - readPos.load(std::memory_order_acquire)) < bytes) {
+            if (stopRequested.load(std::memory_order_relaxed)) return false;
+            std::this_thread::sleep_for(PRODUCER_POLL);
+        }
+        return true;
+    }
+
+    void push(const uint8_t* src, size_t bytes) noexcept
+    {
+        uint64_t w = writePos.load(std::memory_order_relaxed);
+        size_t at = static_cast<size_t>(w & (capacity - 1));
+        size_t first = std::min(bytes, capacity - at);
+        if (src) {
+            std::memcpy(ring.get() + at, src, first);
+            std::memcpy(ring.get(), src + first, bytes - first);
+        } else {
+            std::memset(ring.get() + at, 0, first);
+            std::memset(ring.get(), 0, bytes - first);
+        }
+        writePos.store(w + bytes, std::memory_order_release);
+    }
+
+    Status fill(const Segment& seg, int32_t lba, int32_t count) noexcept
+    {
+        size_t bytes = static_cast<size_t>(count) * RAW_SECTOR_SIZE;
+        if (seg.silence) {
+            push(nullptr, bytes);
+            return {};
+        }
+
+        size_t written = 0;
+        if (auto status = disc->readUserDataInto(lba, count, staging, &written); !status) return status;
+        if (written != bytes) return ErrorCode::FileReadError;
+        if (seg.swapBytes) swapSampleBytes(staging.data(), bytes);
+        push(staging.data(), bytes);
+        return {};
+    }
+
+    void produce()
+    {
+        for (const auto& seg : segments) {
+            for (int32_t done = 0; done < seg.sectors;) {
+                int32_t count = std::min(chunkSectors, seg.sectors - done);
+                if (!waitForSpace(static_cast<size_t>(count) * RAW_SECTOR_SIZE)) {
+                    producerDone.store(true, std::memory_order_release);
+                    return;
+                }
+                if (auto status = fill(seg, seg.lba + done, count); !status) {
+                    spdlog::warn("CDDA stream stopped at LBA {}", seg.lba + done);
+                    producerStatus = status;
+                    producerDone.store(true, std::memory_order_release);
+                    return;
+                }
+                done += count;
+            }
+        }
+        producerDone.store(true, std::memory_order_release);
+    }
+};
+
+CddaStream::CddaStream(std::unique_ptr<Impl> impl)
+    : m_impl(std::move(impl))
+{}
+
+CddaStream::~CddaStream() = default;
+CddaStream::CddaStream(CddaStream&& other) noexcept = default;
+CddaStream& CddaStream::operator=(CddaStream&& other) noexcept = default;
+
+Result<CddaStream> CddaStream::open(const Disc& disc, const CddaStreamOptions& options)
+{
+    uint8_t first = options.firstTrack;
+    uint8_t last = options.lastTrack;
+    for (const auto& t : disc.tracks()) {
+        if (!t.isAudio()) continue;
+        if (options.firstTrack == 0 && (first == 0 || t.number() < first)) first = t.number();
+        if (options.lastTrack == 0 && t.number() > last) last = t.number();
+    }
+    if (first == 0 || last < first || !disc.track(first) || !disc.track(last)) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument,
+            "Invalid CDDA track range " + std::to_string(first) + "-" + std::to_string(last));
+    }
+    if (options.chunkSectors <= 0) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument, "chunkSectors must be positive");
+    }
+
+    auto impl = std::make_unique<Impl>();
+    impl->disc = &disc;
+    impl->chunkSectors = options.chunkSectors;
+
+    const auto& files = disc.cueSheet().files;
+    constexpr bool bigEndianHost = std::endian::native == std::endian::big;
+    auto addSegment = [&](Segment seg) {
+        if (seg.sectors <= 0) return;
+        seg.firstFrame = impl->totalFrames;
+        impl->totalFrames += static_cast<uint64_t>(seg.sectors) * FRAMES_PER_SECTOR;
+        impl->segments.push_back(seg);
+    };
+
+    for (const auto& t : disc.tracks()) {
+        if (t.number() < first || t.number() > last || !t.isAudio()) continue;
+
+        bool motorola = files[t.fileIndex()].type == FileType::Motorola;
+        uint8_t lastIndex = 1;
+        for (const auto& idx : t.indices()) lastIndex = std::max(lastIndex, idx.number);
+
+        addSegment({&t, t.startLba() - t.pregapSectors(), t.pregapSectors(), 0, true, false, 0});
+        addSegment({&t, t.startLba(), t.lengthSectors(), 0, false, motorola != bigEndianHost, 0});
+        addSegment({&t, t.endLba(), t.postgapSectors(), 0, true, false, lastIndex});
+    }
+    if (impl->segments.empty()) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument,
+            "No audio in tracks " + std::to_string(first) + "-" + std::to_string(last));
+    }
+
+    // Room for at least two producer chunks so reads and refills overlap
+    size_t chunkBytes = static_cast<size_t>(options.chunkSectors) * RAW_SECTOR_SIZE;
+    impl->capacity = std::bit_ceil(std::max(options.bufferFrames * FRAME_BYTES, 2 * chunkBytes));
+    impl->ring = std::make_unique<uint8_t[]>(impl->capacity);
+    impl->staging.resize(chunkBytes);
+
+    Impl* raw = impl.get();
+    impl->producer = std::thread([raw]() { raw->produce(); });
+
+    spdlog::debug("CDDA stream: tracks {}-{}, {} frames, {} byte ring",
+                  first, last, impl->totalFrames, impl->capacity);
+    return CddaStream(std::move(impl));
+}
+
+size_t CddaStream::read(std::span<int16_t> out) noexcept
+{
+    auto& d = *m_impl;
+    auto* dst = reinterpret_cast<uint8_t*>(out.data());
+    size_t want = out.size() / 2 * FRAME_BYTES;
+
+    uint64_t r = d.readPos.load(std::memory_order_relaxed);
+    uint64_t w = d.writePos.load(std::memory_order_acquire);
+    size_t avail = static_cast<size_t>(std::min<uint64_t>(w - r, want));
+
+    size_t at = static_cast<size_t>(r & (d.capacity - 1));
+    size_t first = std::min(avail, d.capacity - at);
+    std::memcpy(dst, d.ring.get() + at, first);
+    std::memcpy(dst + first, d.ring.get(), avail - first);
+    d.readPos.store(r + avail, std::memory_order_release);
+
+    if (avail < out.size_bytes()) {
+        std::memset(dst + avail, 0, out.size_bytes() - avail);
+        if (avail < want && !d.producerDone.load(std::memory_order_acquire)) {
+            d.underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return avail / FRAME_BYTES;
+}
+
+CddaPosition CddaStream::position() const noexcept
+{
+    const auto& d = *m_impl;
+    uint64_t frame = std::min(d.readPos.load(std::memory_order_acquire) / FRAME_BYTES, d.totalFrames);
+
+    // Last segment starting at or before `frame`; past the end, stay on the final frame
+    uint64_t lookup = frame < d.totalFrames ? frame : d.totalFrames - 1;
+    auto it = std::upper_bound(d.segments.begin(), d.segments.end(), lookup,
+                               [](uint64_t f, const Segment& s) { return f < s.firstFrame; });
+    const Segment& seg = *std::prev(it);
+
+    uint64_t offset = frame - seg.firstFrame;
+    CddaPosition pos;
+    pos.track = seg.track->number();
+    pos.lba = seg.lba + static_cast<int32_t>(offset / FRAMES_PER_SECTOR);
+    pos.frameInSector = static_cast<uint32_t>(offset % FRAMES_PER_SECTOR);
+
+    if (seg.silence) {
+        pos.index = seg.silenceIndex;
+    } else {
+        // Index positions are file-relative; the track's LBAs start at INDEX 01
+        const Track& t = *seg.track;
+        int32_t fileSector = std::min(pos.lba, seg.lba + seg.sectors - 1) - t.fileStartLba();
+        for (const auto& idx : t.indices()) {
+            if (idx.number == 1) fileSector += idx.position.toLba();
+        }
+        pos.index = 1;
+        for (const auto& idx : t.indices()) {
+            if (idx.number >= 1 && idx.position.toLba() <= fileSector) pos.index = idx.number;
+        }
+    }
+    return pos;
+}
+
+size_t CddaStream::bufferedFrames() const noexcept
+{
+    const auto& d = *m_impl;
+    return static_cast<size_t>(d.writePos.load(std::memory_order_acquire)
+                               - d.readPos.load(std::memory_order_acquire)) / FRAME_BYTES;
+}
+
+uint64_t CddaStream::totalFrames() const noexcept
+{
+    return m_impl->totalFrames;
+}
+
+uint64_t CddaStream::underruns() const noexcept
+{
+    return m_impl->underruns.load(std::memory_order_relaxed);
+}
+
+bool CddaStream::finished() const noexcept
+{
+    const auto& d = *m_impl;
+    return d.producerDone.load(std::memory_order_acquire)
+        && d.readPos.load(std::memory_order_relaxed) == d.writePos.load(std::memory_order_relaxed);
+}
+
+Status CddaStream::status() const noexcept
+{
+    const auto& d = *m_impl;
+    if (!d.producerDone.load(std::memory_order_acquire)) return {};
+    return d.producerStatus;
+}
+
+} // namespace cuebin
@@ -0,0 +1,253 @@
+#include "compressedFile.hpp"
+
+#include "libcuebin/hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <new>
+
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+
+namespace cuebin {
+
+namespace {
+
+uint32_t le32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8
+         | static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+uint64_t le64(const uint8_t* p)
+{
+    return le32(p) | static_cast<uint64_t>(le32(p + 4)) << 32;
+}
+
+constexpr size_t FRAME_BYTES = 4; // Interleaved 16-bit stereo
+
+uint16_t sampleAt(const uint8_t* p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+
+void setSample(uint8_t* p, uint16_t v)
+{
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+} // anonymous namespace
+
+void deltaEncodeSamples(uint8_t* data, size_t size) noexcept
+{
+    // Backwards, so each sample is still intact when its successor needs it
+    size_t samples = size / 2;
+    for (size_t i = samples; i-- > FRAME_BYTES / 2;) {
+        uint8_t* p = data + i * 2;
+        setSample(p, static_cast<uint16_t>(sampleAt(p) - sampleAt(p - FRAME_BYTES)));
+    }
+}
+
+void deltaDecodeSamples(uint8_t* data, size_t size) noexcept
+{
+    size_t samples = size / 2;
+    for (size_t i = FRAME_BYTES / 2; i < samples; ++i) {
+        uint8_t* p = data + i * 2;
+        setSample(p, static_cast<uint16_t>(sampleAt(p) + sampleAt(p - FRAME_BYTES)));
+    }
+}
+
+bool CompressedFile::detect(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(cbc::MAGIC)] = {};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, cbc::MAGIC, sizeof(magic)) == 0;
+}
+
+bool CompressedFile::open(const std::filesystem::path& path, size_t cacheChunks)
+{
+    if (!m_file.open(path)) return false;
+
+    uint8_t header[cbc::HEADER_SIZE];
+    if (m_file.readAt(0, header, sizeof(header)) != static_cast<int64_t>(sizeof(header))
+        || std::memcmp(header, cbc::MAGIC, sizeof(cbc::MAGIC)) != 0
+        || le32(header + 8) != cbc::VERSION) {
+        spdlog::error("Not a supported compressed image: {}", path.string());
+        return false;
+    }
+
+    m_chunkBytes = le32(header + 12);
+    m_size = static_cast<int64_t>(le64(header + 16));
+    uint32_t chunkCount = le32(header + 24);
+    uint64_t indexOffset = le64(header + 32);
+    if (m_chunkBytes == 0 || m_chunkBytes % RAW_SECTOR_SIZE != 0
+        || m_chunkBytes > cbc::MAX_CHUNK_SECTORS * RAW_SECTOR_SIZE || m_size < 0
+        || chunkCount != (static_cast<uint64_t>(m_size) + m_chunkBytes - 1) / m_chunkBytes) {
+        spdlog::error("Corrupt compressed image header: {}", path.string());
+        return false;
+    }
+
+    // Validate against the file before trusting the header's sizes
+    std::error_code ec;
+    uint64_t fileSize = std::filesystem::file_size(path, ec);
+    uint64_t indexBytes = static_cast<uint64_t>(chunkCount) * cbc::INDEX_ENTRY_SIZE;
+    if (ec || indexOffset < cbc::HEADER_SIZE || indexOffset > fileSize
+        || indexBytes > fileSize - indexOffset) {
+        spdlog::error("Truncated compressed image index: {}", path.string());
+        return false;
+    }
+
+    std::vector<uint8_t> index(static_cast<size_t>(indexBytes));
+    if (m_file.readAt(static_cast<int64_t>(indexOffset), index.data(), static_cast<int64_t>(index.size()))
+        != static_cast<int64_t>(index.size())) {
+        spdlog::error("Truncated compressed image index: {}", path.string());
+        return false;
+    }
+
+    auto maxStoredSize = static_cast<size_t>(compressBound(static_cast<uLong>(m_chunkBytes)));
+    m_chunks.resize(chunkCount);
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        const uint8_t* e = index.data() + static_cast<size_t>(i) * cbc::INDEX_ENTRY_SIZE;
+        m_chunks[i].offset = le64(e);
+        m_chunks[i].storedSize = le32(e + 8);
+        m_chunks[i].crc = le32(e + 12);
+        if (e[16] > static_cast<uint8_t>(ChunkCodec::DeltaDeflate)) {
+            spdlog::error("Unknown codec {} in compressed image: {}", e[16], path.string());
+            return false;
+        }
+        m_chunks[i].codec = static_cast<ChunkCodec>(e[16]);
+
+        // Payloads sit between the header and the index, and never exceed
+        // what deflate can produce from one chunk
+        const Chunk& chunk = m_chunks[i];
+        if (chunk.offset < cbc::HEADER_SIZE || chunk.offset > indexOffset
+            || chunk.storedSize > indexOffset - chunk.offset || chunk.storedSize > maxStoredSize) {
+            spdlog::error("Corrupt index entry {} in compressed image: {}", i, path.string());
+            return false;
+        }
+    }
+
+    m_cacheChunks = std::max<size_t>(1, cacheChunks);
+    m_cache.reserve(m_cacheChunks);
+    m_maxStoredSize = maxStoredSize;
+    m_scratch.emplace_back().reserve(m_maxStoredSize);
+    spdlog::debug("Opened compressed image {}: {} bytes in {} chunks",
+                  path.string(), m_size, chunkCount);
+    return true;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> CompressedFile::load(uint32_t index) const
+{
+    std::shared_ptr<std::vector<uint8_t>> data;
+    std::vector<uint8_t> stored;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        for (auto& entry : m_cache) {
+            if (entry.chunk == index) {
+                entry.lastUse = ++m_useCounter;
+                return entry.data;
+            }
+        }
+        if (!m_spareChunks.empty()) {
+            data = std::move(m_spareChunks.back());
+            m_spareChunks.pop_back();
+        }
+        if (!m_scratch.empty()) {
+            stored = std::move(m_scratch.back());
+            m_scratch.pop_back();
+        }
+    }
+
+    // Inflate outside the lock so readers of other chunks are not held up.
+    // Buffers are sized once, for the largest chunk, and only resized within
+    // their capacity from then on.
+    const Chunk& chunk = m_chunks[index];
+    size_t length = static_cast<size_t>(std::min<int64_t>(
+        m_chunkBytes, m_size - static_cast<int64_t>(index) * m_chunkBytes));
+    // Allocation failures fail the read: callers include noexcept read paths
+    try {
+        if (!data) {
+            data = std::make_shared<std::vector<uint8_t>>();
+            data->reserve(m_chunkBytes);
+        }
+        if (stored.capacity() < m_maxStoredSize) stored.reserve(m_maxStoredSize);
+    } catch (const std::bad_alloc&) {
+        spdlog::error("Out of memory inflating compressed chunk {}", index);
+        return nullptr;
+    }
+    data->resize(length);
+    stored.resize(chunk.storedSize);
+
+    bool ok = m_file.readAt(static_cast<int64_t>(chunk.offset), stored.data(), chunk.storedSize)
+              == static_cast<int64_t>(chunk.storedSize);
+    if (ok) {
+        switch (chunk.codec) {
+            case ChunkCodec::Zero:
+                std::memset(data->data(), 0, length);
+                break;
+            case ChunkCodec::Stored:
+                ok = stored.size() == length;
+                if (ok) std::memcpy(data->data(), stored.data(), length);
+                break;
+            case ChunkCodec::Deflate:
+            case ChunkCodec::DeltaDeflate: {
+                uLongf outLength = static_cast<uLongf>(length);
+                ok = uncompress(data->data(), &outLength, stored.data(), static_cast<uLong>(stored.size())) == Z_OK
+                     && outLength == length;
+                if (ok && chunk.codec == ChunkCodec::DeltaDeflate) deltaDecodeSamples(data->data(), length);
+                break;
+            }
+        }
+    }
+    if (ok && crc32(*data) != chunk.crc) {
+        spdlog::error("CRC mismatch in compressed chunk {}", index);
+        ok = false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    try {
+        m_scratch.push_back(std::move(stored));
+        if (!ok) {
+            m_spareChunks.push_back(std::move(data));
+            return nullptr;
+        }
+        if (m_cache.size() < m_cacheChunks) {
+            m_cache.push_back({index, ++m_useCounter, data}); // Reserved by open()
+        } else {
+            auto oldest = std::min_element(m_cache.begin(), m_cache.end(),
+                [](const CacheEntry& a, const CacheEntry& b) { return a.lastUse < b.lastUse; });
+            // Recycle the evicted buffer unless a reader is still copying from it;
+            // new references are only taken under this lock
+            if (oldest->data.use_count() == 1) m_spareChunks.push_back(std::move(oldest->data));
+            *oldest = {index, ++m_useCounter, data};
+        }
+    } catch (const std::bad_alloc&) {
+        // A pool could not grow: the buffers are freed instead of recycled
+    }
+    return ok ? data : nullptr;
+}
+
+int64_t CompressedFile::readAt(int64_t offset, uint8_t* dst, int64_t size) const
+{
+    if (offset < 0 || offset > m_size) return -1;
+    int64_t n = std::min(size, m_size - offset);
+
+    int64_t total = 0;
+    while (total < n) {
+        int64_t pos = offset + total;
+        auto index = static_cast<uint32_t>(pos / m_chunkBytes);
+        int64_t inChunk = pos % m_chunkBytes;
+        int64_t want = std::min<int64_t>(n - total, m_chunkBytes - inChunk);
+
+        if (m_chunks[index].codec == ChunkCodec::Zero) {
+            std::memset(dst + total, 0, static_cast<size_t>(want));
+        } else {
+            auto data = load(index);
+            if (!data) return -1;
+            std::memcpy(dst + total, data->data() + inChunk, static_cast<size_t>(want));
+        }
+        total += want;
+    }
+    return total;
+}
+
+} // namespace cuebin
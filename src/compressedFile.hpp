@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "libcuebin/compressedImage.hpp"
+#include "rawFile.hpp"
+
+namespace cuebin {
+
+namespace cbc {
+
+constexpr char MAGIC[8] = {'C', 'U', 'E', 'B', 'I', 'N', 'Z', '1'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 40;
+constexpr size_t INDEX_ENTRY_SIZE = 20;
+// Largest chunk written or read, about 2.3 MiB; bounds a reader's buffers
+constexpr int32_t MAX_CHUNK_SECTORS = 1024;
+
+} // namespace cbc
+
+// Read side of the .cbc container: serves byte ranges of the original file
+// by inflating the chunks they touch. Recently used chunks are kept
+// decompressed. Safe for concurrent readAt() calls.
+class CompressedFile {
+public:
+    // True if `path` starts with the .cbc magic
+    static bool detect(const std::filesystem::path& path);
+
+    bool open(const std::filesystem::path& path, size_t cacheChunks);
+
+    // Size of the original (decompressed) file
+    int64_t size() const noexcept { return m_size; }
+
+    // Same contract as FileHandle::readAt(); -1 also signals a corrupt chunk
+    int64_t readAt(int64_t offset, uint8_t* dst, int64_t size) const;
+
+private:
+    struct Chunk {
+        uint64_t offset = 0;
+        uint32_t storedSize = 0;
+        uint32_t crc = 0;
+        ChunkCodec codec = ChunkCodec::Stored;
+    };
+
+    struct CacheEntry {
+        uint32_t chunk = 0;
+        uint64_t lastUse = 0;
+        std::shared_ptr<std::vector<uint8_t>> data;
+    };
+
+    std::shared_ptr<const std::vector<uint8_t>> load(uint32_t index) const;
+
+    RawFile m_file;
+    int64_t m_size = 0;
+    uint32_t m_chunkBytes = 0;
+    std::vector<Chunk> m_chunks;
+
+    mutable std::mutex m_cacheMutex;
+    mutable std::vector<CacheEntry> m_cache;
+    mutable uint64_t m_useCounter = 0;
+    size_t m_cacheChunks = 0;
+
+    // Buffers recycled across chunk misses, guarded by m_cacheMutex: evicted
+    // decompressed chunks no reader still holds, and compressed-input scratch
+    // (one per concurrent miss), so a warm file inflates without allocating.
+    mutable std::vector<std::shared_ptr<std::vector<uint8_t>>> m_spareChunks;
+    mutable std::vector<std::vector<uint8_t>> m_scratch;
+    size_t m_maxStoredSize = 0;
+};
+
+// Delta filter used by ChunkCodec::DeltaDeflate on interleaved 16-bit
+// stereo samples: each sample minus the previous one of its channel.
+void deltaEncodeSamples(uint8_t* data, size_t size) noexcept;
+void deltaDecodeSamples(uint8_t* data, size_t size) noexcept;
+
+} // namespace cuebin
@@ -0,0 +1,223 @@
+#include "libcuebin/compressedImage.hpp"
+#include "libcuebin/cueWriter.hpp"
+#include "libcuebin/hash.hpp"
+
+#include "compressedFile.hpp"
+#include "discImpl.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+
+namespace cuebin {
+
+namespace {
+
+// Reads up to `size` bytes at `offset`; returns the count, or -1 on error
+using SourceReader = std::function<int64_t(int64_t offset, uint8_t* dst, int64_t size)>;
+
+void put32(uint8_t* p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+void put64(uint8_t* p, uint64_t v)
+{
+    put32(p, static_cast<uint32_t>(v));
+    put32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+bool deflateInto(const uint8_t* src, size_t size, int level, std::vector<uint8_t>& out)
+{
+    uLongf length = compressBound(static_cast<uLong>(size));
+    out.resize(length);
+    if (compress2(out.data(), &length, src, static_cast<uLong>(size), level) != Z_OK) return false;
+    out.resize(length);
+    return true;
+}
+
+Result<CompressStats> compressSource(const SourceReader& read, int64_t size,
+                                     const std::filesystem::path& dest,
+                                     std::span<const ByteExtent> audio,
+                                     const CompressOptions& options)
+{
+    if (options.chunkSectors <= 0 || options.chunkSectors > cbc::MAX_CHUNK_SECTORS
+        || options.level < 1 || options.level > 9) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument,
+            "Invalid compression options (chunkSectors " + std::to_string(options.chunkSectors)
+            + ", level " + std::to_string(options.level) + ")");
+    }
+
+    std::ofstream out(dest, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return LIBCUEBIN_ERROR(ErrorCode::FileNotFound, "Cannot create file: " + dest.string());
+    }
+
+    auto chunkBytes = static_cast<uint32_t>(options.chunkSectors) * RAW_SECTOR_SIZE;
+    auto chunkCount = static_cast<uint32_t>((static_cast<uint64_t>(size) + chunkBytes - 1) / chunkBytes);
+
+    CompressStats stats;
+    stats.inputBytes = static_cast<uint64_t>(size);
+    stats.chunks = chunkCount;
+
+    // Header is rewritten once the index offset is known
+    uint8_t header[cbc::HEADER_SIZE] = {};
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    std::vector<uint8_t> index(static_cast<size_t>(chunkCount) * cbc::INDEX_ENTRY_SIZE);
+    std::vector<uint8_t> chunk(chunkBytes);
+    std::vector<uint8_t> delta(chunkBytes);
+    std::vector<uint8_t> packed;
+    std::vector<uint8_t> packedDelta;
+    uint64_t offset = cbc::HEADER_SIZE;
+
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        int64_t begin = static_cast<int64_t>(i) * chunkBytes;
+        auto length = static_cast<size_t>(std::min<int64_t>(chunkBytes, size - begin));
+        if (read(begin, chunk.data(), static_cast<int64_t>(length)) != static_cast<int64_t>(length)) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
+                "Read failed at offset " + std::to_string(begin) + " while compressing to " + dest.string());
+        }
+        std::span<const uint8_t> bytes(chunk.data(), length);
+
+        ChunkCodec codec = ChunkCodec::Stored;
+        const uint8_t* payload = chunk.data();
+        size_t payloadSize = length;
+
+        if (std::all_of(bytes.begin(), bytes.end(), [](uint8_t b) { return b == 0; })) {
+            codec = ChunkCodec::Zero;
+            payloadSize = 0;
+        } else {
+            if (!deflateInto(chunk.data(), length, options.level, packed)) {
+                return LIBCUEBIN_ERROR(ErrorCode::FileReadError, "zlib compression failed");
+            }
+            if (packed.size() < payloadSize) {
+                codec = ChunkCodec::Deflate;
+                payload = packed.data();
+                payloadSize = packed.size();
+            }
+
+            int64_t end = begin + static_cast<int64_t>(length);
+            bool isAudio = std::any_of(audio.begin(), audio.end(),
+                [&](const ByteExtent& e) { return e.begin <= begin && end <= e.end; });
+            if (isAudio) {
+                std::memcpy(delta.data(), chunk.data(), length);
+                deltaEncodeSamples(delta.data(), length);
+                if (!deflateInto(delta.data(), length, options.level, packedDelta)) {
+                    return LIBCUEBIN_ERROR(ErrorCode::FileReadError, "zlib compression failed");
+                }
+                if (packedDelta.size() < payloadSize) {
+                    codec = ChunkCodec::DeltaDeflate;
+                    payload = packedDelta.data();
+                    payloadSize = packedDelta.size();
+                }
+            }
+        }
+
+        out.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(payloadSize));
+
+        uint8_t* e = index.data() + static_cast<size_t>(i) * cbc::INDEX_ENTRY_SIZE;
+        put64(e, offset);
+        put32(e + 8, static_cast<uint32_t>(payloadSize));
+        put32(e + 12, crc32(bytes));
+        e[16] = static_cast<uint8_t>(codec);
+        offset += payloadSize;
+        stats.codecChunks[static_cast<size_t>(codec)]++;
+    }
+
+    out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+
+    std::memcpy(header, cbc::MAGIC, sizeof(cbc::MAGIC));
+    put32(header + 8, cbc::VERSION);
+    put32(header + 12, chunkBytes);
+    put64(header + 16, static_cast<uint64_t>(size));
+    put32(header + 24, chunkCount);
+    put64(header + 32, offset);
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.close();
+    if (!out) {
+        return LIBCUEBIN_ERROR(ErrorCode::FileReadError, "Write failed: " + dest.string());
+    }
+
+    stats.outputBytes = offset + index.size();
+    spdlog::info("Compressed {} bytes to {} ({} chunks)", stats.inputBytes, stats.outputBytes, stats.chunks);
+    return stats;
+}
+
+void addStats(CompressStats& total, const CompressStats& part)
+{
+    total.inputBytes += part.inputBytes;
+    total.outputBytes += part.outputBytes;
+    total.chunks += part.chunks;
+    for (size_t i = 0; i < std::size(total.codecChunks); ++i) total.codecChunks[i] += part.codecChunks[i];
+}
+
+} // anonymous namespace
+
+Result<CompressStats> compressFile(const std::filesystem::path& source,
+                                   const std::filesystem::path& dest,
+                                   std::span<const ByteExtent> audio,
+                                   const CompressOptions& options)
+{
+    RawFile file;
+    if (!file.open(source)) {
+        return LIBCUEBIN_ERROR(ErrorCode::FileNotFound, "Cannot open file: " + source.string());
+    }
+    std::error_code ec;
+    auto size = static_cast<int64_t>(std::filesystem::file_size(source, ec));
+    if (ec) {
+        return LIBCUEBIN_ERROR(ErrorCode::FileReadError, "Cannot get file size: " + source.string());
+    }
+
+    return compressSource([&](int64_t offset, uint8_t* dst, int64_t n) { return file.readAt(offset, dst, n); },
+                          size, dest, audio, options);
+}
+
+Result<CompressStats> compressDisc(const Disc& disc, const std::filesystem::path& cuePath,
+                                   const CompressOptions& options)
+{
+    const auto& impl = *disc.m_impl;
+    CueSheet sheet = impl.sheet;
+    std::filesystem::path outDir = cuePath.parent_path();
+    CompressStats total;
+
+    for (size_t fi = 0; fi < impl.fileHandles.size(); ++fi) {
+        const FileHandle& fh = *impl.fileHandles[fi];
+        auto type = sheet.files[fi].type;
+        if (type != FileType::Binary && type != FileType::Motorola) {
+            return LIBCUEBIN_ERROR(ErrorCode::Unsupported,
+                "Cannot compress " + std::string(fileTypeToString(type)) + " file: " + fh.path.string());
+        }
+        if (!fh.ensureOpen()) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileReadError, "Cannot open file: " + fh.path.string());
+        }
+
+        std::vector<ByteExtent> audio;
+        for (const auto& extent : impl.trackExtents(fi)) {
+            if (extent.track->isAudio()) audio.push_back({extent.begin, extent.end});
+        }
+
+        // Reading through the handle also re-chunks images that are already compressed
+        sheet.files[fi].filename += ".cbc";
+        std::filesystem::path dest = outDir / sheet.files[fi].filename;
+        std::error_code ec;
+        std::filesystem::create_directories(dest.parent_path(), ec);
+        auto stats = compressSource(
+            [&](int64_t offset, uint8_t* dst, int64_t n) { return fh.readUncached(offset, dst, n); },
+            fh.fileSize, dest, audio, options);
+        if (!stats) return stats.error();
+        addStats(total, *stats);
+    }
+
+    if (auto status = CueWriter::writeFile(sheet, cuePath); !status) {
+        return LIBCUEBIN_ERROR(status.code(), "Cannot write CUE sheet: " + cuePath.string());
+    }
+    return total;
+}
+
+} // namespace cuebin
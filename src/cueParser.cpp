@@ -1,35 +1,33 @@
 #include "libcuebin/cueParser.hpp"
 
-#include <algorithm>
-#include <cctype>
+#include "rawFile.hpp"
+#include "traceInternal.hpp"
+#include "stringUtil.hpp"
+
 #include <charconv>
-#include <fstream>
-#include <sstream>
+#include <cstring>
 
 #include <spdlog/spdlog.h>
 
 namespace cuebin {
 
-std::string_view trim(std::string_view sv)
+namespace {
+
+bool isSpace(char c) noexcept
 {
-    while (!sv.empty() && std::isspace(static_cast<unsigned char>(sv.front())))
-        sv.remove_prefix(1);
-    while (!sv.empty() && std::isspace(static_cast<unsigned char>(sv.back())))
-        sv.remove_suffix(1);
-    return sv;
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
 }
 
-std::string toUpper(std::string_view sv)
+std::string_view trim(std::string_view sv) noexcept
 {
-    std::string s(sv);
-    std::transform(s.begin(), s.end(), s.begin(),
-                   [](unsigned char c) { return std::toupper(c); });
-    return s;
+    while (!sv.empty() && isSpace(sv.front())) sv.remove_prefix(1);
+    while (!sv.empty() && isSpace(sv.back())) sv.remove_suffix(1);
+    return sv;
 }
 
 // Extract the next token from the line, handling quoted strings.
 // Advances `line` past the consumed token.
-std::string nextToken(std::string_view& line)
+std::string_view nextToken(std::string_view& line) noexcept
 {
     line = trim(line);
     if (line.empty()) return {};
@@ -38,49 +36,97 @@ std::string nextToken(std::string_view& line)
         auto end = line.find('"', 1);
         if (end == std::string_view::npos) {
             // Unterminated quote -- take rest of line
-            std::string tok(line.substr(1));
+            std::string_view tok = line.substr(1);
             line = {};
             return tok;
         }
-        std::string tok(line.substr(1, end - 1));
+        std::string_view tok = line.substr(1, end - 1);
         line.remove_prefix(end + 1);
         return tok;
     }
 
     auto end = line.find_first_of(" \t");
     if (end == std::string_view::npos) {
-        std::string tok(line);
+        std::string_view tok = line;
         line = {};
         return tok;
     }
-    std::string tok(line.substr(0, end));
+    std::string_view tok = line.substr(0, end);
     line.remove_prefix(end);
     return tok;
 }
 
 // Consume the rest of the line as a single token (for quoted values after a keyword).
-std::string restAsString(std::string_view& line)
+std::string_view restOfLine(std::string_view& line) noexcept
 {
     line = trim(line);
-    if (line.empty()) return {};
-
-    if (line.front() == '"') {
-        auto end = line.find('"', 1);
-        if (end == std::string_view::npos) {
-            std::string s(line.substr(1));
-            line = {};
-            return s;
-        }
-        std::string s(line.substr(1, end - 1));
-        line.remove_prefix(end + 1);
-        return s;
-    }
+    if (line.empty() || line.front() == '"') return nextToken(line);
 
-    std::string s(line);
+    std::string_view s = line;
     line = {};
     return s;
 }
 
+enum class Keyword {
+    Unknown,
+    File,
+    Track,
+    Index,
+    Pregap,
+    Postgap,
+    Flags,
+    Isrc,
+    Catalog,
+    CdTextFile,
+    Title,
+    Performer,
+    Songwriter,
+    Rem,
+};
+
+// Dispatches on length and first letter, so each keyword costs at most
+// one case-insensitive comparison
+Keyword classify(std::string_view tok) noexcept
+{
+    if (tok.empty()) return Keyword::Unknown;
+    char first = static_cast<char>(tok.front() & ~0x20);
+    auto is = [&](std::string_view upper, Keyword k) {
+        return equalsIgnoreCase(tok, upper) ? k : Keyword::Unknown;
+    };
+
+    switch (tok.size()) {
+        case 3:
+            return first == 'R' ? is("REM", Keyword::Rem) : Keyword::Unknown;
+        case 4:
+            if (first == 'F') return is("FILE", Keyword::File);
+            if (first == 'I') return is("ISRC", Keyword::Isrc);
+            break;
+        case 5:
+            if (first == 'T') {
+                return (tok[1] & ~0x20) == 'R' ? is("TRACK", Keyword::Track)
+                                                : is("TITLE", Keyword::Title);
+            }
+            if (first == 'I') return is("INDEX", Keyword::Index);
+            if (first == 'F') return is("FLAGS", Keyword::Flags);
+            break;
+        case 6:
+            return first == 'P' ? is("PREGAP", Keyword::Pregap) : Keyword::Unknown;
+        case 7:
+            if (first == 'P') return is("POSTGAP", Keyword::Postgap);
+            if (first == 'C') return is("CATALOG", Keyword::Catalog);
+            break;
+        case 9:
+            return first == 'P' ? is("PERFORMER", Keyword::Performer) : Keyword::Unknown;
+        case 10:
+            if (first == 'S') return is("SONGWRITER", Keyword::Songwriter);
+            if (first == 'C') return is("CDTEXTFILE", Keyword::CdTextFile);
+            break;
+        default:
+            break;
+    }
+    return Keyword::Unknown;
+}
+
 Result<uint8_t> parseUint8(std::string_view sv)
 {
     uint8_t val = 0;
@@ -96,50 +142,81 @@ uint8_t parseFlags(std::string_view line)
 {
     uint8_t flags = 0;
     while (!line.empty()) {
-        auto tok = toUpper(nextToken(line));
-        if (tok == "DCP")       flags |= static_cast<uint8_t>(TrackFlag::DCP);
-        else if (tok == "4CH")  flags |= static_cast<uint8_t>(TrackFlag::CH4);
-        else if (tok == "PRE")  flags |= static_cast<uint8_t>(TrackFlag::PRE);
-        else if (tok == "SCMS") flags |= static_cast<uint8_t>(TrackFlag::SCMS);
+        auto tok = nextToken(line);
+        if (tok.empty()) break;
+        if (equalsIgnoreCase(tok, "DCP"))       flags |= static_cast<uint8_t>(TrackFlag::DCP);
+        else if (equalsIgnoreCase(tok, "4CH"))  flags |= static_cast<uint8_t>(TrackFlag::CH4);
+        else if (equalsIgnoreCase(tok, "PRE"))  flags |= static_cast<uint8_t>(TrackFlag::PRE);
+        else if (equalsIgnoreCase(tok, "SCMS")) flags |= static_cast<uint8_t>(TrackFlag::SCMS);
         else spdlog::warn("Unknown track flag: '{}'", tok);
     }
     return flags;
 }
 
-Result<CueSheet> CueParser::parseFile(const std::filesystem::path& path)
+// CueParser::parseFile() between its trace points
+Result<CueSheet> readAndParse(const std::filesystem::path& path,
+                              std::pmr::memory_resource* resource)
 {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    // One read of the whole sheet into a buffer of its exact size
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    RawFile file;
+    if (ec || !file.open(path)) {
         return LIBCUEBIN_ERROR(ErrorCode::FileNotFound,
             "Cannot open CUE file: " + path.string());
     }
 
-    std::ostringstream ss;
-    ss << file.rdbuf();
-    return parseString(ss.str());
+    std::string content(size, '\0');
+    int64_t got = file.readAt(0, reinterpret_cast<uint8_t*>(content.data()), static_cast<int64_t>(size));
+    if (got < 0) {
+        return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
+            "Cannot read CUE file: " + path.string());
+    }
+    content.resize(static_cast<size_t>(got));
+    return CueParser::parseString(content, resource);
+}
+
+} // anonymous namespace
+
+Result<CueSheet> CueParser::parseFile(const std::filesystem::path& path,
+                                      std::pmr::memory_resource* resource)
+{
+    LIBCUEBIN_TRACE(parseBegin, path);
+    auto sheet = readAndParse(path, resource);
+    LIBCUEBIN_TRACE(parseEnd, path, sheet);
+    return sheet;
 }
 
-Result<CueSheet> CueParser::parseString(std::string_view content)
+Result<CueSheet> CueParser::parseString(std::string_view content,
+                                        std::pmr::memory_resource* resource)
 {
-    CueSheet sheet;
+    CueAllocator alloc(resource);
+    CueSheet sheet(alloc);
     CueFile* currentFile = nullptr;
     CueTrack* currentTrack = nullptr;
     int lineNum = 0;
 
-    std::istringstream stream{std::string(content)};
-    std::string lineBuf;
+    // Single pass over the input: lines are split with memchr and every
+    // token is a view into `content`; only the values stored in the sheet
+    // are copied out
+    const char* pos = content.data();
+    const char* end = pos + content.size();
 
-    while (std::getline(stream, lineBuf)) {
+    while (pos < end) {
+        const char* eol = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+        if (!eol) eol = end;
+        std::string_view line = trim(std::string_view(pos, static_cast<size_t>(eol - pos)));
+        pos = eol + 1;
         ++lineNum;
-        std::string_view line = trim(lineBuf);
         if (line.empty()) continue;
 
         std::string_view remaining = line;
-        std::string keyword = toUpper(nextToken(remaining));
+        std::string_view keyword = nextToken(remaining);
 
-        if (keyword == "FILE") {
-            std::string filename = nextToken(remaining);
-            std::string typeStr = nextToken(remaining);
+        switch (classify(keyword)) {
+        case Keyword::File: {
+            std::string_view filename = nextToken(remaining);
+            std::string_view typeStr = nextToken(remaining);
             if (filename.empty() || typeStr.empty()) {
                 return LIBCUEBIN_ERROR(ErrorCode::InvalidCueFormat,
                     "FILE directive missing filename or type at line " + std::to_string(lineNum));
@@ -149,17 +226,18 @@ Result<CueSheet> CueParser::parseString(std::string_view content)
 
             sheet.files.emplace_back();
             currentFile = &sheet.files.back();
-            currentFile->filename = std::move(filename);
+            currentFile->filename = filename;
             currentFile->type = *fileType;
             currentTrack = nullptr;
+            break;
         }
-        else if (keyword == "TRACK") {
+        case Keyword::Track: {
             if (!currentFile) {
                 return LIBCUEBIN_ERROR(ErrorCode::UnexpectedDirective,
                     "TRACK before FILE at line " + std::to_string(lineNum));
             }
-            std::string numStr = nextToken(remaining);
-            std::string modeStr = nextToken(remaining);
+            std::string_view numStr = nextToken(remaining);
+            std::string_view modeStr = nextToken(remaining);
             if (numStr.empty() || modeStr.empty()) {
                 return LIBCUEBIN_ERROR(ErrorCode::InvalidCueFormat,
                     "TRACK directive missing number or mode at line " + std::to_string(lineNum));
@@ -173,14 +251,15 @@ Result<CueSheet> CueParser::parseString(std::string_view content)
             currentTrack = &currentFile->tracks.back();
             currentTrack->number = *num;
             currentTrack->mode = *mode;
+            break;
         }
-        else if (keyword == "INDEX") {
+        case Keyword::Index: {
             if (!currentTrack) {
                 return LIBCUEBIN_ERROR(ErrorCode::UnexpectedDirective,
                     "INDEX before TRACK at line " + std::to_string(lineNum));
             }
-            std::string numStr = nextToken(remaining);
-            std::string msfStr = nextToken(remaining);
+            std::string_view numStr = nextToken(remaining);
+            std::string_view msfStr = nextToken(remaining);
             if (numStr.empty() || msfStr.empty()) {
                 return LIBCUEBIN_ERROR(ErrorCode::InvalidCueFormat,
                     "INDEX directive missing number or position at line " + std::to_string(lineNum));
@@ -199,76 +278,65 @@ Result<CueSheet> CueParser::parseString(std::string_view content)
             }
 
             currentTrack->indices.push_back({*num, *msf});
+            break;
         }
-        else if (keyword == "PREGAP") {
+        case Keyword::Pregap: {
             if (!currentTrack) {
                 return LIBCUEBIN_ERROR(ErrorCode::UnexpectedDirective,
                     "PREGAP before TRACK at line " + std::to_string(lineNum));
             }
-            std::string msfStr = nextToken(remaining);
-            auto msf = MSF::parse(msfStr);
+            auto msf = MSF::parse(nextToken(remaining));
             if (!msf) return msf.error();
             currentTrack->pregap = *msf;
+            break;
         }
-        else if (keyword == "POSTGAP") {
+        case Keyword::Postgap: {
             if (!currentTrack) {
                 return LIBCUEBIN_ERROR(ErrorCode::UnexpectedDirective,
                     "POSTGAP before TRACK at line " + std::to_string(lineNum));
             }
-            std::string msfStr = nextToken(remaining);
-            auto msf = MSF::parse(msfStr);
+            auto msf = MSF::parse(nextToken(remaining));
             if (!msf) return msf.error();
             currentTrack->postgap = *msf;
+            break;
         }
-        else if (keyword == "FLAGS") {
+        case Keyword::Flags:
             if (!currentTrack) {
                 return LIBCUEBIN_ERROR(ErrorCode::UnexpectedDirective,
                     "FLAGS before TRACK at line " + std::to_string(lineNum));
             }
             currentTrack->flags = parseFlags(remaining);
-        }
-        else if (keyword == "ISRC") {
+            break;
+        case Keyword::Isrc:
             if (!currentTrack) {
                 return LIBCUEBIN_ERROR(ErrorCode::UnexpectedDirective,
                     "ISRC before TRACK at line " + std::to_string(lineNum));
             }
-            currentTrack->isrc = nextToken(remaining);
-        }
-        else if (keyword == "CATALOG") {
-            sheet.catalog = nextToken(remaining);
-        }
-        else if (keyword == "CDTEXTFILE") {
-            sheet.cdtextfile = restAsString(remaining);
-        }
-        else if (keyword == "TITLE") {
-            std::string val = restAsString(remaining);
-            if (currentTrack) {
-                currentTrack->title = std::move(val);
-            } else {
-                sheet.title = std::move(val);
-            }
-        }
-        else if (keyword == "PERFORMER") {
-            std::string val = restAsString(remaining);
-            if (currentTrack) {
-                currentTrack->performer = std::move(val);
-            } else {
-                sheet.performer = std::move(val);
-            }
-        }
-        else if (keyword == "SONGWRITER") {
-            std::string val = restAsString(remaining);
-            if (currentTrack) {
-                currentTrack->songwriter = std::move(val);
-            } else {
-                sheet.songwriter = std::move(val);
-            }
-        }
-        else if (keyword == "REM") {
+            assignString(currentTrack->isrc, nextToken(remaining), alloc);
+            break;
+        case Keyword::Catalog:
+            assignString(sheet.catalog, nextToken(remaining), alloc);
+            break;
+        case Keyword::CdTextFile:
+            assignString(sheet.cdtextfile, restOfLine(remaining), alloc);
+            break;
+        case Keyword::Title:
+            assignString(currentTrack ? currentTrack->title : sheet.title, restOfLine(remaining), alloc);
+            break;
+        case Keyword::Performer:
+            assignString(currentTrack ? currentTrack->performer : sheet.performer,
+                         restOfLine(remaining), alloc);
+            break;
+        case Keyword::Songwriter:
+            assignString(currentTrack ? currentTrack->songwriter : sheet.songwriter,
+                         restOfLine(remaining), alloc);
+            break;
+        case Keyword::Rem:
             sheet.remarks.emplace_back(remaining);
-        }
-        else {
+            break;
+        case Keyword::Unknown:
             spdlog::debug("Skipping unknown CUE directive '{}' at line {}", keyword, lineNum);
+            break;
         }
     }
 
@@ -1,9 +1,86 @@
 #include "libcuebin/cueTypes.hpp"
 
-#include <algorithm>
+#include "stringUtil.hpp"
 
 namespace cuebin {
 
+namespace {
+
+std::optional<std::pmr::string> copyString(const std::optional<std::pmr::string>& s,
+                                           const CueAllocator& alloc)
+{
+    if (!s) return std::nullopt;
+    return std::pmr::string(*s, alloc);
+}
+
+// Steals the buffer when `alloc` uses the same resource, copies otherwise
+std::optional<std::pmr::string> moveString(std::optional<std::pmr::string>& s,
+                                           const CueAllocator& alloc)
+{
+    if (!s) return std::nullopt;
+    return std::pmr::string(std::move(*s), alloc);
+}
+
+} // anonymous namespace
+
+CueTrack::CueTrack(const CueTrack& other, const allocator_type& alloc)
+    : number(other.number)
+    , mode(other.mode)
+    , indices(other.indices, alloc)
+    , pregap(other.pregap)
+    , postgap(other.postgap)
+    , flags(other.flags)
+    , isrc(copyString(other.isrc, alloc))
+    , title(copyString(other.title, alloc))
+    , performer(copyString(other.performer, alloc))
+    , songwriter(copyString(other.songwriter, alloc))
+{}
+
+CueTrack::CueTrack(CueTrack&& other, const allocator_type& alloc)
+    : number(other.number)
+    , mode(other.mode)
+    , indices(std::move(other.indices), alloc)
+    , pregap(other.pregap)
+    , postgap(other.postgap)
+    , flags(other.flags)
+    , isrc(moveString(other.isrc, alloc))
+    , title(moveString(other.title, alloc))
+    , performer(moveString(other.performer, alloc))
+    , songwriter(moveString(other.songwriter, alloc))
+{}
+
+CueFile::CueFile(const CueFile& other, const allocator_type& alloc)
+    : filename(other.filename, alloc)
+    , type(other.type)
+    , tracks(other.tracks, alloc)
+{}
+
+CueFile::CueFile(CueFile&& other, const allocator_type& alloc)
+    : filename(std::move(other.filename), alloc)
+    , type(other.type)
+    , tracks(std::move(other.tracks), alloc)
+{}
+
+CueSheet::CueSheet(const CueSheet& other, const allocator_type& alloc)
+    : files(other.files, alloc)
+    , catalog(copyString(other.catalog, alloc))
+    , cdtextfile(copyString(other.cdtextfile, alloc))
+    , title(copyString(other.title, alloc))
+    , performer(copyString(other.performer, alloc))
+    , songwriter(copyString(other.songwriter, alloc))
+    , remarks(other.remarks, alloc)
+{}
+
+CueSheet::CueSheet(CueSheet&& other, const allocator_type& alloc)
+    : files(std::move(other.files), alloc)
+    , catalog(moveString(other.catalog, alloc))
+    , cdtextfile(moveString(other.cdtextfile, alloc))
+    , title(moveString(other.title, alloc))
+    , performer(moveString(other.performer, alloc))
+    , songwriter(moveString(other.songwriter, alloc))
+    , remarks(std::move(other.remarks), alloc)
+{}
+
 uint16_t sectorSizeForMode(TrackMode mode) noexcept
 {
     switch (mode) {
@@ -21,18 +98,26 @@ uint16_t sectorSizeForMode(TrackMode mode) noexcept
 
 Result<TrackMode> parseTrackMode(std::string_view str)
 {
-    // Uppercase comparison
-    std::string upper(str);
-    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
-
-    if (upper == "AUDIO")      return TrackMode::Audio;
-    if (upper == "CDG")        return TrackMode::CDG;
-    if (upper == "MODE1/2048") return TrackMode::Mode1_2048;
-    if (upper == "MODE1/2352") return TrackMode::Mode1_2352;
-    if (upper == "MODE2/2336") return TrackMode::Mode2_2336;
-    if (upper == "MODE2/2352") return TrackMode::Mode2_2352;
-    if (upper == "CDI/2336")   return TrackMode::CDI_2336;
-    if (upper == "CDI/2352")   return TrackMode::CDI_2352;
+    switch (str.size()) {
+        case 3:
+            if (equalsIgnoreCase(str, "CDG")) return TrackMode::CDG;
+            break;
+        case 5:
+            if (equalsIgnoreCase(str, "AUDIO")) return TrackMode::Audio;
+            break;
+        case 8:
+            if (equalsIgnoreCase(str, "CDI/2336")) return TrackMode::CDI_2336;
+            if (equalsIgnoreCase(str, "CDI/2352")) return TrackMode::CDI_2352;
+            break;
+        case 10:
+            if (equalsIgnoreCase(str, "MODE1/2048")) return TrackMode::Mode1_2048;
+            if (equalsIgnoreCase(str, "MODE1/2352")) return TrackMode::Mode1_2352;
+            if (equalsIgnoreCase(str, "MODE2/2336")) return TrackMode::Mode2_2336;
+            if (equalsIgnoreCase(str, "MODE2/2352")) return TrackMode::Mode2_2352;
+            break;
+        default:
+            break;
+    }
 
     return LIBCUEBIN_ERROR(ErrorCode::InvalidTrackMode,
         "Unknown track mode: '" + std::string(str) + "'");
@@ -40,14 +125,11 @@ Result<TrackMode> parseTrackMode(std::string_view str)
 
 Result<FileType> parseFileType(std::string_view str)
 {
-    std::string upper(str);
-    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
-
-    if (upper == "BINARY")   return FileType::Binary;
-    if (upper == "MOTOROLA") return FileType::Motorola;
-    if (upper == "AIFF")     return FileType::Aiff;
-    if (upper == "WAVE")     return FileType::Wave;
-    if (upper == "MP3")      return FileType::MP3;
+    if (equalsIgnoreCase(str, "BINARY"))   return FileType::Binary;
+    if (equalsIgnoreCase(str, "MOTOROLA")) return FileType::Motorola;
+    if (equalsIgnoreCase(str, "AIFF"))     return FileType::Aiff;
+    if (equalsIgnoreCase(str, "WAVE"))     return FileType::Wave;
+    if (equalsIgnoreCase(str, "MP3"))      return FileType::MP3;
 
     return LIBCUEBIN_ERROR(ErrorCode::InvalidFileType,
         "Unknown file type: '" + std::string(str) + "'");
@@ -0,0 +1,79 @@
+#include "libcuebin/cueWriter.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace cuebin {
+
+namespace {
+
+std::string quote(std::string_view value)
+{
+    std::string out;
+    out.reserve(value.size() + 2);
+    out += '"';
+    out += value;
+    out += '"';
+    return out;
+}
+
+std::string flagsToString(uint8_t flags)
+{
+    std::string out;
+    auto add = [&](TrackFlag flag, const char* name) {
+        if (!(flags & static_cast<uint8_t>(flag))) return;
+        if (!out.empty()) out += ' ';
+        out += name;
+    };
+    add(TrackFlag::DCP, "DCP");
+    add(TrackFlag::CH4, "4CH");
+    add(TrackFlag::PRE, "PRE");
+    add(TrackFlag::SCMS, "SCMS");
+    return out;
+}
+
+} // anonymous namespace
+
+std::string CueWriter::toString(const CueSheet& sheet)
+{
+    std::ostringstream out;
+    // Remarks keep the whitespace that followed REM
+    for (const auto& rem : sheet.remarks) out << "REM" << (rem.empty() || rem[0] == ' ' ? "" : " ") << rem << '\n';
+    if (sheet.catalog) out << "CATALOG " << *sheet.catalog << '\n';
+    if (sheet.cdtextfile) out << "CDTEXTFILE " << quote(*sheet.cdtextfile) << '\n';
+    if (sheet.title) out << "TITLE " << quote(*sheet.title) << '\n';
+    if (sheet.performer) out << "PERFORMER " << quote(*sheet.performer) << '\n';
+    if (sheet.songwriter) out << "SONGWRITER " << quote(*sheet.songwriter) << '\n';
+
+    for (const auto& file : sheet.files) {
+        out << "FILE " << quote(file.filename) << ' ' << fileTypeToString(file.type) << '\n';
+        for (const auto& track : file.tracks) {
+            out << "  TRACK " << (track.number < 10 ? "0" : "") << static_cast<int>(track.number)
+                << ' ' << trackModeToString(track.mode) << '\n';
+            if (track.flags) out << "    FLAGS " << flagsToString(track.flags) << '\n';
+            if (track.isrc) out << "    ISRC " << *track.isrc << '\n';
+            if (track.title) out << "    TITLE " << quote(*track.title) << '\n';
+            if (track.performer) out << "    PERFORMER " << quote(*track.performer) << '\n';
+            if (track.songwriter) out << "    SONGWRITER " << quote(*track.songwriter) << '\n';
+            if (track.pregap) out << "    PREGAP " << track.pregap->toString() << '\n';
+            for (const auto& idx : track.indices) {
+                out << "    INDEX " << (idx.number < 10 ? "0" : "") << static_cast<int>(idx.number)
+                    << ' ' << idx.position.toString() << '\n';
+            }
+            if (track.postgap) out << "    POSTGAP " << track.postgap->toString() << '\n';
+        }
+    }
+    return out.str();
+}
+
+Status CueWriter::writeFile(const CueSheet& sheet, const std::filesystem::path& path)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return ErrorCode::FileNotFound;
+    file << toString(sheet);
+    file.close();
+    if (!file) return ErrorCode::FileReadError;
+    return {};
+}
+
+} // namespace cuebin
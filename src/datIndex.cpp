@@ -0,0 +1,295 @@
+#include "libcuebin/datIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace cuebin {
+
+namespace {
+
+struct XmlTag {
+    std::string_view name;
+    std::vector<std::pair<std::string_view, std::string>> attributes;
+    bool closing = false;     // </name>
+    bool selfClosing = false; // <name ... />
+
+    const std::string* attribute(std::string_view key) const
+    {
+        for (const auto& [k, v] : attributes) {
+            if (k == key) return &v;
+        }
+        return nullptr;
+    }
+};
+
+std::string decodeEntities(std::string_view text)
+{
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '&') {
+            out += text[i];
+            continue;
+        }
+        size_t semi = text.find(';', i);
+        if (semi == std::string_view::npos) {
+            out += text[i];
+            continue;
+        }
+        std::string_view entity = text.substr(i + 1, semi - i - 1);
+        if (entity == "amp") out += '&';
+        else if (entity == "lt") out += '<';
+        else if (entity == "gt") out += '>';
+        else if (entity == "quot") out += '"';
+        else if (entity == "apos") out += '\'';
+        else if (entity.size() > 1 && entity[0] == '#') {
+            bool hex = entity[1] == 'x' || entity[1] == 'X';
+            std::string_view digits = entity.substr(hex ? 2 : 1);
+            uint32_t cp = 0;
+            auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), cp, hex ? 16 : 10);
+            if (ec != std::errc() || ptr != digits.data() + digits.size()) {
+                out.append(text.substr(i, semi - i + 1));
+            } else if (cp < 0x80) {
+                out += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        } else {
+            out.append(text.substr(i, semi - i + 1));
+        }
+        i = semi;
+    }
+    return out;
+}
+
+std::string toLowerHex(std::string_view hex)
+{
+    std::string out(hex);
+    for (auto& c : out) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return out;
+}
+
+bool isCueSheet(const DatRom& rom)
+{
+    std::string_view name = rom.name;
+    if (name.size() < 4) return false;
+    std::string_view ext = name.substr(name.size() - 4);
+    return ext[0] == '.' && (ext[1] | 0x20) == 'c' && (ext[2] | 0x20) == 'u' && (ext[3] | 0x20) == 'e';
+}
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Parses the tag starting at xml[pos] == '<'. Comments, processing
+// instructions and DOCTYPE come back with an empty name.
+Result<XmlTag> parseTag(std::string_view xml, size_t& pos)
+{
+    XmlTag tag;
+    auto fail = [&](const char* what) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidDatFormat,
+            std::string(what) + " at offset " + std::to_string(pos));
+    };
+
+    if (xml.substr(pos, 4) == "<!--") {
+        size_t end = xml.find("-->", pos + 4);
+        if (end == std::string_view::npos) return fail("Unterminated comment");
+        pos = end + 3;
+        return tag;
+    }
+    if (xml.substr(pos, 2) == "<?" || xml.substr(pos, 2) == "<!") {
+        size_t end = xml.find('>', pos);
+        if (end == std::string_view::npos) return fail("Unterminated declaration");
+        pos = end + 1;
+        return tag;
+    }
+
+    size_t i = pos + 1;
+    if (i < xml.size() && xml[i] == '/') {
+        tag.closing = true;
+        ++i;
+    }
+    size_t nameStart = i;
+    while (i < xml.size() && !isSpace(xml[i]) && xml[i] != '>' && xml[i] != '/') ++i;
+    tag.name = xml.substr(nameStart, i - nameStart);
+    if (tag.name.empty()) return fail("Missing tag name");
+
+    while (true) {
+        while (i < xml.size() && isSpace(xml[i])) ++i;
+        if (i >= xml.size()) return fail("Unterminated tag");
+        if (xml[i] == '>') {
+            ++i;
+            break;
+        }
+        if (xml[i] == '/' && i + 1 < xml.size() && xml[i + 1] == '>') {
+            tag.selfClosing = true;
+            i += 2;
+            break;
+        }
+
+        size_t keyStart = i;
+        while (i < xml.size() && xml[i] != '=' && !isSpace(xml[i]) && xml[i] != '>') ++i;
+        std::string_view key = xml.substr(keyStart, i - keyStart);
+        while (i < xml.size() && isSpace(xml[i])) ++i;
+        if (i >= xml.size() || xml[i] != '=') return fail("Expected '=' after attribute");
+        ++i;
+        while (i < xml.size() && isSpace(xml[i])) ++i;
+        if (i >= xml.size() || (xml[i] != '"' && xml[i] != '\'')) return fail("Expected quoted attribute value");
+        char quote = xml[i++];
+        size_t valueEnd = xml.find(quote, i);
+        if (valueEnd == std::string_view::npos) return fail("Unterminated attribute value");
+        tag.attributes.emplace_back(key, decodeEntities(xml.substr(i, valueEnd - i)));
+        i = valueEnd + 1;
+    }
+
+    pos = i;
+    return tag;
+}
+
+} // anonymous namespace
+
+Result<DatIndex> DatIndex::parse(std::string_view xml)
+{
+    DatIndex index;
+    DatGame* game = nullptr;
+
+    size_t pos = 0;
+    while ((pos = xml.find('<', pos)) != std::string_view::npos) {
+        auto tag = parseTag(xml, pos);
+        if (!tag) return tag.error();
+        if (tag->name.empty()) continue;
+
+        // Redump uses <game>; MAME-style DATs use <machine>
+        bool isGame = tag->name == "game" || tag->name == "machine";
+        if (isGame && tag->closing) {
+            game = nullptr;
+        } else if (isGame) {
+            const std::string* name = tag->attribute("name");
+            if (!name) {
+                return LIBCUEBIN_ERROR(ErrorCode::InvalidDatFormat,
+                    "Game without a name at offset " + std::to_string(pos));
+            }
+            index.m_games.push_back({*name, {}});
+            game = tag->selfClosing ? nullptr : &index.m_games.back();
+        } else if (tag->name == "rom" && !tag->closing && game) {
+            DatRom rom;
+            if (const auto* v = tag->attribute("name")) rom.name = *v;
+            if (const auto* v = tag->attribute("size")) {
+                auto [ptr, ec] = std::from_chars(v->data(), v->data() + v->size(), rom.size);
+                if (ec != std::errc() || ptr != v->data() + v->size()) {
+                    return LIBCUEBIN_ERROR(ErrorCode::InvalidDatFormat,
+                        "Invalid ROM size '" + *v + "' in game " + game->name);
+                }
+            }
+            if (const auto* v = tag->attribute("crc")) rom.crc32 = toLowerHex(*v);
+            if (const auto* v = tag->attribute("md5")) rom.md5 = toLowerHex(*v);
+            if (const auto* v = tag->attribute("sha1")) rom.sha1 = toLowerHex(*v);
+            game->roms.push_back(std::move(rom));
+        }
+    }
+
+    index.buildIndex();
+    return index;
+}
+
+Result<DatIndex> DatIndex::load(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return LIBCUEBIN_ERROR(ErrorCode::FileNotFound,
+            "Cannot open DAT file: " + path.string());
+    }
+
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    return parse(ss.str());
+}
+
+void DatIndex::buildIndex()
+{
+    m_bySha1.clear();
+    m_bySizeCrc.clear();
+    for (uint32_t g = 0; g < m_games.size(); ++g) {
+        const auto& roms = m_games[g].roms;
+        for (uint32_t r = 0; r < roms.size(); ++r) {
+            if (!roms[r].sha1.empty()) {
+                m_bySha1.emplace(roms[r].sha1, Entry{g, r});
+            } else if (!roms[r].crc32.empty()) {
+                m_bySizeCrc.emplace(std::to_string(roms[r].size) + ":" + roms[r].crc32, Entry{g, r});
+            }
+        }
+    }
+}
+
+std::vector<DatIndex::Entry> DatIndex::lookup(const HashDigest& digest) const
+{
+    std::vector<Entry> entries;
+    auto collect = [&](const auto& map, const std::string& key) {
+        auto [first, last] = map.equal_range(key);
+        for (auto it = first; it != last; ++it) {
+            const DatRom& rom = m_games[it->second.game].roms[it->second.rom];
+            if (rom.size != digest.size) continue;
+            if (!rom.crc32.empty() && rom.crc32 != digest.crc32Hex()) continue;
+            if (!rom.md5.empty() && rom.md5 != digest.md5Hex()) continue;
+            entries.push_back(it->second);
+        }
+    };
+    collect(m_bySha1, digest.sha1Hex());
+    collect(m_bySizeCrc, std::to_string(digest.size) + ":" + digest.crc32Hex());
+    return entries;
+}
+
+std::vector<const DatRom*> DatIndex::find(const HashDigest& digest) const
+{
+    std::vector<const DatRom*> roms;
+    for (const auto& e : lookup(digest)) roms.push_back(&m_games[e.game].roms[e.rom]);
+    return roms;
+}
+
+std::vector<DatMatch> DatIndex::match(const DiscHashes& hashes) const
+{
+    // Each ROM counts once, whether it matched a file, a track or both
+    std::unordered_map<uint32_t, std::vector<bool>> seen;
+    auto visit = [&](const HashDigest& digest) {
+        for (const auto& e : lookup(digest)) {
+            auto& flags = seen[e.game];
+            flags.resize(m_games[e.game].roms.size());
+            flags[e.rom] = true;
+        }
+    };
+    for (const auto& f : hashes.files) visit(f.digest);
+    for (const auto& t : hashes.tracks) visit(t.digest);
+
+    std::vector<DatMatch> matches;
+    for (const auto& [g, flags] : seen) {
+        DatMatch m{&m_games[g]};
+        for (size_t r = 0; r < flags.size(); ++r) {
+            if (isCueSheet(m.game->roms[r])) continue;
+            ++m.requiredRoms;
+            if (flags[r]) ++m.matchedRoms;
+        }
+        matches.push_back(m);
+    }
+    std::sort(matches.begin(), matches.end(), [](const DatMatch& a, const DatMatch& b) {
+        if (a.complete() != b.complete()) return a.complete();
+        if (a.matchedRoms != b.matchedRoms) return a.matchedRoms > b.matchedRoms;
+        return a.game->name < b.game->name;
+    });
+    return matches;
+}
+
+} // namespace cuebin
@@ -1,77 +1,38 @@
 #include "libcuebin/disc.hpp"
 #include "libcuebin/cueParser.hpp"
+#include "libcuebin/ecc.hpp"
+
+#include "audioContainer.hpp"
+#include "blockCacheInternal.hpp"
+#include "byteSwap.hpp"
+#include "discImpl.hpp"
+#include "traceInternal.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
-#include <fstream>
-#include <mutex>
 
 #include <spdlog/spdlog.h>
 
 namespace cuebin {
 
-struct FileHandle {
-    std::filesystem::path path;
-    int64_t fileSize = 0;
-    mutable std::once_flag openFlag;
-    mutable std::ifstream stream;
-    mutable std::mutex mutex;
-};
-
-struct Disc::Impl {
-    CueSheet sheet;
-    std::filesystem::path baseDir;
-    std::vector<Track> tracks;
-    std::vector<std::unique_ptr<FileHandle>> fileHandles;
-    int32_t totalSectors = 0;
-
-    std::optional<std::string> title;
-    std::optional<std::string> performer;
-    std::optional<std::string> catalog;
-};
-
-Disc::Disc(std::unique_ptr<Impl> impl) : m_impl(std::move(impl)) {}
-Disc::~Disc() = default;
-Disc::Disc(Disc&& other) noexcept = default;
-Disc& Disc::operator=(Disc&& other) noexcept = default;
+// Upper bound on the staging buffer readSectors() fills per batch
+static constexpr int32_t MAX_RUN_BYTES = 4 * 1024 * 1024;
 
-Result<Disc> Disc::fromCue(const std::filesystem::path& cuePath)
+size_t sheetTrackCount(const CueSheet& sheet) noexcept
 {
-    auto sheetResult = CueParser::parseFile(cuePath);
-    if (!sheetResult) return sheetResult.error();
-
-    auto impl = std::make_unique<Impl>();
-    impl->sheet = std::move(*sheetResult);
-    impl->baseDir = cuePath.parent_path();
-
-    if (impl->sheet.title) impl->title = *impl->sheet.title;
-    if (impl->sheet.performer) impl->performer = *impl->sheet.performer;
-    if (impl->sheet.catalog) impl->catalog = *impl->sheet.catalog;
-
-    // Resolve file paths and get sizes
-    for (const auto& cueFile : impl->sheet.files) {
-        auto handle = std::make_unique<FileHandle>();
-        handle->path = impl->baseDir / cueFile.filename;
-
-        std::error_code ec;
-        if (!std::filesystem::exists(handle->path, ec)) {
-            return LIBCUEBIN_ERROR(ErrorCode::FileNotFound,
-                "BIN file not found: " + handle->path.string());
-        }
-        handle->fileSize = static_cast<int64_t>(std::filesystem::file_size(handle->path, ec));
-        if (ec) {
-            return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
-                "Cannot get file size: " + handle->path.string());
-        }
-
-        impl->fileHandles.push_back(std::move(handle));
-    }
+    size_t count = 0;
+    for (const auto& file : sheet.files) count += file.tracks.size();
+    return count;
+}
 
-    // Build tracks with LBA positions
+int32_t layoutTracks(const CueSheet& sheet, const std::vector<FileLayout>& files,
+                     TrackTable& tracks)
+{
     int32_t currentLba = 0;
 
-    for (size_t fi = 0; fi < impl->sheet.files.size(); ++fi) {
-        const auto& cueFile = impl->sheet.files[fi];
+    for (size_t fi = 0; fi < sheet.files.size(); ++fi) {
+        const auto& cueFile = sheet.files[fi];
 
         for (size_t ti = 0; ti < cueFile.tracks.size(); ++ti) {
             const auto& ct = cueFile.tracks[ti];
@@ -90,17 +51,11 @@ Result<Disc> Disc::fromCue(const std::filesystem::path& cuePath)
                 if (idx.number == 1) index01Offset = idx.position.toLba();
             }
 
-            // For the first track in a file, the byte offset starts at 0
-            // and the INDEX positions are relative to the file start.
-            // For subsequent tracks, positions are also file-relative.
-            int64_t trackFileByteOffset;
-
-            if (ti == 0) {
-                // First track in file: index positions are from file start
-                trackFileByteOffset = static_cast<int64_t>(index01Offset) * ss;
-            } else {
-                trackFileByteOffset = static_cast<int64_t>(index01Offset) * ss;
-            }
+            // INDEX positions are relative to the start of the file's sector
+            // data, which for WAVE/AIFF files follows the container header
+            const auto& layout = files[fi];
+            int64_t trackFileByteOffset = layout.dataOffset
+                                        + static_cast<int64_t>(index01Offset) * ss;
 
             // Calculate track length
             int32_t trackSectors;
@@ -115,7 +70,7 @@ Result<Disc> Disc::fromCue(const std::filesystem::path& cuePath)
                 trackSectors = nextStart - index01Offset;
             } else {
                 // Last track in file: use file size
-                int64_t remainingBytes = impl->fileHandles[fi]->fileSize
+                int64_t remainingBytes = layout.dataSize
                                         - static_cast<int64_t>(index01Offset) * ss;
                 trackSectors = static_cast<int32_t>(remainingBytes / ss);
             }
@@ -125,12 +80,11 @@ Result<Disc> Disc::fromCue(const std::filesystem::path& cuePath)
                 postgap = ct.postgap->toLba();
             }
 
-            impl->tracks.emplace_back(
+            tracks.emplace_back(
                 ct.number, ct.mode, ss,
                 currentLba, trackSectors,
                 pregap, postgap,
-                ct.indices,
-                ct.title, ct.performer, ct.isrc,
+                &ct,
                 fi, trackFileByteOffset,
                 currentLba
             );
@@ -139,7 +93,80 @@ Result<Disc> Disc::fromCue(const std::filesystem::path& cuePath)
         }
     }
 
-    impl->totalSectors = currentLba;
+    return currentLba;
+}
+
+void Disc::ImplDeleter::operator()(Impl* impl) const noexcept
+{
+    CueAllocator(impl->resource).delete_object(impl);
+}
+
+Disc::ImplPtr Disc::Impl::create(const DiscOptions& options)
+{
+    std::pmr::memory_resource* resource = options.memoryResource
+        ? options.memoryResource : std::pmr::get_default_resource();
+    return ImplPtr(CueAllocator(resource).new_object<Impl>(resource));
+}
+
+Disc::Disc(ImplPtr impl) : m_impl(std::move(impl)) {}
+Disc::~Disc() = default;
+Disc::Disc(Disc&& other) noexcept = default;
+Disc& Disc::operator=(Disc&& other) noexcept = default;
+
+Result<Disc> Disc::fromCue(const std::filesystem::path& cuePath, const DiscOptions& options)
+{
+    if (options.realTime && options.readAhead) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument,
+            "Read-ahead is not available in real-time mode");
+    }
+
+    ImplPtr impl;
+    if (!options.snapshotPath.empty()) {
+        impl = Impl::loadSnapshot(options.snapshotPath, cuePath, options);
+    }
+
+    if (!impl) {
+        auto parsed = Impl::fromCueSheet(cuePath, options);
+        if (!parsed) return parsed.error();
+        impl = std::move(*parsed);
+        if (!options.snapshotPath.empty() && !impl->writeSnapshot(options.snapshotPath)) {
+            spdlog::warn("Cannot write disc snapshot: {}", options.snapshotPath.string());
+        }
+    }
+
+    impl->rawSectors = options.rawSectors;
+    impl->realTime = options.realTime;
+    impl->buildExtents();
+    for (auto& handle : impl->fileHandles) {
+        handle->collectStats = options.ioStats;
+        if (options.realTime) {
+            // Nothing may be opened, cached or decompressed on the read path
+            if (handle->compressed) {
+                return LIBCUEBIN_ERROR(ErrorCode::Unsupported,
+                    "Compressed images are not available in real-time mode: " + handle->path.string());
+            }
+            if (handle->backend == IoBackend::Stream) handle->backend = IoBackend::Positional;
+            if (!handle->ensureOpen()) {
+                return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
+                    "Cannot open file: " + handle->path.string());
+            }
+            continue;
+        }
+        if (options.useBlockCache && options.ioBackend != IoBackend::Mmap && !handle->compressed) {
+            handle->useCache = true;
+            handle->cacheFileId = detail::blockCacheFileId(handle->path, handle->fileSize);
+        }
+    }
+    impl->loadSubchannel(cuePath);
+
+    if (options.readAhead) {
+        const Impl* raw = impl.get();
+        impl->readAhead = std::make_unique<ReadAhead>(
+            [raw](int32_t lba, int32_t count, uint8_t* out, TrackMode* modes) {
+                return raw->readDirect(lba, count, out, modes);
+            },
+            impl->totalSectors, options.readAheadMinSectors, options.readAheadMaxSectors);
+    }
 
     spdlog::info("Loaded CUE: {} tracks, {} total sectors",
                  impl->tracks.size(), impl->totalSectors);
@@ -147,6 +174,71 @@ Result<Disc> Disc::fromCue(const std::filesystem::path& cuePath)
     return Disc(std::move(impl));
 }
 
+Result<Disc::ImplPtr> Disc::Impl::fromCueSheet(const std::filesystem::path& cuePath,
+                                               const DiscOptions& options)
+{
+    auto impl = create(options);
+
+    // Stamped before parsing so that a concurrent edit makes the snapshot stale
+    auto cueStamp = statFile(cuePath);
+    auto sheetResult = CueParser::parseFile(cuePath, impl->resource);
+    if (!sheetResult) return sheetResult.error();
+
+    size_t trackCount = sheetTrackCount(*sheetResult);
+    if (trackCount > MAX_TRACKS) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidCueFormat,
+            "More than 99 tracks: " + std::to_string(trackCount));
+    }
+
+    impl->sheet = std::move(*sheetResult);
+    impl->baseDir = cuePath.parent_path();
+    impl->cueStamp = cueStamp.value_or(FileStamp{});
+
+    // Resolve file paths and get sizes
+    for (const auto& cueFile : impl->sheet.files) {
+        auto handle = std::make_unique<FileHandle>();
+        handle->path = impl->baseDir / cueFile.filename;
+        handle->index = impl->fileHandles.size();
+        handle->backend = options.ioBackend;
+
+        auto stamp = statFile(handle->path);
+        if (!stamp) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileNotFound,
+                "BIN file not found: " + handle->path.string());
+        }
+        handle->stamp = *stamp;
+        handle->fileSize = stamp->size;
+
+        if (CompressedFile::detect(handle->path)) {
+            handle->compressed = std::make_unique<CompressedFile>();
+            if (!handle->compressed->open(handle->path, options.compressedCacheChunks)) {
+                return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
+                    "Invalid compressed image: " + handle->path.string());
+            }
+            handle->fileSize = handle->compressed->size();
+        }
+
+        handle->dataSize = handle->fileSize;
+        if (cueFile.type == FileType::Wave || cueFile.type == FileType::Aiff) {
+            auto container = parseAudioContainer(handle->path, cueFile.type);
+            if (!container) return container.error();
+            handle->dataOffset = container->dataOffset;
+            handle->dataSize = container->dataSize;
+            handle->bigEndianSamples = container->bigEndian;
+        }
+
+        impl->fileHandles.push_back(std::move(handle));
+    }
+
+    std::vector<FileLayout> layouts;
+    for (const auto& handle : impl->fileHandles) {
+        layouts.push_back({handle->dataOffset, handle->dataSize});
+    }
+    impl->totalSectors = layoutTracks(impl->sheet, layouts, impl->tracks);
+
+    return impl;
+}
+
 size_t Disc::trackCount() const noexcept
 {
     return m_impl->tracks.size();
@@ -189,130 +281,530 @@ int32_t Disc::leadOutLba() const noexcept
 
 const Track* Disc::findTrack(int32_t lba) const noexcept
 {
-    // Binary search: find last track whose startLba <= lba
-    const Track* found = nullptr;
-    int lo = 0;
-    int hi = static_cast<int>(m_impl->tracks.size()) - 1;
-    while (lo <= hi) {
-        int mid = lo + (hi - lo) / 2;
-        if (m_impl->tracks[mid].startLba() <= lba) {
-            found = &m_impl->tracks[mid];
-            lo = mid + 1;
-        } else {
-            hi = mid - 1;
-        }
+    return m_impl->findTrack(lba);
+}
+
+void Disc::Impl::buildExtents()
+{
+    extents.clear();
+    extentBuckets.clear();
+    if (tracks.empty()) return;
+
+    // Each extent starts where the previous one ended, so the table tiles the
+    // axis even if a malformed sheet leaves holes or overlaps between tracks;
+    // a hole becomes part of the next track's pregap
+    int32_t cursor = FIRST_LBA;
+    auto extendTo = [&](int32_t end, const Track& track, ExtentKind kind) {
+        if (end <= cursor) return;
+        extents.push_back({cursor, end, &track, kind});
+        cursor = end;
+    };
+
+    extendTo(0, tracks[0], ExtentKind::LeadIn);
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const Track& t = tracks[i];
+        extendTo(t.startLba(), t, ExtentKind::Pregap);
+        extendTo(t.endLba(), t, ExtentKind::Stored);
+        int32_t gapEnd = i + 1 < tracks.size() ? t.endLba() + t.postgapSectors() : totalSectors;
+        extendTo(gapEnd, t, ExtentKind::Postgap);
+    }
+
+    size_t buckets = (static_cast<size_t>(std::max(cursor, totalSectors) - FIRST_LBA)
+                      >> EXTENT_BUCKET_SHIFT) + 1;
+    extentBuckets.resize(buckets);
+    size_t e = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        int32_t first = FIRST_LBA + static_cast<int32_t>(b << EXTENT_BUCKET_SHIFT);
+        while (e + 1 < extents.size() && extents[e].end <= first) ++e;
+        extentBuckets[b] = static_cast<uint16_t>(e);
+    }
+}
+
+std::vector<TrackExtent> Disc::Impl::trackExtents(size_t fileIndex) const
+{
+    const FileHandle& fh = *fileHandles[fileIndex];
+    int64_t dataEnd = fh.dataOffset + fh.dataSize;
+    auto firstIndexByte = [&](const Track& t) {
+        const auto& indices = t.indices();
+        int32_t first = indices.empty() ? 0 : indices.front().position.toLba();
+        for (const auto& idx : indices) first = std::min(first, idx.position.toLba());
+        return std::min(dataEnd, fh.dataOffset + static_cast<int64_t>(first) * t.sectorSize());
+    };
+
+    std::vector<TrackExtent> extents;
+    for (const auto& t : tracks) {
+        if (t.fileIndex() != fileIndex) continue;
+        int64_t begin = firstIndexByte(t);
+        if (!extents.empty()) extents.back().end = std::max(extents.back().begin, begin);
+        extents.push_back({&t, begin, dataEnd});
+    }
+    return extents;
+}
+
+// Builds a descriptive Error for a failed sector read. Messages are only
+// assembled here, off the allocation-free read path, and never for
+// real-time discs.
+static Error sectorReadError(ErrorCode code, int32_t lba, int32_t count, int32_t totalSectors,
+                             bool realTime)
+{
+    if (realTime) return Error(code, {});
+
+    std::string range = count == 1
+        ? "LBA " + std::to_string(lba)
+        : "LBA range [" + std::to_string(lba) + ", " + std::to_string(int64_t{lba} + count) + ")";
+
+    switch (code) {
+        case ErrorCode::LBAOutOfRange:
+            return LIBCUEBIN_ERROR(code, range + " out of range [" + std::to_string(Disc::FIRST_LBA) + ", "
+                + std::to_string(totalSectors) + ")");
+        case ErrorCode::TrackNotFound:
+            return LIBCUEBIN_ERROR(code, "No track found for " + range);
+        case ErrorCode::FileSeekError:
+            return LIBCUEBIN_ERROR(code, "Seek failed reading " + range);
+        case ErrorCode::FileReadError:
+            return LIBCUEBIN_ERROR(code, "Read failed for " + range);
+        default:
+            return LIBCUEBIN_ERROR(code, "Cannot read " + range);
     }
-    if (found && lba < found->endLba()) return found;
-    return nullptr;
 }
 
 Result<SectorData> Disc::readSector(int32_t lba) const
 {
-    if (lba < 0 || lba >= m_impl->totalSectors) {
-        return LIBCUEBIN_ERROR(ErrorCode::LBAOutOfRange,
-            "LBA " + std::to_string(lba) + " out of range [0, "
-            + std::to_string(m_impl->totalSectors) + ")");
+    SectorData sector;
+    auto status = readSectorInto(lba, sector.data, &sector.mode);
+    if (!status) return sectorReadError(status.code(), lba, 1, m_impl->totalSectors, m_impl->realTime);
+    return sector;
+}
+
+Result<SectorData> Disc::readSector(MSF address) const
+{
+    return readSector(address.toLba());
+}
+
+Result<std::vector<SectorData>> Disc::readSectors(int32_t lba, int32_t count) const
+{
+    if (m_impl->realTime) return Error(ErrorCode::Unsupported, {});
+    if (count <= 0) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument,
+            "Sector count must be positive");
     }
 
-    const Track* trk = findTrack(lba);
-    if (!trk) {
-        return LIBCUEBIN_ERROR(ErrorCode::TrackNotFound,
-            "No track found for LBA " + std::to_string(lba));
+    int64_t endLba = static_cast<int64_t>(lba) + count;
+    if (lba < FIRST_LBA || endLba > m_impl->totalSectors) {
+        return sectorReadError(ErrorCode::LBAOutOfRange, lba, count, m_impl->totalSectors, false);
     }
 
-    auto& fh = *m_impl->fileHandles[trk->fileIndex()];
+    std::vector<SectorData> sectors(count);
 
-    // Lazy open
-    std::call_once(fh.openFlag, [&fh]() {
-        fh.stream.open(fh.path, std::ios::binary);
-        if (fh.stream.is_open()) {
-            spdlog::debug("Opened file: {}", fh.path.string());
+    // Read through a bounded staging buffer, then scatter into SectorData
+    int32_t chunkSectors = std::min<int32_t>(count, MAX_RUN_BYTES / RAW_SECTOR_SIZE);
+    std::vector<uint8_t> buffer(static_cast<size_t>(chunkSectors) * RAW_SECTOR_SIZE);
+    std::vector<TrackMode> modes(chunkSectors);
+
+    for (int32_t done = 0; done < count; done += chunkSectors) {
+        int32_t n = std::min(chunkSectors, count - done);
+        auto status = readSectorsInto(lba + done, n, buffer, modes);
+        if (!status) return sectorReadError(status.code(), lba + done, n, m_impl->totalSectors, false);
+
+        for (int32_t i = 0; i < n; ++i) {
+            auto& sector = sectors[done + i];
+            sector.mode = modes[i];
+            std::memcpy(sector.data.data(), buffer.data() + static_cast<size_t>(i) * RAW_SECTOR_SIZE,
+                        RAW_SECTOR_SIZE);
         }
-    });
+    }
+
+    return sectors;
+}
+
+Status Disc::readSectorInto(int32_t lba, std::span<uint8_t> out, TrackMode* mode) const noexcept
+{
+    std::span<TrackMode> modes;
+    if (mode) modes = std::span<TrackMode>(mode, 1);
+    return readSectorsInto(lba, 1, out, modes);
+}
 
-    std::lock_guard<std::mutex> lock(fh.mutex);
+Status Disc::readSectorsInto(int32_t lba, int32_t count, std::span<uint8_t> out,
+                             std::span<TrackMode> modes) const noexcept
+{
+    Status status = m_impl->readSectorsInto(lba, count, out, modes);
+    if (!status) LIBCUEBIN_TRACE(readError, lba, count, status.code());
+    return status;
+}
+
+Status Disc::Impl::readSectorsInto(int32_t lba, int32_t count, std::span<uint8_t> out,
+                                   std::span<TrackMode> modes) const noexcept
+{
+    if (count <= 0) return ErrorCode::InvalidArgument;
+    if (out.size() < static_cast<size_t>(count) * RAW_SECTOR_SIZE) return ErrorCode::InvalidArgument;
+    if (!modes.empty() && modes.size() < static_cast<size_t>(count)) return ErrorCode::InvalidArgument;
 
-    if (!fh.stream.is_open()) {
-        return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
-            "Cannot open file: " + fh.path.string());
+    int64_t endLba = static_cast<int64_t>(lba) + count;
+    if (lba < FIRST_LBA || endLba > totalSectors) return ErrorCode::LBAOutOfRange;
+
+    TrackMode* modesOut = modes.empty() ? nullptr : modes.data();
+    if (!readAhead) return readDirect(lba, count, out.data(), modesOut);
+
+    bool hit = readAhead->tryRead(lba, count, out.data(), modesOut);
+    Status status = hit ? Status{} : readDirect(lba, count, out.data(), modesOut);
+    if (status) readAhead->noteAccess(lba, count, hit);
+    return status;
+}
+
+// Where the user data of a sector sits within its bytes as stored in the file
+struct Payload {
+    size_t offset;
+    size_t size;
+};
+
+static Payload payloadLayout(TrackMode mode, const uint8_t* stored) noexcept
+{
+    size_t subheader = 0;
+    switch (mode) {
+        case TrackMode::Audio:
+        case TrackMode::CDG:
+            return {0, RAW_SECTOR_SIZE};
+        case TrackMode::Mode1_2048:
+            return {0, MODE1_USER_DATA_SIZE};
+        case TrackMode::Mode1_2352:
+            return {16, MODE1_USER_DATA_SIZE};
+        case TrackMode::Mode2_2352:
+        case TrackMode::CDI_2352:
+            subheader = 16;
+            break;
+        case TrackMode::Mode2_2336:
+        case TrackMode::CDI_2336:
+            break;
     }
 
-    int64_t offset = trk->fileByteOffset()
-                   + static_cast<int64_t>(lba - trk->fileStartLba()) * trk->sectorSize();
+    // XA sectors repeat their 4-byte subheader; anything else is formless Mode 2
+    const uint8_t* sub = stored + subheader;
+    if (std::memcmp(sub, sub + 4, 4) != 0) return {subheader, MODE2_USER_DATA_SIZE};
+    if (sub[2] & SUBMODE_FORM2) return {subheader + 8, MODE2_FORM2_USER_DATA_SIZE};
+    return {subheader + 8, MODE1_USER_DATA_SIZE};
+}
 
-    fh.stream.seekg(offset);
-    if (!fh.stream) {
-        return LIBCUEBIN_ERROR(ErrorCode::FileSeekError,
-            "Seek failed at offset " + std::to_string(offset));
+// Largest payload a sector of `mode` can produce
+static size_t maxPayloadSize(TrackMode mode) noexcept
+{
+    switch (mode) {
+        case TrackMode::Mode1_2048:
+        case TrackMode::Mode1_2352:
+            return MODE1_USER_DATA_SIZE;
+        case TrackMode::Mode2_2336:
+        case TrackMode::Mode2_2352:
+        case TrackMode::CDI_2336:
+        case TrackMode::CDI_2352:
+            return MODE2_USER_DATA_SIZE;
+        default:
+            return RAW_SECTOR_SIZE;
     }
+}
 
-    SectorData sector;
-    sector.mode = trk->mode();
-
-    uint16_t readSize = trk->sectorSize();
-    if (readSize > RAW_SECTOR_SIZE) readSize = RAW_SECTOR_SIZE;
-
-    fh.stream.read(reinterpret_cast<char*>(sector.data.data()), readSize);
-    if (!fh.stream) {
-        // Allow partial read at end of file
-        auto bytesRead = fh.stream.gcount();
-        if (bytesRead == 0) {
-            return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
-                "Read failed at offset " + std::to_string(offset));
-        }
-        // Zero-fill remainder
-        std::memset(sector.data.data() + bytesRead, 0, RAW_SECTOR_SIZE - bytesRead);
-        fh.stream.clear();
+// Payload of a gap sector: synthesized data sectors are Mode 1 or Form 2
+static size_t gapPayloadSize(TrackMode mode) noexcept
+{
+    switch (mode) {
+        case TrackMode::Audio:
+        case TrackMode::CDG:
+            return RAW_SECTOR_SIZE;
+        case TrackMode::Mode1_2048:
+        case TrackMode::Mode1_2352:
+            return MODE1_USER_DATA_SIZE;
+        default:
+            return MODE2_FORM2_USER_DATA_SIZE;
     }
+}
 
-    // For modes with smaller sector sizes (e.g., 2048), pad the rest with zeros
-    if (readSize < RAW_SECTOR_SIZE) {
-        std::memset(sector.data.data() + readSize, 0, RAW_SECTOR_SIZE - readSize);
+Status Disc::readUserDataInto(int32_t lba, int32_t count, std::span<uint8_t> out,
+                              size_t* written) const noexcept
+{
+    Status status = m_impl->readUserDataInto(lba, count, out, written);
+    if (!status) LIBCUEBIN_TRACE(readError, lba, count, status.code());
+    return status;
+}
+
+Status Disc::Impl::readUserDataInto(int32_t lba, int32_t count, std::span<uint8_t> out,
+                                    size_t* written) const noexcept
+{
+    if (count <= 0) return ErrorCode::InvalidArgument;
+    int64_t endLba = static_cast<int64_t>(lba) + count;
+    if (lba < FIRST_LBA || endLba > totalSectors) return ErrorCode::LBAOutOfRange;
+
+    // Sectors stored with a stride other than their payload go through this
+    // per-thread staging area, so each payload is copied exactly once
+    constexpr int32_t STAGING_SECTORS = 32;
+    constexpr size_t MAX_STORED_SECTOR = 2448; // CDG: audio plus subchannel
+    thread_local std::array<uint8_t, STAGING_SECTORS * MAX_STORED_SECTOR> staging;
+
+    size_t pos = 0;
+    int32_t current = lba;
+    while (current < endLba) {
+        const LbaExtent* extent = findExtent(current);
+        if (!extent) return ErrorCode::LBAOutOfRange;
+
+        const Track* trk = extent->track;
+        int32_t runEnd = static_cast<int32_t>(std::min<int64_t>(endLba, extent->end));
+        if (extent->isVirtual()) {
+            // Gaps read as silence or as empty sectors: all-zero payloads
+            size_t bytes = static_cast<size_t>(runEnd - current) * gapPayloadSize(trk->mode());
+            if (out.size() - pos < bytes) return ErrorCode::InvalidArgument;
+            std::memset(out.data() + pos, 0, bytes);
+            pos += bytes;
+            current = runEnd;
+            continue;
+        }
+
+        const auto& fh = *fileHandles[trk->fileIndex()];
+        if (!fh.ensureOpen()) return ErrorCode::FileReadError;
+
+        uint16_t ss = trk->sectorSize();
+        int64_t offset = trk->fileByteOffset()
+                       + static_cast<int64_t>(current - trk->fileStartLba()) * ss;
+
+        if (ss == MODE1_USER_DATA_SIZE || trk->mode() == TrackMode::Audio) {
+            // Stored exactly as the payload: read the whole run in place
+            int64_t bytes = static_cast<int64_t>(runEnd - current) * ss;
+            if (out.size() - pos < static_cast<size_t>(bytes)) return ErrorCode::InvalidArgument;
+            LIBCUEBIN_TRACE(readBegin, current, runEnd - current, fh.index, offset, bytes);
+            int64_t bytesRead = fh.readAt(offset, out.data() + pos, bytes);
+            LIBCUEBIN_TRACE(readEnd, current, runEnd - current, fh.index, offset, bytesRead);
+            if (bytesRead < 0) return ErrorCode::FileSeekError;
+            if (bytesRead < bytes) {
+                if (bytesRead <= bytes - ss) return ErrorCode::FileReadError;
+                std::memset(out.data() + pos + bytesRead, 0, static_cast<size_t>(bytes - bytesRead));
+            }
+            if (fh.bigEndianSamples && trk->isAudio()) {
+                swapSampleBytes(out.data() + pos, static_cast<size_t>(bytesRead));
+            }
+            fh.countSectors(runEnd - current);
+            pos += static_cast<size_t>(bytes);
+            current = runEnd;
+            continue;
+        }
+
+        while (current < runEnd) {
+            int32_t n = std::min(STAGING_SECTORS, runEnd - current);
+            int64_t bytes = static_cast<int64_t>(n) * ss;
+            LIBCUEBIN_TRACE(readBegin, current, n, fh.index, offset, bytes);
+            int64_t bytesRead = fh.readAt(offset, staging.data(), bytes);
+            LIBCUEBIN_TRACE(readEnd, current, n, fh.index, offset, bytesRead);
+            if (bytesRead < 0) return ErrorCode::FileSeekError;
+            if (bytesRead <= bytes - ss) return ErrorCode::FileReadError;
+            if (bytesRead < bytes) {
+                std::memset(staging.data() + bytesRead, 0, static_cast<size_t>(bytes - bytesRead));
+            }
+
+            for (int32_t i = 0; i < n; ++i) {
+                const uint8_t* stored = staging.data() + static_cast<size_t>(i) * ss;
+                Payload payload = payloadLayout(trk->mode(), stored);
+                if (out.size() - pos < payload.size) return ErrorCode::InvalidArgument;
+                std::memcpy(out.data() + pos, stored + payload.offset, payload.size);
+                pos += payload.size;
+            }
+            fh.countSectors(n);
+            offset += bytes;
+            current += n;
+        }
     }
 
-    return sector;
+    if (written) *written = pos;
+    return {};
 }
 
-Result<SectorData> Disc::readSector(MSF address) const
+Result<std::vector<uint8_t>> Disc::readUserData(int32_t lba) const
 {
-    return readSector(address.toLba());
+    return readUserDataRange(lba, 1);
 }
 
-Result<std::vector<SectorData>> Disc::readSectors(int32_t lba, int32_t count) const
+Result<std::vector<uint8_t>> Disc::readUserDataRange(int32_t lba, int32_t count) const
 {
+    if (m_impl->realTime) return Error(ErrorCode::Unsupported, {});
     if (count <= 0) {
         return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument,
             "Sector count must be positive");
     }
 
-    std::vector<SectorData> sectors;
-    sectors.reserve(count);
+    int64_t endLba = static_cast<int64_t>(lba) + count;
+    if (lba < FIRST_LBA || endLba > m_impl->totalSectors) {
+        return sectorReadError(ErrorCode::LBAOutOfRange, lba, count, m_impl->totalSectors, false);
+    }
+
+    // Size for the largest payloads, then trim to what the subheaders said
+    size_t capacity = 0;
+    for (int32_t current = lba; current < endLba;) {
+        const LbaExtent* extent = m_impl->findExtent(current);
+        int32_t runEnd = static_cast<int32_t>(std::min<int64_t>(endLba, extent->end));
+        capacity += static_cast<size_t>(runEnd - current) * maxPayloadSize(extent->track->mode());
+        current = runEnd;
+    }
+
+    std::vector<uint8_t> data(capacity);
+    size_t written = 0;
+    auto status = readUserDataInto(lba, count, data, &written);
+    if (!status) return sectorReadError(status.code(), lba, count, m_impl->totalSectors, false);
+    data.resize(written);
+    return data;
+}
 
+ReadAheadStats Disc::readAheadStats() const noexcept
+{
+    if (!m_impl->readAhead) return {};
+    return m_impl->readAhead->stats();
+}
+
+Status Disc::Impl::readDirect(int32_t lba, int32_t count, uint8_t* out,
+                              TrackMode* modes) const noexcept
+{
+    return forEachSegment(lba, count, out, modes, [](const ReadSegment& seg) noexcept -> Status {
+        if (!seg.file->ensureOpen()) return ErrorCode::FileReadError;
+        LIBCUEBIN_TRACE(readBegin, seg.lba, seg.sectors, seg.file->index, seg.offset, seg.bytes);
+        int64_t bytesRead = seg.file->readAt(seg.offset, seg.dst, seg.bytes);
+        LIBCUEBIN_TRACE(readEnd, seg.lba, seg.sectors, seg.file->index, seg.offset, bytesRead);
+        if (bytesRead < 0) return ErrorCode::FileSeekError;
+        seg.file->countSectors(seg.sectors);
+        return frameSegment(seg, bytesRead);
+    });
+}
+
+Status frameSegment(const ReadSegment& seg, int64_t bytesRead) noexcept
+{
+    // Rebuilt raw sectors carry the user data after the 16-byte sync/header
+    size_t dataOffset = seg.rawSectors ? SUBHEADER_OFFSET : 0;
+
+    if (seg.swapSamples && bytesRead > 0) swapSampleBytes(seg.dst, static_cast<size_t>(bytesRead));
+
+    for (int32_t i = 0; i < seg.sectors; ++i) {
+        int64_t sectorStart = static_cast<int64_t>(i) * seg.packedSize;
+        int64_t available = std::clamp<int64_t>(bytesRead - sectorStart, 0, seg.packedSize);
+        if (available == 0) return ErrorCode::FileReadError;
+
+        // Packed data sits at the tail of the region, so moving each sector
+        // forward (even 16 bytes past its slot start) never clobbers the next
+        uint8_t* slot = seg.slots + static_cast<size_t>(i) * RAW_SECTOR_SIZE;
+        uint8_t* dst = slot + dataOffset;
+        const uint8_t* src = seg.dst + sectorStart;
+        if (src != dst) std::memmove(dst, src, static_cast<size_t>(available));
+        std::memset(slot, 0, dataOffset);
+        std::memset(dst + available, 0, RAW_SECTOR_SIZE - dataOffset - static_cast<size_t>(available));
+
+        if (seg.rawSectors) {
+            RawSector sector(slot, RAW_SECTOR_SIZE);
+            if (seg.packedSize == 2048) {
+                encodeMode1Sector(seg.lba + i, sector);
+            } else {
+                // 2336-byte sectors already hold subheader, EDC and ECC
+                writeSectorHeader(seg.lba + i, 2, sector);
+            }
+        }
+    }
+
+    if (seg.modes) std::fill_n(seg.modes, seg.sectors, seg.mode);
+    return {};
+}
+
+void synthesizeGap(const Track& track, int32_t lba, int32_t count, bool rawSectors,
+                   uint8_t* slots, TrackMode* modes) noexcept
+{
+    std::memset(slots, 0, static_cast<size_t>(count) * RAW_SECTOR_SIZE);
+    if (modes) std::fill_n(modes, count, track.mode());
+    if (track.mode() == TrackMode::Audio || track.mode() == TrackMode::CDG) return;
+
+    // Cooked tracks hold their sectors from the subheader or user data on,
+    // unless rebuilt as raw sectors
+    bool raw = track.sectorSize() >= RAW_SECTOR_SIZE || rawSectors;
+    bool mode1 = track.mode() == TrackMode::Mode1_2048 || track.mode() == TrackMode::Mode1_2352;
     for (int32_t i = 0; i < count; ++i) {
-        auto result = readSector(lba + i);
-        if (!result) return result.error();
-        sectors.push_back(std::move(*result));
+        uint8_t* slot = slots + static_cast<size_t>(i) * RAW_SECTOR_SIZE;
+        RawSector sector(slot, RAW_SECTOR_SIZE);
+        if (mode1) {
+            if (raw) encodeMode1Sector(lba + i, sector);
+            continue;
+        }
+        // Mode 2 gaps are mastered as Form 2 sectors with an otherwise empty subheader
+        uint8_t* subheader = slot + (raw ? SUBHEADER_OFFSET : 0);
+        subheader[2] = SUBMODE_FORM2;
+        subheader[6] = SUBMODE_FORM2;
+        if (raw) encodeMode2Form2Sector(lba + i, sector);
+    }
+}
+
+Result<std::span<const uint8_t>> Disc::sectorView(int32_t lba) const
+{
+    // Real-time discs report the code alone
+    auto fail = [&](ErrorCode code, auto describe) {
+        LIBCUEBIN_TRACE(readError, lba, 1, code);
+        return Error(code, m_impl->realTime ? std::string() : describe());
+    };
+
+    if (lba < 0 || lba >= m_impl->totalSectors) {
+        return fail(ErrorCode::LBAOutOfRange, [&] {
+            return "LBA " + std::to_string(lba) + " out of range [0, "
+                + std::to_string(m_impl->totalSectors) + ")";
+        });
     }
 
-    return sectors;
+    const Track* trk = findTrack(lba);
+    if (!trk) {
+        return fail(ErrorCode::TrackNotFound, [&] {
+            return "No track found for LBA " + std::to_string(lba);
+        });
+    }
+
+    const auto& fh = *m_impl->fileHandles[trk->fileIndex()];
+    if (fh.backend != IoBackend::Mmap) {
+        return fail(ErrorCode::InvalidArgument, [] {
+            return std::string("Sector views require the Mmap I/O backend");
+        });
+    }
+    if (fh.compressed) {
+        return fail(ErrorCode::Unsupported, [] {
+            return std::string("Compressed images have no direct sector view");
+        });
+    }
+    if (fh.bigEndianSamples && trk->isAudio()) {
+        return fail(ErrorCode::Unsupported, [] {
+            return std::string("AIFF samples are byte-swapped on read and have no direct view");
+        });
+    }
+
+    if (!fh.ensureOpen()) {
+        return fail(ErrorCode::FileReadError, [&] {
+            return "Cannot open file: " + fh.path.string();
+        });
+    }
+
+    int64_t offset = trk->fileByteOffset()
+                   + static_cast<int64_t>(lba - trk->fileStartLba()) * trk->sectorSize();
+    int64_t end = offset + trk->sectorSize();
+    if (end > static_cast<int64_t>(fh.mapping.size())) {
+        return fail(ErrorCode::FileReadError, [&] {
+            return "Sector at offset " + std::to_string(offset) + " extends past end of file";
+        });
+    }
+
+    return std::span<const uint8_t>(fh.mapping.data() + offset, trk->sectorSize());
 }
 
-std::optional<std::string_view> Disc::title() const noexcept
+static std::optional<std::string_view> view(const std::optional<std::pmr::string>& s) noexcept
 {
-    if (m_impl->title) return std::string_view(*m_impl->title);
+    if (s) return std::string_view(*s);
     return std::nullopt;
 }
 
+std::optional<std::string_view> Disc::title() const noexcept
+{
+    return view(m_impl->sheet.title);
+}
+
 std::optional<std::string_view> Disc::performer() const noexcept
 {
-    if (m_impl->performer) return std::string_view(*m_impl->performer);
-    return std::nullopt;
+    return view(m_impl->sheet.performer);
 }
 
 std::optional<std::string_view> Disc::catalog() const noexcept
 {
-    if (m_impl->catalog) return std::string_view(*m_impl->catalog);
-    return std::nullopt;
+    return view(m_impl->sheet.catalog);
 }
 
 const CueSheet& Disc::cueSheet() const noexcept
@@ -0,0 +1,218 @@
+#include "libcuebin/hash.hpp"
+
+#include "discImpl.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+namespace cuebin {
+
+namespace {
+
+constexpr size_t MIN_CHUNK_BYTES = 64 * 1024;
+
+struct ByteRange {
+    int64_t begin = 0;
+    int64_t end = 0;
+};
+
+// Hands chunks read by one thread to each hash worker in order. A buffer is
+// refilled only once every worker has finished with it.
+class ChunkPipeline {
+public:
+    static constexpr size_t SLOTS = 4;
+    static constexpr size_t WORKERS = 3;
+
+    explicit ChunkPipeline(size_t chunkBytes)
+    {
+        for (auto& slot : m_slots) slot.data.resize(chunkBytes);
+    }
+
+    // Reader side: waits for the slot of chunk `seq` to be free
+    uint8_t* beginWrite(size_t seq)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_ready.wait(lock, [&]() {
+            return std::all_of(m_consumed.begin(), m_consumed.end(),
+                               [&](size_t c) { return c + SLOTS > seq; });
+        });
+        return m_slots[seq % SLOTS].data.data();
+    }
+
+    void publish(size_t seq, int64_t offset, size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_slots[seq % SLOTS].offset = offset;
+            m_slots[seq % SLOTS].size = size;
+            m_produced = seq + 1;
+        }
+        m_ready.notify_all();
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_ready.notify_all();
+    }
+
+    // Worker side: false once the reader has closed and `seq` was never produced
+    bool acquire(size_t seq, std::span<const uint8_t>& data, int64_t& offset)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_ready.wait(lock, [&]() { return m_produced > seq || m_closed; });
+        if (m_produced <= seq) return false;
+        const auto& slot = m_slots[seq % SLOTS];
+        data = std::span<const uint8_t>(slot.data.data(), slot.size);
+        offset = slot.offset;
+        return true;
+    }
+
+    void release(size_t worker, size_t seq)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_consumed[worker] = seq + 1;
+        }
+        m_ready.notify_all();
+    }
+
+private:
+    struct Slot {
+        std::vector<uint8_t> data;
+        int64_t offset = 0;
+        size_t size = 0;
+    };
+
+    std::array<Slot, SLOTS> m_slots;
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    size_t m_produced = 0;
+    std::array<size_t, WORKERS> m_consumed{};
+    bool m_closed = false;
+};
+
+struct Crc32State {
+    uint32_t crc = 0;
+    void update(std::span<const uint8_t> data) noexcept { crc = crc32(data, crc); }
+    void finish(HashDigest& digest) noexcept { digest.crc32 = crc; }
+};
+
+struct Md5State {
+    Md5 md5;
+    void update(std::span<const uint8_t> data) noexcept { md5.update(data); }
+    void finish(HashDigest& digest) noexcept { digest.md5 = md5.finish(); }
+};
+
+struct Sha1State {
+    Sha1 sha1;
+    void update(std::span<const uint8_t> data) noexcept { sha1.update(data); }
+    void finish(HashDigest& digest) noexcept { digest.sha1 = sha1.finish(); }
+};
+
+// Runs one algorithm over the whole file and, alongside it, over each
+// track's slice of every chunk
+template <typename State>
+void hashWorker(ChunkPipeline& pipeline, size_t worker, const std::vector<ByteRange>& ranges,
+                HashDigest& fileDigest, std::vector<HashDigest>& trackDigests)
+{
+    State file;
+    std::vector<State> tracks(ranges.size());
+
+    std::span<const uint8_t> data;
+    int64_t offset = 0;
+    for (size_t seq = 0; pipeline.acquire(seq, data, offset); ++seq) {
+        file.update(data);
+        int64_t chunkEnd = offset + static_cast<int64_t>(data.size());
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            int64_t begin = std::max(offset, ranges[i].begin);
+            int64_t end = std::min(chunkEnd, ranges[i].end);
+            if (begin < end) {
+                tracks[i].update(data.subspan(static_cast<size_t>(begin - offset),
+                                              static_cast<size_t>(end - begin)));
+            }
+        }
+        pipeline.release(worker, seq);
+    }
+
+    file.finish(fileDigest);
+    for (size_t i = 0; i < ranges.size(); ++i) tracks[i].finish(trackDigests[i]);
+}
+
+} // anonymous namespace
+
+Result<DiscHashes> hashDisc(const Disc& disc, const HashOptions& options)
+{
+    const auto& impl = *disc.m_impl;
+    size_t chunkBytes = std::max(MIN_CHUNK_BYTES, options.chunkBytes);
+
+    DiscHashes result;
+    for (size_t fi = 0; fi < impl.fileHandles.size(); ++fi) {
+        const FileHandle& fh = *impl.fileHandles[fi];
+        if (!fh.compressed && !fh.asyncFile()) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileReadError, "Cannot open file: " + fh.path.string());
+        }
+
+        std::vector<const Track*> tracks;
+        std::vector<ByteRange> ranges;
+        for (const auto& extent : impl.trackExtents(fi)) {
+            tracks.push_back(extent.track);
+            ranges.push_back({extent.begin, extent.end});
+        }
+
+        // A track spanning the whole file (split BIN sets) shares its digest
+        bool wholeFile = ranges.size() == 1 && ranges[0].begin == 0 && ranges[0].end == fh.fileSize;
+        std::vector<ByteRange> workerRanges = wholeFile ? std::vector<ByteRange>() : ranges;
+
+        HashDigest fileDigest;
+        std::vector<HashDigest> trackDigests(ranges.size());
+        ChunkPipeline pipeline(chunkBytes);
+
+        std::thread workers[] = {
+            std::thread([&]() { hashWorker<Crc32State>(pipeline, 0, workerRanges, fileDigest, trackDigests); }),
+            std::thread([&]() { hashWorker<Md5State>(pipeline, 1, workerRanges, fileDigest, trackDigests); }),
+            std::thread([&]() { hashWorker<Sha1State>(pipeline, 2, workerRanges, fileDigest, trackDigests); }),
+        };
+
+        int64_t offset = 0;
+        bool failed = false;
+        for (size_t seq = 0; offset < fh.fileSize; ++seq) {
+            uint8_t* buffer = pipeline.beginWrite(seq);
+            int64_t want = std::min<int64_t>(static_cast<int64_t>(chunkBytes), fh.fileSize - offset);
+            int64_t got = fh.readPositional(offset, buffer, want);
+            if (got <= 0) {
+                failed = true;
+                break;
+            }
+            pipeline.publish(seq, offset, static_cast<size_t>(got));
+            offset += got;
+        }
+        pipeline.close();
+        for (auto& w : workers) w.join();
+
+        if (failed) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
+                "Read failed at offset " + std::to_string(offset) + " of " + fh.path.string());
+        }
+
+        fileDigest.size = static_cast<uint64_t>(offset);
+        result.files.push_back({fh.path, fileDigest});
+        for (size_t i = 0; i < tracks.size(); ++i) {
+            HashDigest digest = wholeFile ? fileDigest : trackDigests[i];
+            digest.size = static_cast<uint64_t>(ranges[i].end - ranges[i].begin);
+            result.tracks.push_back({tracks[i]->number(), digest});
+        }
+        spdlog::debug("Hashed {} ({} bytes, {} tracks)", fh.path.string(), offset, tracks.size());
+    }
+
+    return result;
+}
+
+} // namespace cuebin
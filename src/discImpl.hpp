@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "libcuebin/disc.hpp"
+#include "fileHandle.hpp"
+#include "fixedVector.hpp"
+#include "rawFile.hpp"
+#include "readAhead.hpp"
+
+namespace cuebin {
+
+// One contiguous file read produced by translating an LBA range. The file
+// bytes land packed at `dst`; frameSegment() then spreads them into
+// zero-padded 2352-byte slots starting at `slots`.
+struct ReadSegment {
+    const FileHandle* file = nullptr;
+    int64_t offset = 0;
+    uint8_t* dst = nullptr;
+    int64_t bytes = 0;
+    uint8_t* slots = nullptr;
+    int32_t sectors = 0;
+    uint16_t packedSize = 0; // Bytes per sector as laid out at `dst`
+    TrackMode mode = TrackMode::Audio;
+    TrackMode* modes = nullptr;
+    int32_t lba = 0;          // LBA of the first sector
+    bool rawSectors = false;  // Rebuild sync/header/EDC/ECC around cooked data
+    bool swapSamples = false; // Audio stored big-endian (AIFF)
+};
+
+// Frames a segment once `bytesRead` of its bytes have arrived at `dst`.
+Status frameSegment(const ReadSegment& seg, int64_t bytesRead) noexcept;
+
+// Fills `count` 2352-byte slots from `lba` with the sectors a gap of `track`
+// reads as: silence on audio tracks, empty Mode 1 or Mode 2 Form 2 sectors
+// on data tracks, laid out as a stored sector of the track would be.
+void synthesizeGap(const Track& track, int32_t lba, int32_t count, bool rawSectors,
+                   uint8_t* slots, TrackMode* modes) noexcept;
+
+enum class ExtentKind : uint8_t {
+    Stored,  // Sectors in the track's file
+    Pregap,  // PREGAP of the track that follows
+    Postgap, // POSTGAP of the track before
+    LeadIn,  // The 150 sectors before LBA 0, in track 1's pregap
+};
+
+// A run of LBAs that all map the same way. `track` is the track the run
+// belongs to: the one it stores, or the one a gap is part of.
+struct LbaExtent {
+    int32_t begin = 0;
+    int32_t end = 0;
+    const Track* track = nullptr;
+    ExtentKind kind = ExtentKind::Stored;
+
+    bool isVirtual() const noexcept { return kind != ExtentKind::Stored; }
+};
+
+// The lead-in, plus a pregap, stored run and postgap per track
+static constexpr size_t MAX_EXTENTS = 1 + 3 * MAX_TRACKS;
+
+// LBAs per entry of Disc::Impl::extentBuckets
+static constexpr int32_t EXTENT_BUCKET_SHIFT = 6;
+
+// Bytes of one track within its file: from its first index to the next
+// track's first index, or the end of the file's sector data
+struct TrackExtent {
+    const Track* track = nullptr;
+    int64_t begin = 0;
+    int64_t end = 0;
+};
+
+// Where the sector data of one FILE entry lives: past the header of
+// WAVE/AIFF files, the whole (decompressed) file otherwise
+struct FileLayout {
+    int64_t dataOffset = 0;
+    int64_t dataSize = 0;
+};
+
+using TrackTable = FixedVector<Track, MAX_TRACKS>;
+
+// Tracks across all FILE entries of `sheet`
+size_t sheetTrackCount(const CueSheet& sheet) noexcept;
+
+// Places the tracks of `sheet` on the LBA axis, appending them to `tracks`,
+// which must have room for sheetTrackCount() more. `files` holds one layout
+// per FILE entry. Returns the total sector count, pregaps and postgaps
+// included. The tracks refer to the sheet's CueTracks.
+int32_t layoutTracks(const CueSheet& sheet, const std::vector<FileLayout>& files,
+                     TrackTable& tracks);
+
+// Q-channel layout of one track, precomputed at load so that subchannel
+// synthesis is a binary search and a few table lookups per sector
+struct SubchannelTrack {
+    int32_t begin = 0;      // First LBA of the pregap (INDEX 00)
+    int32_t start = 0;      // INDEX 01
+    int32_t dataEnd = 0;    // End of the sectors stored in the file
+    int32_t end = 0;        // dataEnd plus the postgap
+    int64_t subRecord = 0;  // .sub record holding `start`
+    const Track* track = nullptr;
+    uint8_t controlAdr = 0; // Q byte 0
+    uint8_t number = 0;
+    uint16_t firstIndex = 0; // INDEX 02 onwards, in subchannelIndices
+    uint16_t indexCount = 0;
+};
+
+struct SubchannelIndex {
+    int32_t lba = 0;
+    uint8_t number = 0;
+};
+
+// Allocated from DiscOptions::memoryResource, like the sheet and the
+// subchannel index list it owns; the track tables are inline.
+struct Disc::Impl {
+    explicit Impl(std::pmr::memory_resource* resource)
+        : resource(resource), sheet(CueAllocator(resource)), extentBuckets(resource),
+          subchannelIndices(resource) {}
+
+    std::pmr::memory_resource* resource;
+    CueSheet sheet;
+    std::filesystem::path baseDir;
+    FileStamp cueStamp;
+    TrackTable tracks; // Point into `sheet`, which is not modified once loaded
+    std::vector<std::unique_ptr<FileHandle>> fileHandles;
+    int32_t totalSectors = 0;
+    bool rawSectors = false;
+    bool realTime = false; // See DiscOptions::realTime
+
+    // Tile [Disc::FIRST_LBA, totalSectors) in order. Each bucket of
+    // 2^EXTENT_BUCKET_SHIFT LBAs from FIRST_LBA holds the first extent
+    // overlapping it, so a lookup is an index and a step past the few
+    // extents that may end within the bucket.
+    FixedVector<LbaExtent, MAX_EXTENTS> extents;
+    std::pmr::vector<uint16_t> extentBuckets;
+
+    FixedVector<SubchannelTrack, MAX_TRACKS> subchannelTracks;
+    std::pmr::vector<SubchannelIndex> subchannelIndices;
+    uint8_t leadOutControlAdr = 0;
+    // Optional .sub sidecar: 96 deinterleaved bytes per stored sector, in file order
+    RawFile subFile;
+    int64_t subFileRecords = 0;
+
+    // Declared last: its worker thread reads through this Impl
+    std::unique_ptr<ReadAhead> readAhead;
+
+    // An empty Impl in the options' memory resource
+    static ImplPtr create(const DiscOptions& options);
+
+    // Parses the CUE sheet and probes its files: everything fromCue() does
+    // that does not depend on the per-open options
+    static Result<ImplPtr> fromCueSheet(const std::filesystem::path& cuePath,
+                                        const DiscOptions& options);
+
+    // Rebuilds the state fromCueSheet() produces from a snapshot written by
+    // writeSnapshot(). Returns nullptr if the snapshot is missing, corrupt,
+    // from another version, or older than the CUE sheet or any of its files.
+    static ImplPtr loadSnapshot(const std::filesystem::path& snapshotPath,
+                                const std::filesystem::path& cuePath,
+                                const DiscOptions& options);
+    bool writeSnapshot(const std::filesystem::path& snapshotPath) const;
+
+    // Builds the extent table from the track table and totalSectors
+    void buildExtents();
+    // nullptr outside [Disc::FIRST_LBA, totalSectors)
+    const LbaExtent* findExtent(int32_t lba) const noexcept
+    {
+        if (lba < Disc::FIRST_LBA || lba >= totalSectors || extentBuckets.empty()) return nullptr;
+        size_t i = extentBuckets[static_cast<size_t>(lba - Disc::FIRST_LBA) >> EXTENT_BUCKET_SHIFT];
+        while (extents[i].end <= lba) ++i;
+        return &extents[i];
+    }
+    // Track whose file stores `lba`; nullptr in gaps
+    const Track* findTrack(int32_t lba) const noexcept
+    {
+        const LbaExtent* extent = findExtent(lba);
+        return extent && !extent->isVirtual() ? extent->track : nullptr;
+    }
+
+    // Fills the subchannel tables and opens a .sub sidecar found next to
+    // `cuePath` or the first BIN file
+    void loadSubchannel(const std::filesystem::path& cuePath);
+    // Writes the synthesized Q channel of `lba`, which the caller checked
+    // to be addressable (absolute time 00:00:00 to 99:59:74)
+    void synthesizeQ(int32_t lba, uint8_t* q) const noexcept;
+
+    // Extents of the tracks stored in file `fileIndex`, in track order
+    std::vector<TrackExtent> trackExtents(size_t fileIndex) const;
+
+    // Bodies of Disc::readSectorsInto() and Disc::readUserDataInto(), which
+    // add the error trace point
+    Status readSectorsInto(int32_t lba, int32_t count, std::span<uint8_t> out,
+                           std::span<TrackMode> modes) const noexcept;
+    Status readUserDataInto(int32_t lba, int32_t count, std::span<uint8_t> out,
+                            size_t* written) const noexcept;
+
+    // Reads [lba, lba + count) into `out`, bypassing read-ahead.
+    // Arguments are validated by the caller.
+    Status readDirect(int32_t lba, int32_t count, uint8_t* out, TrackMode* modes) const noexcept;
+
+    // Translates [lba, lba + count) into file reads targeting `out`, calling
+    // `visit(const ReadSegment&) -> Status` for each. Stops at the first failure.
+    template <typename Visit>
+    Status forEachSegment(int32_t lba, int32_t count, uint8_t* out, TrackMode* modes,
+                          Visit&& visit) const noexcept;
+};
+
+template <typename Visit>
+Status Disc::Impl::forEachSegment(int32_t lba, int32_t count, uint8_t* out, TrackMode* modes,
+                                  Visit&& visit) const noexcept
+{
+    int64_t endLba = static_cast<int64_t>(lba) + count;
+
+    // Split the range into runs that share an extent (and therefore a file
+    // and sector size); each stored run becomes a single read straight into
+    // `out`, and gaps are synthesized in place.
+    int32_t current = lba;
+    while (current < endLba) {
+        const LbaExtent* extent = findExtent(current);
+        if (!extent) return ErrorCode::LBAOutOfRange;
+
+        const Track* trk = extent->track;
+        int32_t runEnd = static_cast<int32_t>(std::min<int64_t>(endLba, extent->end));
+        int32_t runSectors = runEnd - current;
+        if (extent->isVirtual()) {
+            synthesizeGap(*trk, current, runSectors, rawSectors,
+                          out + static_cast<size_t>(current - lba) * RAW_SECTOR_SIZE,
+                          modes ? modes + (current - lba) : nullptr);
+            current = runEnd;
+            continue;
+        }
+
+        uint16_t ss = trk->sectorSize();
+        int64_t offset = trk->fileByteOffset()
+                       + static_cast<int64_t>(current - trk->fileStartLba()) * ss;
+
+        ReadSegment seg;
+        seg.file = fileHandles[trk->fileIndex()].get();
+        seg.slots = out + static_cast<size_t>(current - lba) * RAW_SECTOR_SIZE;
+        seg.mode = trk->mode();
+        seg.modes = modes ? modes + (current - lba) : nullptr;
+        seg.lba = current;
+        seg.swapSamples = seg.file->bigEndianSamples && trk->isAudio();
+
+        if (ss <= RAW_SECTOR_SIZE) {
+            // Cooked sectors are read packed at the tail of the run's output
+            // region, then spread forward to their 2352-byte slots in place.
+            seg.offset = offset;
+            seg.bytes = static_cast<int64_t>(runSectors) * ss;
+            seg.dst = seg.slots + (static_cast<int64_t>(runSectors) * RAW_SECTOR_SIZE - seg.bytes);
+            seg.sectors = runSectors;
+            seg.packedSize = ss;
+            seg.rawSectors = rawSectors && ss < RAW_SECTOR_SIZE && trk->isData();
+            if (auto status = visit(seg); !status) return status;
+        } else {
+            // Sectors with trailing subchannel data (CDG): keep the first 2352 bytes
+            for (int32_t i = 0; i < runSectors; ++i) {
+                ReadSegment one = seg;
+                one.offset = offset + static_cast<int64_t>(i) * ss;
+                one.slots = seg.slots + static_cast<size_t>(i) * RAW_SECTOR_SIZE;
+                one.dst = one.slots;
+                one.bytes = RAW_SECTOR_SIZE;
+                one.sectors = 1;
+                one.packedSize = RAW_SECTOR_SIZE;
+                one.modes = seg.modes ? seg.modes + i : nullptr;
+                if (auto status = visit(one); !status) return status;
+            }
+        }
+
+        current = runEnd;
+    }
+
+    return {};
+}
+
+} // namespace cuebin
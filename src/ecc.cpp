@@ -0,0 +1,288 @@
+#include "libcuebin/ecc.hpp"
+#include "libcuebin/msf.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace cuebin {
+
+namespace {
+
+struct EccTables {
+    // Slice-by-8 EDC: edc[k][i] advances byte i through k further zero bytes
+    std::array<std::array<uint32_t, 256>, 8> edc{};
+    std::array<uint8_t, 256> eccF{}; // Multiply by alpha in GF(2^8), poly 0x11D
+    std::array<uint8_t, 256> eccB{}; // Divide by (alpha + 1)
+    std::array<uint8_t, 256> gfLog{};
+};
+
+constexpr EccTables makeTables()
+{
+    EccTables t;
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t j = (i << 1) ^ ((i & 0x80) ? 0x11D : 0);
+        t.eccF[i] = static_cast<uint8_t>(j);
+        t.eccB[i ^ j] = static_cast<uint8_t>(i);
+
+        uint32_t edc = i;
+        for (int k = 0; k < 8; ++k) edc = (edc >> 1) ^ ((edc & 1) ? 0xD8018001 : 0);
+        t.edc[0][i] = edc;
+    }
+    for (size_t k = 1; k < 8; ++k) {
+        for (size_t i = 0; i < 256; ++i) {
+            uint32_t prev = t.edc[k - 1][i];
+            t.edc[k][i] = (prev >> 8) ^ t.edc[0][prev & 0xFF];
+        }
+    }
+
+    uint32_t x = 1;
+    for (size_t i = 0; i < 255; ++i) {
+        t.gfLog[x] = static_cast<uint8_t>(i);
+        x = t.eccF[x];
+    }
+    return t;
+}
+
+constexpr EccTables TABLES = makeTables();
+
+constexpr uint8_t SYNC_PATTERN[SYNC_SIZE] = {
+    0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+};
+
+constexpr uint8_t toBcd(uint8_t value) noexcept
+{
+    return static_cast<uint8_t>(((value / 10) << 4) | (value % 10));
+}
+
+// One RS parity pass over the 2340 bytes after the sync. P uses 86
+// columns of 24 bytes; Q 52 diagonals of 43 bytes.
+void eccBlock(const uint8_t* src, uint32_t majorCount, uint32_t minorCount,
+              uint32_t majorMult, uint32_t minorInc, uint8_t* dst) noexcept
+{
+    uint32_t size = majorCount * minorCount;
+    for (uint32_t major = 0; major < majorCount; ++major) {
+        uint32_t index = (major >> 1) * majorMult + (major & 1);
+        uint8_t a = 0;
+        uint8_t b = 0;
+        for (uint32_t minor = 0; minor < minorCount; ++minor) {
+            uint8_t v = src[index];
+            index += minorInc;
+            if (index >= size) index -= size;
+            a ^= v;
+            b ^= v;
+            a = TABLES.eccF[a];
+        }
+        a = TABLES.eccB[TABLES.eccF[a] ^ b];
+        dst[major] = a;
+        dst[major + majorCount] = a ^ b;
+    }
+}
+
+// Corrects at most one byte in each of the codewords eccBlock() produces,
+// using the two syndromes of the codeword. Returns false if any codeword
+// has an error it cannot locate.
+bool eccCorrectBlock(uint8_t* src, uint32_t majorCount, uint32_t minorCount,
+                     uint32_t majorMult, uint32_t minorInc, uint32_t parityOffset) noexcept
+{
+    uint32_t size = majorCount * minorCount;
+    uint32_t length = minorCount + 2;
+    bool ok = true;
+
+    for (uint32_t major = 0; major < majorCount; ++major) {
+        auto position = [&](uint32_t k) -> uint32_t {
+            if (k == minorCount) return parityOffset + major;
+            if (k == minorCount + 1) return parityOffset + major + majorCount;
+            return ((major >> 1) * majorMult + (major & 1) + k * minorInc) % size;
+        };
+
+        // s0 = sum of the bytes, s1 = sum of byte k * alpha^(length - 1 - k)
+        uint8_t s0 = 0;
+        uint8_t s1 = 0;
+        for (uint32_t k = 0; k < length; ++k) {
+            uint8_t v = src[position(k)];
+            s0 ^= v;
+            s1 = TABLES.eccF[s1] ^ v;
+        }
+        if (s0 == 0 && s1 == 0) continue;
+        if (s0 == 0 || s1 == 0) {
+            ok = false;
+            continue;
+        }
+
+        // A single error e at k gives s0 = e and s1 = e * alpha^(length - 1 - k)
+        uint32_t power = (TABLES.gfLog[s1] + 255 - TABLES.gfLog[s0]) % 255;
+        if (power >= length) {
+            ok = false;
+            continue;
+        }
+        src[position(length - 1 - power)] ^= s0;
+    }
+    return ok;
+}
+
+void storeEdc(uint8_t* dst, uint32_t edc) noexcept
+{
+    dst[0] = static_cast<uint8_t>(edc);
+    dst[1] = static_cast<uint8_t>(edc >> 8);
+    dst[2] = static_cast<uint8_t>(edc >> 16);
+    dst[3] = static_cast<uint8_t>(edc >> 24);
+}
+
+uint32_t loadEdc(const uint8_t* src) noexcept
+{
+    return static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8)
+         | (static_cast<uint32_t>(src[2]) << 16) | (static_cast<uint32_t>(src[3]) << 24);
+}
+
+// Where the EDC of `sector` lives and what it covers, by track mode and
+// (for Mode 2) the Form bit of the subheader. Returns false for sectors
+// without an EDC.
+bool edcRange(TrackMode mode, const uint8_t* sector, size_t& begin, size_t& end) noexcept
+{
+    switch (mode) {
+        case TrackMode::Mode1_2048:
+        case TrackMode::Mode1_2352:
+            begin = 0;
+            end = MODE1_EDC_OFFSET;
+            return true;
+        case TrackMode::Mode2_2336:
+        case TrackMode::Mode2_2352:
+        case TrackMode::CDI_2336:
+        case TrackMode::CDI_2352:
+            begin = SUBHEADER_OFFSET;
+            end = (sector[SUBHEADER_OFFSET + 2] & SUBMODE_FORM2) ? MODE2_FORM2_EDC_OFFSET
+                                                                 : MODE2_FORM1_EDC_OFFSET;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool edcMatches(TrackMode mode, const uint8_t* sector) noexcept
+{
+    size_t begin = 0;
+    size_t end = 0;
+    if (!edcRange(mode, sector, begin, end)) return true;
+
+    uint32_t stored = loadEdc(sector + end);
+    // The Form 2 EDC is optional; zero means it was not recorded
+    if (end == MODE2_FORM2_EDC_OFFSET && stored == 0) return true;
+    return computeEdc(std::span<const uint8_t>(sector + begin, end - begin)) == stored;
+}
+
+bool isZeroFilled(const uint8_t* data, size_t size) noexcept
+{
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] != 0) return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+uint32_t computeEdc(std::span<const uint8_t> data, uint32_t edc) noexcept
+{
+    const uint8_t* p = data.data();
+    size_t size = data.size();
+    const auto& t = TABLES.edc;
+
+    while (size >= 8) {
+        uint32_t lo = edc ^ loadEdc(p);
+        uint32_t hi = loadEdc(p + 4);
+        edc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+            ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        edc = (edc >> 8) ^ t[0][(edc ^ *p++) & 0xFF];
+    }
+    return edc;
+}
+
+bool correctEcc(RawSector sector) noexcept
+{
+    uint8_t* s = sector.data() + HEADER_OFFSET;
+    bool p = eccCorrectBlock(s, 86, 24, 2, 86, ECC_P_OFFSET - HEADER_OFFSET);
+    bool q = eccCorrectBlock(s, 52, 43, 86, 88, ECC_Q_OFFSET - HEADER_OFFSET);
+    return p && q;
+}
+
+SectorCheck checkSector(TrackMode mode, RawSector sector) noexcept
+{
+    // Mode 0 (empty) sectors carry no EDC whatever the track mode, but only
+    // a zero-filled body makes one: otherwise the mode byte itself may be bad
+    if (sector[HEADER_OFFSET + 3] == 0 && isZeroFilled(sector.data() + SUBHEADER_OFFSET,
+                                                       RAW_SECTOR_SIZE - SUBHEADER_OFFSET)) {
+        return SectorCheck::Ok;
+    }
+    if (edcMatches(mode, sector.data())) return SectorCheck::Ok;
+
+    size_t begin = 0;
+    size_t end = 0;
+    edcRange(mode, sector.data(), begin, end);
+    if (end == MODE2_FORM2_EDC_OFFSET) return SectorCheck::Unrecoverable; // No ECC in Form 2
+
+    // Alternate P and Q passes: each can fix what the other could not locate
+    bool mode2 = begin == SUBHEADER_OFFSET;
+    uint8_t header[4];
+    std::memcpy(header, sector.data() + HEADER_OFFSET, sizeof(header));
+    if (mode2) std::memset(sector.data() + HEADER_OFFSET, 0, sizeof(header));
+
+    constexpr int MAX_PASSES = 4;
+    bool repaired = false;
+    for (int pass = 0; pass < MAX_PASSES && !repaired; ++pass) {
+        correctEcc(sector);
+        // A corrected subheader may have changed the form
+        repaired = edcMatches(mode, sector.data());
+    }
+
+    if (mode2) std::memcpy(sector.data() + HEADER_OFFSET, header, sizeof(header));
+    return repaired ? SectorCheck::Repairable : SectorCheck::Unrecoverable;
+}
+
+void computeEcc(RawSector sector) noexcept
+{
+    uint8_t* s = sector.data();
+    eccBlock(s + HEADER_OFFSET, 86, 24, 2, 86, s + ECC_P_OFFSET);
+    eccBlock(s + HEADER_OFFSET, 52, 43, 86, 88, s + ECC_Q_OFFSET);
+}
+
+void writeSectorHeader(int32_t lba, uint8_t mode, RawSector sector) noexcept
+{
+    MSF msf = MSF::toPhysicalMsf(lba);
+    std::memcpy(sector.data(), SYNC_PATTERN, SYNC_SIZE);
+    sector[HEADER_OFFSET + 0] = toBcd(msf.minute);
+    sector[HEADER_OFFSET + 1] = toBcd(msf.second);
+    sector[HEADER_OFFSET + 2] = toBcd(msf.frame);
+    sector[HEADER_OFFSET + 3] = mode;
+}
+
+void encodeMode1Sector(int32_t lba, RawSector sector) noexcept
+{
+    writeSectorHeader(lba, 1, sector);
+    storeEdc(sector.data() + MODE1_EDC_OFFSET,
+             computeEdc(sector.first(MODE1_EDC_OFFSET)));
+    std::memset(sector.data() + MODE1_EDC_OFFSET + 4, 0, ECC_P_OFFSET - MODE1_EDC_OFFSET - 4);
+    computeEcc(sector);
+}
+
+void encodeMode2Form1Sector(int32_t lba, RawSector sector) noexcept
+{
+    storeEdc(sector.data() + MODE2_FORM1_EDC_OFFSET,
+             computeEdc(sector.subspan(SUBHEADER_OFFSET, MODE2_FORM1_EDC_OFFSET - SUBHEADER_OFFSET)));
+
+    // Form 1 ECC is computed with a zeroed header so sectors can be relocated
+    std::memset(sector.data() + HEADER_OFFSET, 0, 4);
+    computeEcc(sector);
+    writeSectorHeader(lba, 2, sector);
+}
+
+void encodeMode2Form2Sector(int32_t lba, RawSector sector) noexcept
+{
+    writeSectorHeader(lba, 2, sector);
+    storeEdc(sector.data() + MODE2_FORM2_EDC_OFFSET,
+             computeEdc(sector.subspan(SUBHEADER_OFFSET, MODE2_FORM2_EDC_OFFSET - SUBHEADER_OFFSET)));
+}
+
+} // namespace cuebin
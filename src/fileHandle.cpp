@@ -0,0 +1,181 @@
+#include "fileHandle.hpp"
+#include "blockCacheInternal.hpp"
+#include "traceInternal.hpp"
+
+#include "libcuebin/blockCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <spdlog/spdlog.h>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace cuebin {
+
+std::optional<FileStamp> statFile(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) return std::nullopt;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return std::nullopt;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return std::nullopt;
+    return FileStamp{static_cast<int64_t>(size),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count()};
+#else
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return std::nullopt;
+#ifdef __APPLE__
+    const auto& mtime = st.st_mtimespec;
+#else
+    const auto& mtime = st.st_mtim;
+#endif
+    return FileStamp{static_cast<int64_t>(st.st_size),
+                     static_cast<int64_t>(mtime.tv_sec) * 1'000'000'000 + mtime.tv_nsec};
+#endif
+}
+
+FileHandle::~FileHandle()
+{
+    if (cacheFileId != 0) detail::blockCacheReleaseFileId(cacheFileId);
+}
+
+bool FileHandle::ensureOpen() const
+{
+    if (compressed) return true; // Opened while loading the disc
+
+    std::call_once(openFlag, [this]() {
+        switch (backend) {
+            case IoBackend::Stream:
+                stream.open(path, std::ios::binary);
+                opened = stream.is_open();
+                break;
+            case IoBackend::Mmap:
+                opened = mapping.open(path);
+                break;
+            case IoBackend::Positional:
+                opened = raw.open(path);
+                break;
+        }
+        LIBCUEBIN_TRACE(fileOpen, path, index, opened);
+        if (opened) {
+            if (collectStats) stats.lazyOpens.fetch_add(1, std::memory_order_relaxed);
+            spdlog::debug("Opened file: {}", path.string());
+        }
+    });
+    return opened;
+}
+
+const RawFile* FileHandle::asyncFile() const
+{
+    if (backend == IoBackend::Positional) {
+        return ensureOpen() ? &raw : nullptr;
+    }
+    std::call_once(asyncFlag, [this]() {
+        if (asyncRaw.open(path)) {
+            spdlog::debug("Opened file for async I/O: {}", path.string());
+        }
+    });
+    return asyncRaw.isOpen() ? &asyncRaw : nullptr;
+}
+
+int64_t FileHandle::readAt(int64_t offset, uint8_t* dst, int64_t size) const
+{
+    if (!collectStats) return readCached(offset, dst, size);
+    auto start = std::chrono::steady_clock::now();
+    int64_t got = readCached(offset, dst, size);
+    stats.recordRead(offset, size, got, elapsedNs(start));
+    return got;
+}
+
+int64_t FileHandle::readCached(int64_t offset, uint8_t* dst, int64_t size) const
+{
+    if (!useCache) return readUncached(offset, dst, size);
+    if (offset < 0) return -1;
+
+    constexpr auto blockSize = static_cast<int64_t>(BlockCache::BLOCK_SIZE);
+
+    int64_t total = 0;
+    while (total < size) {
+        int64_t pos = offset + total;
+        int64_t blockIndex = pos / blockSize;
+        int64_t inBlock = pos % blockSize;
+        int64_t want = std::min(size - total, blockSize - inBlock);
+
+        int64_t n = detail::blockCacheLookup(cacheFileId, blockIndex, inBlock, dst + total, want);
+        if (n >= 0) {
+            LIBCUEBIN_TRACE(cacheHit, index, blockIndex);
+        } else {
+            LIBCUEBIN_TRACE(cacheMiss, index, blockIndex);
+            // Miss: load the whole aligned block, serve from it, then cache it.
+            // Without memory for a block, the rest is read uncached.
+            std::unique_ptr<uint8_t[]> block(new (std::nothrow) uint8_t[static_cast<size_t>(blockSize)]);
+            if (!block) {
+                int64_t rest = readUncached(pos, dst + total, size - total);
+                if (rest < 0) return total > 0 ? total : -1;
+                return total + rest;
+            }
+            int64_t loaded = readUncached(blockIndex * blockSize, block.get(), blockSize);
+            if (loaded < 0) return total > 0 ? total : -1;
+
+            n = std::clamp<int64_t>(loaded - inBlock, 0, want);
+            if (n > 0) std::memcpy(dst + total, block.get() + inBlock, static_cast<size_t>(n));
+            detail::blockCacheInsert(cacheFileId, blockIndex, std::move(block),
+                                     static_cast<uint32_t>(loaded));
+        }
+
+        total += n;
+        if (n < want) break; // End of file
+    }
+    return total;
+}
+
+int64_t FileHandle::readPositional(int64_t offset, uint8_t* dst, int64_t size) const
+{
+    if (compressed) return compressed->readAt(offset, dst, size);
+    const RawFile* file = asyncFile();
+    return file ? file->readAt(offset, dst, size) : -1;
+}
+
+int64_t FileHandle::readUncached(int64_t offset, uint8_t* dst, int64_t size) const
+{
+    if (compressed) return compressed->readAt(offset, dst, size);
+
+    if (backend == IoBackend::Mmap) {
+        auto mapped = static_cast<int64_t>(mapping.size());
+        if (offset < 0 || offset > mapped) return -1;
+        int64_t n = std::min(size, mapped - offset);
+        if (n > 0) std::memcpy(dst, mapping.data() + offset, static_cast<size_t>(n));
+        return n;
+    }
+
+    if (backend == IoBackend::Positional) {
+        return raw.readAt(offset, dst, size);
+    }
+
+    // Contention is timed only when the lock is actually taken
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        auto start = std::chrono::steady_clock::now();
+        lock.lock();
+        if (collectStats) stats.mutexWaitNs.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+    }
+
+    stream.seekg(offset);
+    if (!stream) {
+        stream.clear();
+        return -1;
+    }
+
+    stream.read(reinterpret_cast<char*>(dst), size);
+    int64_t n = stream.gcount();
+    if (!stream) stream.clear();
+    return n;
+}
+
+} // namespace cuebin
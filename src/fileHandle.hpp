@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+
+#include "libcuebin/disc.hpp"
+#include "compressedFile.hpp"
+#include "ioStatsInternal.hpp"
+#include "mappedFile.hpp"
+#include "rawFile.hpp"
+
+namespace cuebin {
+
+// Identity of a file's contents on disk, as far as metadata can tell
+struct FileStamp {
+    int64_t size = 0;
+    int64_t mtimeNs = 0; // Modification time, nanoseconds since the epoch
+
+    bool operator==(const FileStamp&) const = default;
+};
+
+// One stat call. Returns nullopt if `path` is missing or not a regular file.
+std::optional<FileStamp> statFile(const std::filesystem::path& path);
+
+// A BIN file referenced by the CUE sheet. Opened lazily on first access.
+struct FileHandle {
+    std::filesystem::path path;
+    size_t index = 0; // Position of its FILE entry in the sheet
+    int64_t fileSize = 0;
+    FileStamp stamp; // Of the file on disk when the disc was loaded
+    // Sector data region: past the header of WAVE/AIFF files, the whole file otherwise
+    int64_t dataOffset = 0;
+    int64_t dataSize = 0;
+    bool bigEndianSamples = false; // AIFF: audio is swapped to CD byte order on read
+    IoBackend backend = IoBackend::Stream;
+    bool useCache = false;
+    uint64_t cacheFileId = 0;
+    mutable std::once_flag openFlag;
+    mutable bool opened = false;
+    mutable std::ifstream stream;
+    mutable MappedFile mapping;
+    mutable RawFile raw;
+    mutable std::mutex mutex;
+    mutable std::once_flag asyncFlag;
+    mutable RawFile asyncRaw;
+    // Set for .cbc images; every read then goes through its chunk cache
+    std::unique_ptr<CompressedFile> compressed;
+    // See DiscOptions::ioStats
+    bool collectStats = true;
+    mutable IoStatsCounters stats;
+
+    // Releases the block cache identifier, if the file took one
+    ~FileHandle();
+
+    // Opens the file with the configured backend on first call.
+    // Returns false if the file could not be opened.
+    bool ensureOpen() const;
+
+    // Reads up to `size` bytes at `offset` into `dst`, through the block
+    // cache when enabled, and records the read in `stats`. Returns the
+    // number of bytes read (short at end of file), or -1 if `offset`
+    // cannot be reached.
+    int64_t readAt(int64_t offset, uint8_t* dst, int64_t size) const;
+
+    // Credits `sectors` read through readAt() to this file's stats
+    void countSectors(int32_t sectors) const noexcept
+    {
+        if (collectStats) stats.sectorsRead.fetch_add(static_cast<uint64_t>(sectors), std::memory_order_relaxed);
+    }
+
+    // Raw descriptor for asynchronous I/O, opened on first use whatever the
+    // backend. Returns nullptr if the file could not be opened.
+    const RawFile* asyncFile() const;
+
+    // Same as readAt(), always going straight to the backend.
+    int64_t readUncached(int64_t offset, uint8_t* dst, int64_t size) const;
+
+    // Lock-free read for worker threads: a positional read on the async
+    // descriptor, or the decompressor for .cbc images. Bypasses the block cache.
+    int64_t readPositional(int64_t offset, uint8_t* dst, int64_t size) const;
+
+private:
+    int64_t readCached(int64_t offset, uint8_t* dst, int64_t size) const;
+};
+
+} // namespace cuebin
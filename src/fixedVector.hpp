@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace cuebin {
+
+// Vector with inline storage for up to N elements. It never allocates, so a
+// table of this type costs nothing past the object that embeds it. Callers
+// check full() before adding.
+template <typename T, size_t N>
+class FixedVector {
+public:
+    FixedVector() noexcept = default;
+    ~FixedVector() { clear(); }
+
+    FixedVector(const FixedVector& other)
+    {
+        for (const auto& v : other) emplace_back(v);
+    }
+
+    FixedVector& operator=(const FixedVector& other)
+    {
+        if (this != &other) {
+            clear();
+            for (const auto& v : other) emplace_back(v);
+        }
+        return *this;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        T* slot = ::new (static_cast<void*>(m_storage + m_size * sizeof(T))) T(std::forward<Args>(args)...);
+        ++m_size;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void clear() noexcept
+    {
+        for (size_t i = m_size; i > 0; --i) data()[i - 1].~T();
+        m_size = 0;
+    }
+
+    static constexpr size_t capacity() noexcept { return N; }
+    size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+    bool full() const noexcept { return m_size == N; }
+
+    T* data() noexcept { return std::launder(reinterpret_cast<T*>(m_storage)); }
+    const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(m_storage)); }
+
+    T* begin() noexcept { return data(); }
+    T* end() noexcept { return data() + m_size; }
+    const T* begin() const noexcept { return data(); }
+    const T* end() const noexcept { return data() + m_size; }
+
+    T& operator[](size_t i) noexcept { return data()[i]; }
+    const T& operator[](size_t i) const noexcept { return data()[i]; }
+    T& front() noexcept { return data()[0]; }
+    const T& front() const noexcept { return data()[0]; }
+    T& back() noexcept { return data()[m_size - 1]; }
+    const T& back() const noexcept { return data()[m_size - 1]; }
+
+private:
+    alignas(T) std::byte m_storage[N * sizeof(T)];
+    size_t m_size = 0;
+};
+
+} // namespace cuebin
@@ -0,0 +1,366 @@
+#include "libcuebin/hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LIBCUEBIN_HAS_PCLMUL 1
+#include <immintrin.h>
+#endif
+
+namespace cuebin {
+
+namespace {
+
+// Slice-by-8 tables for the reflected polynomial 0xEDB88320
+constexpr std::array<std::array<uint32_t, 256>, 8> makeCrcTables()
+{
+    std::array<std::array<uint32_t, 256>, 8> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c >> 1) ^ ((c & 1) ? 0xEDB88320u : 0);
+        t[0][i] = c;
+    }
+    for (size_t k = 1; k < 8; ++k) {
+        for (size_t i = 0; i < 256; ++i) t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+    }
+    return t;
+}
+
+constexpr auto CRC_TABLES = makeCrcTables();
+
+uint32_t loadLe32(const uint8_t* p) noexcept
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+         | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t loadBe32(const uint8_t* p) noexcept
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16)
+         | (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint32_t rotl(uint32_t x, int n) noexcept
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+// `crc` is the raw (pre-inverted) register in both kernels
+uint32_t crc32Table(const uint8_t* p, size_t size, uint32_t crc) noexcept
+{
+    const auto& t = CRC_TABLES;
+    while (size >= 8) {
+        uint32_t lo = crc ^ loadLe32(p);
+        uint32_t hi = loadLe32(p + 4);
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+            ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0) crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    return crc;
+}
+
+#ifdef LIBCUEBIN_HAS_PCLMUL
+
+// Folds 64 bytes per iteration with carry-less multiplies, then Barrett
+// reduces to 32 bits (Intel, "Fast CRC Computation Using PCLMULQDQ").
+// Requires size >= 64 and a multiple of 16.
+__attribute__((target("pclmul,sse4.1")))
+uint32_t crc32Pclmul(const uint8_t* p, size_t size, uint32_t crc) noexcept
+{
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    auto load = [](const uint8_t* q) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(q)); };
+
+    __m128i x1 = _mm_xor_si128(load(p), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    __m128i x2 = load(p + 16);
+    __m128i x3 = load(p + 32);
+    __m128i x4 = load(p + 48);
+    __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    p += 64;
+    size -= 64;
+
+    while (size >= 64) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), load(p));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), load(p + 16));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), load(p + 32));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), load(p + 48));
+        p += 64;
+        size -= 64;
+    }
+
+    // Fold the four lanes into one
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    for (__m128i next : {x2, x3, x4}) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, next), x5);
+    }
+
+    while (size >= 16) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, load(p)), x5);
+        p += 16;
+        size -= 16;
+    }
+
+    // 128 -> 64 bits
+    __m128i x2r = _mm_clmulepi64_si128(x1, x0, 0x10);
+    __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2r);
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2r = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2r);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2r = _mm_and_si128(x1, mask);
+    x2r = _mm_clmulepi64_si128(x2r, x0, 0x10);
+    x2r = _mm_and_si128(x2r, mask);
+    x2r = _mm_clmulepi64_si128(x2r, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2r);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+bool cpuHasPclmul() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+    return supported;
+}
+
+#endif
+
+std::string toHex(std::span<const uint8_t> bytes)
+{
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(bytes.size() * 2);
+    for (uint8_t b : bytes) {
+        out += DIGITS[b >> 4];
+        out += DIGITS[b & 0xF];
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+uint32_t crc32(std::span<const uint8_t> data, uint32_t crc) noexcept
+{
+    const uint8_t* p = data.data();
+    size_t size = data.size();
+    crc = ~crc;
+
+#ifdef LIBCUEBIN_HAS_PCLMUL
+    if (size >= 64 && cpuHasPclmul()) {
+        size_t bulk = size & ~size_t{15};
+        crc = crc32Pclmul(p, bulk, crc);
+        p += bulk;
+        size -= bulk;
+    }
+#endif
+
+    return ~crc32Table(p, size, crc);
+}
+
+// --- MD5 (RFC 1321) ---
+
+Md5::Md5() noexcept : m_state{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476} {}
+
+void Md5::block(const uint8_t* p) noexcept
+{
+    static constexpr uint32_t K[64] = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391,
+    };
+    static constexpr int S[64] = {
+        7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+        5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+        4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+        6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21,
+    };
+
+    uint32_t m[16];
+    for (int i = 0; i < 16; ++i) m[i] = loadLe32(p + i * 4);
+
+    uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t f;
+        int g;
+        if (i < 16) {
+            f = (b & c) | (~b & d);
+            g = i;
+        } else if (i < 32) {
+            f = (d & b) | (~d & c);
+            g = (5 * i + 1) % 16;
+        } else if (i < 48) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) % 16;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) % 16;
+        }
+        uint32_t next = b + rotl(a + f + K[i] + m[g], S[i]);
+        a = d;
+        d = c;
+        c = b;
+        b = next;
+    }
+
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+}
+
+void Md5::update(std::span<const uint8_t> data) noexcept
+{
+    const uint8_t* p = data.data();
+    size_t size = data.size();
+    size_t used = static_cast<size_t>(m_length % 64);
+    m_length += size;
+
+    if (used > 0) {
+        size_t take = std::min(size, 64 - used);
+        std::memcpy(m_buffer.data() + used, p, take);
+        p += take;
+        size -= take;
+        if (used + take < 64) return;
+        block(m_buffer.data());
+    }
+    for (; size >= 64; p += 64, size -= 64) block(p);
+    std::memcpy(m_buffer.data(), p, size);
+}
+
+std::array<uint8_t, 16> Md5::finish() noexcept
+{
+    uint64_t bits = m_length * 8;
+    uint8_t pad[72] = {0x80};
+    size_t padLength = (m_length % 64 < 56) ? 56 - m_length % 64 : 120 - m_length % 64;
+    for (int i = 0; i < 8; ++i) pad[padLength + i] = static_cast<uint8_t>(bits >> (8 * i));
+    update(std::span<const uint8_t>(pad, padLength + 8));
+
+    std::array<uint8_t, 16> digest;
+    for (int i = 0; i < 4; ++i) {
+        for (int k = 0; k < 4; ++k) digest[i * 4 + k] = static_cast<uint8_t>(m_state[i] >> (8 * k));
+    }
+    return digest;
+}
+
+// --- SHA-1 (FIPS 180-4) ---
+
+Sha1::Sha1() noexcept : m_state{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0} {}
+
+void Sha1::block(const uint8_t* p) noexcept
+{
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i) w[i] = loadBe32(p + i * 4);
+    for (int i = 16; i < 80; ++i) w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+    uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3], e = m_state[4];
+    for (int i = 0; i < 80; ++i) {
+        uint32_t f;
+        uint32_t k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+        uint32_t next = rotl(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rotl(b, 30);
+        b = a;
+        a = next;
+    }
+
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+}
+
+void Sha1::update(std::span<const uint8_t> data) noexcept
+{
+    const uint8_t* p = data.data();
+    size_t size = data.size();
+    size_t used = static_cast<size_t>(m_length % 64);
+    m_length += size;
+
+    if (used > 0) {
+        size_t take = std::min(size, 64 - used);
+        std::memcpy(m_buffer.data() + used, p, take);
+        p += take;
+        size -= take;
+        if (used + take < 64) return;
+        block(m_buffer.data());
+    }
+    for (; size >= 64; p += 64, size -= 64) block(p);
+    std::memcpy(m_buffer.data(), p, size);
+}
+
+std::array<uint8_t, 20> Sha1::finish() noexcept
+{
+    uint64_t bits = m_length * 8;
+    uint8_t pad[72] = {0x80};
+    size_t padLength = (m_length % 64 < 56) ? 56 - m_length % 64 : 120 - m_length % 64;
+    for (int i = 0; i < 8; ++i) pad[padLength + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    update(std::span<const uint8_t>(pad, padLength + 8));
+
+    std::array<uint8_t, 20> digest;
+    for (int i = 0; i < 5; ++i) {
+        for (int k = 0; k < 4; ++k) digest[i * 4 + k] = static_cast<uint8_t>(m_state[i] >> (24 - 8 * k));
+    }
+    return digest;
+}
+
+std::string HashDigest::crc32Hex() const
+{
+    uint8_t bytes[4] = {
+        static_cast<uint8_t>(crc32 >> 24), static_cast<uint8_t>(crc32 >> 16),
+        static_cast<uint8_t>(crc32 >> 8), static_cast<uint8_t>(crc32),
+    };
+    return toHex(bytes);
+}
+
+std::string HashDigest::md5Hex() const
+{
+    return toHex(md5);
+}
+
+std::string HashDigest::sha1Hex() const
+{
+    return toHex(sha1);
+}
+
+} // namespace cuebin
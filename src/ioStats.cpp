@@ -0,0 +1,66 @@
+#include "libcuebin/disc.hpp"
+#include "libcuebin/ioStats.hpp"
+
+#include "discImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cuebin {
+
+uint64_t LatencyHistogram::count() const noexcept
+{
+    uint64_t total = 0;
+    for (uint64_t n : buckets) total += n;
+    return total;
+}
+
+uint64_t LatencyHistogram::quantileNs(double q) const noexcept
+{
+    uint64_t total = count();
+    if (total == 0) return 0;
+    // Rank of the read at quantile q, 1-based
+    auto rank = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total)));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return bucketUpperBoundNs(i);
+    }
+    return bucketUpperBoundNs(BUCKET_COUNT - 1);
+}
+
+IoCounters& IoCounters::operator+=(const IoCounters& other) noexcept
+{
+    sectorsRead += other.sectorsRead;
+    bytesRead += other.bytesRead;
+    readCalls += other.readCalls;
+    seeks += other.seeks;
+    failedReads += other.failedReads;
+    lazyOpens += other.lazyOpens;
+    mutexWaitNs += other.mutexWaitNs;
+    for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+        latency.buckets[i] += other.latency.buckets[i];
+    }
+    return *this;
+}
+
+DiscIoStats Disc::ioStats() const
+{
+    DiscIoStats stats;
+    stats.files.reserve(m_impl->fileHandles.size());
+    for (const auto& handle : m_impl->fileHandles) {
+        FileIoStats& file = stats.files.emplace_back();
+        file.path = handle->path;
+        handle->stats.snapshot(file.counters);
+        stats.total += file.counters;
+    }
+    return stats;
+}
+
+void Disc::resetIoStats() noexcept
+{
+    for (const auto& handle : m_impl->fileHandles) handle->stats.reset();
+}
+
+} // namespace cuebin
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+#include "libcuebin/ioStats.hpp"
+
+namespace cuebin {
+
+// Live counters of one file. Updated with relaxed atomics from any reading
+// thread; a snapshot is consistent per counter, not across counters.
+// Aligned so that files read by different threads never share a cache line.
+struct alignas(64) IoStatsCounters {
+    std::atomic<uint64_t> sectorsRead{0};
+    std::atomic<uint64_t> bytesRead{0};
+    std::atomic<uint64_t> readCalls{0};
+    std::atomic<uint64_t> seeks{0};
+    std::atomic<uint64_t> failedReads{0};
+    std::atomic<uint64_t> lazyOpens{0};
+    std::atomic<uint64_t> mutexWaitNs{0};
+    std::atomic<int64_t> nextOffset{0}; // Where the previous read ended
+    std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKET_COUNT> latency{};
+
+    static size_t bucketFor(uint64_t ns) noexcept
+    {
+        return std::min<size_t>(static_cast<size_t>(std::bit_width(ns)), LatencyHistogram::BUCKET_COUNT - 1);
+    }
+
+    void add(std::atomic<uint64_t>& counter, uint64_t n) noexcept
+    {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // One read call of `size` bytes at `offset` that returned `got`
+    void recordRead(int64_t offset, int64_t size, int64_t got, uint64_t ns) noexcept
+    {
+        add(readCalls, 1);
+        if (got < 0) {
+            add(failedReads, 1);
+        } else {
+            add(bytesRead, static_cast<uint64_t>(got));
+        }
+        if (nextOffset.exchange(offset + size, std::memory_order_relaxed) != offset) add(seeks, 1);
+        add(latency[bucketFor(ns)], 1);
+    }
+
+    void snapshot(IoCounters& out) const noexcept
+    {
+        auto load = [](const std::atomic<uint64_t>& c) { return c.load(std::memory_order_relaxed); };
+        out.sectorsRead = load(sectorsRead);
+        out.bytesRead = load(bytesRead);
+        out.readCalls = load(readCalls);
+        out.seeks = load(seeks);
+        out.failedReads = load(failedReads);
+        out.lazyOpens = load(lazyOpens);
+        out.mutexWaitNs = load(mutexWaitNs);
+        for (size_t i = 0; i < latency.size(); ++i) out.latency.buckets[i] = load(latency[i]);
+    }
+
+    void reset() noexcept
+    {
+        for (auto* c : {&sectorsRead, &bytesRead, &readCalls, &seeks, &failedReads, &lazyOpens, &mutexWaitNs}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+        for (auto& c : latency) c.store(0, std::memory_order_relaxed);
+    }
+};
+
+inline uint64_t elapsedNs(std::chrono::steady_clock::time_point start) noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace cuebin
@@ -0,0 +1,199 @@
+#include "ioUring.hpp"
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace cuebin {
+
+namespace {
+
+int enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete,
+                                      flags, nullptr, 0));
+}
+
+unsigned loadAcquire(unsigned* p) noexcept
+{
+    return std::atomic_ref<unsigned>(*p).load(std::memory_order_acquire);
+}
+
+void storeRelease(unsigned* p, unsigned v) noexcept
+{
+    std::atomic_ref<unsigned>(*p).store(v, std::memory_order_release);
+}
+
+// Calls left before an injected submit() failure, or -1 for none
+std::atomic<int> g_submitFailureCountdown{-1};
+
+bool injectedSubmitFailure() noexcept
+{
+    if (g_submitFailureCountdown.load(std::memory_order_relaxed) < 0) return false;
+    return g_submitFailureCountdown.fetch_sub(1, std::memory_order_relaxed) == 0;
+}
+
+} // anonymous namespace
+
+void detail::failIoUringSubmit(unsigned skip) noexcept
+{
+    g_submitFailureCountdown.store(static_cast<int>(skip), std::memory_order_relaxed);
+}
+
+IoUring::~IoUring()
+{
+    if (m_sqes) ::munmap(m_sqes, m_sqesSize);
+    if (m_cqRing && m_cqRing != m_sqRing) ::munmap(m_cqRing, m_cqRingSize);
+    if (m_sqRing) ::munmap(m_sqRing, m_sqRingSize);
+    if (m_fd >= 0) ::close(m_fd);
+}
+
+bool IoUring::init(uint32_t entries)
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) return false;
+    m_fd = fd;
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+    }
+
+    void* sq = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) return false;
+    m_sqRing = sq;
+
+    if (singleMmap) {
+        m_cqRing = m_sqRing;
+    } else {
+        void* cq = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED) return false;
+        m_cqRing = cq;
+    }
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) return false;
+    m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sqBase = static_cast<char*>(m_sqRing);
+    m_sqHead = reinterpret_cast<unsigned*>(sqBase + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(sqBase + params.sq_off.tail);
+    m_sqMask = reinterpret_cast<unsigned*>(sqBase + params.sq_off.ring_mask);
+    m_sqArray = reinterpret_cast<unsigned*>(sqBase + params.sq_off.array);
+    m_sqEntries = params.sq_entries;
+    m_sqLocalTail = *m_sqTail;
+
+    auto* cqBase = static_cast<char*>(m_cqRing);
+    m_cqHead = reinterpret_cast<unsigned*>(cqBase + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cqBase + params.cq_off.tail);
+    m_cqMask = reinterpret_cast<unsigned*>(cqBase + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(cqBase + params.cq_off.cqes);
+
+    return true;
+}
+
+io_uring_sqe* IoUring::nextSqe() noexcept
+{
+    unsigned head = loadAcquire(m_sqHead);
+    if (m_sqLocalTail - head >= m_sqEntries) return nullptr;
+
+    unsigned index = m_sqLocalTail & *m_sqMask;
+    io_uring_sqe* sqe = &m_sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    m_sqArray[index] = index;
+    ++m_sqLocalTail;
+    ++m_toSubmit;
+    return sqe;
+}
+
+bool IoUring::prepareReadv(int fd, const iovec* iov, int64_t offset, uint64_t userData) noexcept
+{
+    io_uring_sqe* sqe = nextSqe();
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->off = static_cast<uint64_t>(offset);
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = 1;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::prepareNop(uint64_t userData) noexcept
+{
+    io_uring_sqe* sqe = nextSqe();
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_NOP;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::submit() noexcept
+{
+    if (injectedSubmitFailure()) {
+        errno = EIO;
+        return false;
+    }
+    storeRelease(m_sqTail, m_sqLocalTail);
+    while (m_toSubmit > 0) {
+        int submitted = enter(m_fd, m_toSubmit, 0, 0);
+        if (submitted < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+            return false;
+        }
+        m_toSubmit -= static_cast<unsigned>(submitted);
+    }
+    return true;
+}
+
+size_t IoUring::discardUnsubmitted() noexcept
+{
+    // Without SQPOLL the kernel only reads the submission queue inside
+    // io_uring_enter(), so entries past its head can be taken back
+    unsigned head = loadAcquire(m_sqHead);
+    unsigned dropped = m_sqLocalTail - head;
+    m_sqLocalTail = head;
+    m_toSubmit = 0;
+    storeRelease(m_sqTail, head);
+    return dropped;
+}
+
+size_t IoUring::reap(Completion* out, size_t max, bool wait) noexcept
+{
+    unsigned head = *m_cqHead;
+    if (wait && head == loadAcquire(m_cqTail)) {
+        while (enter(m_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno == EINTR) {}
+    }
+
+    unsigned tail = loadAcquire(m_cqTail);
+    size_t n = 0;
+    while (head != tail && n < max) {
+        const io_uring_cqe& cqe = m_cqes[head & *m_cqMask];
+        out[n++] = {cqe.user_data, cqe.res};
+        ++head;
+    }
+    storeRelease(m_cqHead, head);
+    return n;
+}
+
+} // namespace cuebin
+
+#endif // LIBCUEBIN_HAS_IO_URING
@@ -0,0 +1,88 @@
+#pragma once
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define LIBCUEBIN_HAS_IO_URING 1
+#endif
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+
+#include <cstddef>
+#include <cstdint>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct iovec;
+
+namespace cuebin {
+
+// Minimal io_uring ring driven through raw syscalls (no liburing).
+// One thread may submit and one other thread may reap concurrently;
+// multiple submitters must serialize externally.
+class IoUring {
+public:
+    struct Completion {
+        uint64_t userData;
+        int32_t result;
+    };
+
+    IoUring() = default;
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // Returns false if io_uring is unavailable (old kernel, seccomp, ...).
+    bool init(uint32_t entries);
+
+    // Queue an operation; returns false if the submission queue is full.
+    bool prepareReadv(int fd, const iovec* iov, int64_t offset, uint64_t userData) noexcept;
+    bool prepareNop(uint64_t userData) noexcept;
+
+    // Hands every queued operation to the kernel. Returns false on a hard
+    // error, leaving whatever the kernel did not take still queued.
+    bool submit() noexcept;
+
+    // Withdraws the operations queued but not yet taken by the kernel, the
+    // most recently prepared ones. Returns how many were dropped.
+    size_t discardUnsubmitted() noexcept;
+
+    // Copies up to `max` completions into `out`, blocking for at least one
+    // if `wait` is set. Returns the number copied.
+    size_t reap(Completion* out, size_t max, bool wait) noexcept;
+
+private:
+    io_uring_sqe* nextSqe() noexcept;
+
+    int m_fd = -1;
+    void* m_sqRing = nullptr;
+    void* m_cqRing = nullptr;
+    size_t m_sqRingSize = 0;
+    size_t m_cqRingSize = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    size_t m_sqesSize = 0;
+
+    unsigned* m_sqHead = nullptr;
+    unsigned* m_sqTail = nullptr;
+    unsigned* m_sqMask = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned m_sqEntries = 0;
+    unsigned m_sqLocalTail = 0;
+    unsigned m_toSubmit = 0;
+
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned* m_cqMask = nullptr;
+    io_uring_cqe* m_cqes = nullptr;
+};
+
+namespace detail {
+
+// Test hook: makes one submit() fail as a hard error after `skip` more
+// calls have succeeded, without handing anything to the kernel
+void failIoUringSubmit(unsigned skip = 0) noexcept;
+
+} // namespace detail
+
+} // namespace cuebin
+
+#endif // LIBCUEBIN_HAS_IO_URING
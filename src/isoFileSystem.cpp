@@ -0,0 +1,414 @@
+#include "libcuebin/isoFileSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+
+namespace cuebin {
+
+namespace {
+
+constexpr size_t ISO_BLOCK_SIZE = 2048;
+constexpr int32_t VOLUME_DESCRIPTOR_LBA = 16;
+constexpr uint8_t DESCRIPTOR_PRIMARY = 1;
+constexpr uint8_t DESCRIPTOR_TERMINATOR = 255;
+constexpr uint8_t FLAG_DIRECTORY = 0x02;
+constexpr size_t MIN_DIRECTORY_RECORD = 34;
+
+uint16_t readLe16(const uint8_t* p) noexcept
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readLe32(const uint8_t* p) noexcept
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+         | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Strips the ";1" version and the trailing '.' of extensionless names
+std::string_view trimIdentifier(std::string_view id) noexcept
+{
+    if (auto semi = id.find(';'); semi != std::string_view::npos) id = id.substr(0, semi);
+    if (!id.empty() && id.back() == '.') id.remove_suffix(1);
+    return id;
+}
+
+// Canonical index key: upper case, '/'-separated, no device prefix, no
+// leading/trailing/doubled separators, no version suffixes. Root is "".
+std::string normalizePath(std::string_view path)
+{
+    if (auto colon = path.find(':'); colon != std::string_view::npos) path = path.substr(colon + 1);
+
+    std::string key;
+    key.reserve(path.size());
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find_first_of("/\\", start);
+        if (end == std::string_view::npos) end = path.size();
+
+        std::string_view component = trimIdentifier(path.substr(start, end - start));
+        if (!component.empty()) {
+            if (!key.empty()) key += '/';
+            for (char c : component) {
+                key += (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+            }
+        }
+        start = end + 1;
+    }
+    return key;
+}
+
+std::string joinPath(const std::string& parent, std::string_view name)
+{
+    return parent.empty() ? normalizePath(name) : parent + '/' + normalizePath(name);
+}
+
+std::string parentOf(const std::string& key)
+{
+    auto slash = key.rfind('/');
+    return slash == std::string::npos ? std::string() : key.substr(0, slash);
+}
+
+Error readError(const std::string& what, Status status)
+{
+    return LIBCUEBIN_ERROR(status.code(), "Cannot read " + what);
+}
+
+} // anonymous namespace
+
+struct IsoFileSystem::Impl {
+    struct Directory {
+        uint32_t lba = 0;
+        bool loaded = false;
+        std::vector<std::string> children; // Index keys, in record order
+    };
+
+    const Disc* disc = nullptr;
+    std::string volumeId;
+    uint32_t volumeSectors = 0;
+
+    mutable std::mutex mutex;
+    // Every directory named in the path table, keyed like `entries`
+    mutable std::unordered_map<std::string, Directory> directories;
+    // Files and directories of every loaded directory
+    mutable std::unordered_map<std::string, IsoFileInfo> entries;
+    mutable size_t loadedDirectories = 0;
+
+    // Loads the records of `key` if not done yet. Called with `mutex` held.
+    Result<Directory*> loadDirectory(const std::string& key) const;
+    Result<IsoFileInfo> lookup(const std::string& key) const;
+};
+
+Result<IsoFileSystem::Impl::Directory*> IsoFileSystem::Impl::loadDirectory(const std::string& key) const
+{
+    auto it = directories.find(key);
+    if (it == directories.end()) {
+        return LIBCUEBIN_ERROR(ErrorCode::PathNotFound, "No such directory: /" + key);
+    }
+    Directory& dir = it->second;
+    if (dir.loaded) return &dir;
+
+    // The "." record at the start of the extent gives the directory's size
+    std::array<uint8_t, RAW_SECTOR_SIZE> first{};
+    size_t written = 0;
+    Status status = disc->readUserDataInto(static_cast<int32_t>(dir.lba), 1, first, &written);
+    if (!status) return readError("directory /" + key, status);
+    if (written != ISO_BLOCK_SIZE || first[0] < MIN_DIRECTORY_RECORD) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidFileSystem, "Malformed directory: /" + key);
+    }
+
+    uint32_t bytes = readLe32(first.data() + 10);
+    int32_t sectors = static_cast<int32_t>((bytes + ISO_BLOCK_SIZE - 1) / ISO_BLOCK_SIZE);
+    std::vector<uint8_t> records;
+    if (sectors > 1) {
+        auto data = disc->readUserDataRange(static_cast<int32_t>(dir.lba), sectors);
+        if (!data) return data.error();
+        if (data->size() != static_cast<size_t>(sectors) * ISO_BLOCK_SIZE) {
+            return LIBCUEBIN_ERROR(ErrorCode::InvalidFileSystem, "Malformed directory: /" + key);
+        }
+        records = std::move(*data);
+    } else {
+        records.assign(first.begin(), first.begin() + ISO_BLOCK_SIZE);
+    }
+
+    for (size_t sector = 0; sector < records.size(); sector += ISO_BLOCK_SIZE) {
+        // Records never straddle sectors; a zero length pads to the next one
+        size_t pos = sector;
+        size_t end = sector + ISO_BLOCK_SIZE;
+        while (pos + MIN_DIRECTORY_RECORD <= end) {
+            const uint8_t* rec = records.data() + pos;
+            uint8_t length = rec[0];
+            if (length == 0) break;
+            if (length < MIN_DIRECTORY_RECORD || pos + length > end) break;
+            pos += length;
+
+            uint8_t nameLength = rec[32];
+            if (33u + nameLength > length) continue;
+            std::string_view rawName(reinterpret_cast<const char*>(rec + 33), nameLength);
+            if (nameLength == 1 && (rawName[0] == 0 || rawName[0] == 1)) continue; // "." and ".."
+
+            IsoFileInfo info;
+            info.name = std::string(trimIdentifier(rawName));
+            info.extentLba = readLe32(rec + 2);
+            info.size = readLe32(rec + 10);
+            info.isDirectory = (rec[25] & FLAG_DIRECTORY) != 0;
+
+            std::string child = joinPath(key, info.name);
+            if (info.isDirectory) {
+                // Also covers subdirectories a sloppy path table left out
+                directories.try_emplace(child).first->second.lba = info.extentLba;
+            }
+            // Multi-extent files repeat their name: keep the first record
+            if (entries.try_emplace(child, std::move(info)).second) dir.children.push_back(child);
+        }
+    }
+
+    dir.loaded = true;
+    ++loadedDirectories;
+    spdlog::debug("Loaded ISO9660 directory /{} ({} entries)", key, dir.children.size());
+    return &dir;
+}
+
+Result<IsoFileInfo> IsoFileSystem::Impl::lookup(const std::string& key) const
+{
+    if (key.empty()) {
+        IsoFileInfo root;
+        root.extentLba = directories.at(key).lba;
+        root.isDirectory = true;
+        return root;
+    }
+
+    if (auto it = entries.find(key); it != entries.end()) return it->second;
+
+    // Not indexed yet: load the chain of parents down to this entry
+    std::string parent = parentOf(key);
+    if (!directories.count(parent)) {
+        auto parentInfo = lookup(parent);
+        if (!parentInfo) return parentInfo.error();
+        if (!parentInfo->isDirectory) {
+            return LIBCUEBIN_ERROR(ErrorCode::PathNotFound, "Not a directory: /" + parent);
+        }
+    }
+    auto dir = loadDirectory(parent);
+    if (!dir) return dir.error();
+
+    if (auto it = entries.find(key); it != entries.end()) return it->second;
+    return LIBCUEBIN_ERROR(ErrorCode::PathNotFound, "No such file or directory: /" + key);
+}
+
+IsoFileSystem::IsoFileSystem(std::unique_ptr<Impl> impl) : m_impl(std::move(impl)) {}
+IsoFileSystem::~IsoFileSystem() = default;
+IsoFileSystem::IsoFileSystem(IsoFileSystem&& other) noexcept = default;
+IsoFileSystem& IsoFileSystem::operator=(IsoFileSystem&& other) noexcept = default;
+
+Result<IsoFileSystem> IsoFileSystem::mount(const Disc& disc, uint8_t trackNumber)
+{
+    const Track* trk = nullptr;
+    if (trackNumber != 0) {
+        trk = disc.track(trackNumber);
+    } else {
+        for (const auto& t : disc.tracks()) {
+            if (t.isData()) {
+                trk = &t;
+                break;
+            }
+        }
+    }
+    if (!trk || !trk->isData()) {
+        return LIBCUEBIN_ERROR(ErrorCode::TrackNotFound, "No data track to mount");
+    }
+
+    auto impl = std::make_unique<Impl>();
+    impl->disc = &disc;
+
+    // Walk the volume descriptor set to the primary descriptor
+    std::array<uint8_t, RAW_SECTOR_SIZE> pvd{};
+    bool found = false;
+    for (int32_t lba = trk->startLba() + VOLUME_DESCRIPTOR_LBA; lba < trk->endLba(); ++lba) {
+        size_t written = 0;
+        Status status = disc.readUserDataInto(lba, 1, pvd, &written);
+        if (!status) return readError("volume descriptor at LBA " + std::to_string(lba), status);
+        if (written != ISO_BLOCK_SIZE || std::memcmp(pvd.data() + 1, "CD001", 5) != 0) break;
+        if (pvd[0] == DESCRIPTOR_PRIMARY) {
+            found = true;
+            break;
+        }
+        if (pvd[0] == DESCRIPTOR_TERMINATOR) break;
+    }
+    if (!found) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidFileSystem,
+            "No ISO9660 primary volume descriptor on track " + std::to_string(trk->number()));
+    }
+    if (readLe16(pvd.data() + 128) != ISO_BLOCK_SIZE) {
+        return LIBCUEBIN_ERROR(ErrorCode::Unsupported, "Only 2048-byte logical blocks are supported");
+    }
+
+    std::string_view volumeId(reinterpret_cast<const char*>(pvd.data() + 40), 32);
+    impl->volumeId = std::string(volumeId.substr(0, volumeId.find_last_not_of(' ') + 1));
+    impl->volumeSectors = readLe32(pvd.data() + 80);
+    impl->directories[""].lba = readLe32(pvd.data() + 156 + 2);
+
+    // The path table names every directory; their contents load lazily
+    uint32_t tableSize = readLe32(pvd.data() + 132);
+    uint32_t tableLba = readLe32(pvd.data() + 140);
+    int32_t tableSectors = static_cast<int32_t>((tableSize + ISO_BLOCK_SIZE - 1) / ISO_BLOCK_SIZE);
+    if (tableSectors > 0) {
+        auto table = disc.readUserDataRange(static_cast<int32_t>(tableLba), tableSectors);
+        if (!table) return table.error();
+        if (table->size() < tableSize) {
+            return LIBCUEBIN_ERROR(ErrorCode::InvalidFileSystem, "Truncated path table");
+        }
+
+        std::vector<std::string> paths; // By 1-based directory number - 1
+        size_t pos = 0;
+        while (pos + 8 <= tableSize) {
+            const uint8_t* rec = table->data() + pos;
+            uint8_t nameLength = rec[0];
+            if (nameLength == 0 || pos + 8 + nameLength > tableSize) break;
+            uint32_t lba = readLe32(rec + 2);
+            uint16_t parent = readLe16(rec + 6);
+            std::string_view name(reinterpret_cast<const char*>(rec + 8), nameLength);
+
+            std::string key;
+            if (!paths.empty() && parent >= 1 && parent <= paths.size()) {
+                key = joinPath(paths[parent - 1], name);
+            }
+            // The first record is the root; its identifier is a single 0x00
+            if (!paths.empty() && !key.empty()) impl->directories[key].lba = lba;
+            paths.push_back(std::move(key));
+
+            pos += 8 + nameLength + (nameLength & 1);
+        }
+    }
+
+    spdlog::debug("Mounted ISO9660 volume '{}' ({} directories)",
+                  impl->volumeId, impl->directories.size());
+    return IsoFileSystem(std::move(impl));
+}
+
+std::string_view IsoFileSystem::volumeId() const noexcept
+{
+    return m_impl->volumeId;
+}
+
+uint32_t IsoFileSystem::volumeSectors() const noexcept
+{
+    return m_impl->volumeSectors;
+}
+
+size_t IsoFileSystem::loadedDirectoryCount() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->loadedDirectories;
+}
+
+Result<IsoFileInfo> IsoFileSystem::stat(std::string_view path) const
+{
+    std::string key = normalizePath(path);
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->lookup(key);
+}
+
+Result<IsoFile> IsoFileSystem::open(std::string_view path) const
+{
+    auto info = stat(path);
+    if (!info) return info.error();
+    if (info->isDirectory) {
+        return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument,
+            "Is a directory: " + std::string(path));
+    }
+    return IsoFile(*m_impl->disc, std::move(*info));
+}
+
+Result<std::vector<IsoFileInfo>> IsoFileSystem::listDirectory(std::string_view path) const
+{
+    std::string key = normalizePath(path);
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+
+    if (!m_impl->directories.count(key)) {
+        auto info = m_impl->lookup(key);
+        if (!info) return info.error();
+        if (!info->isDirectory) {
+            return LIBCUEBIN_ERROR(ErrorCode::InvalidArgument, "Not a directory: /" + key);
+        }
+    }
+    auto dir = m_impl->loadDirectory(key);
+    if (!dir) return dir.error();
+
+    std::vector<IsoFileInfo> list;
+    list.reserve((*dir)->children.size());
+    for (const auto& child : (*dir)->children) list.push_back(m_impl->entries.at(child));
+    return list;
+}
+
+Result<size_t> IsoFile::read(uint64_t offset, std::span<uint8_t> out) const
+{
+    if (offset >= m_info.size || out.empty()) return size_t{0};
+    size_t total = static_cast<size_t>(std::min<uint64_t>(out.size(), m_info.size - offset));
+
+    int32_t lba = static_cast<int32_t>(m_info.extentLba + offset / ISO_BLOCK_SIZE);
+    size_t skip = static_cast<size_t>(offset % ISO_BLOCK_SIZE);
+    size_t done = 0;
+
+    auto formError = [this]() {
+        return LIBCUEBIN_ERROR(ErrorCode::Unsupported,
+            m_info.name + " contains non-2048-byte (Form 2) sectors; use Disc::readUserDataRange()");
+    };
+
+    // Partial sectors at either end go through a one-sector bounce buffer
+    auto readPartial = [&](size_t from, size_t bytes) -> Status {
+        std::array<uint8_t, RAW_SECTOR_SIZE> block;
+        size_t written = 0;
+        Status status = m_disc->readUserDataInto(lba, 1, block, &written);
+        if (!status) return status;
+        if (written != ISO_BLOCK_SIZE) return ErrorCode::Unsupported;
+        std::memcpy(out.data() + done, block.data() + from, bytes);
+        done += bytes;
+        ++lba;
+        return {};
+    };
+
+    if (skip != 0 || total < ISO_BLOCK_SIZE) {
+        size_t bytes = std::min(total, ISO_BLOCK_SIZE - skip);
+        Status status = readPartial(skip, bytes);
+        if (!status && status.code() == ErrorCode::Unsupported) return formError();
+        if (!status) return readError(m_info.name, status);
+    }
+
+    // Whole sectors land directly in the caller's buffer
+    int32_t whole = static_cast<int32_t>((total - done) / ISO_BLOCK_SIZE);
+    if (whole > 0) {
+        size_t bytes = static_cast<size_t>(whole) * ISO_BLOCK_SIZE;
+        size_t written = 0;
+        Status status = m_disc->readUserDataInto(lba, whole, out.subspan(done, bytes), &written);
+        if (!status && status.code() == ErrorCode::InvalidArgument) return formError();
+        if (!status) return readError(m_info.name, status);
+        if (written != bytes) return formError();
+        done += bytes;
+        lba += whole;
+    }
+
+    if (done < total) {
+        Status status = readPartial(0, total - done);
+        if (!status && status.code() == ErrorCode::Unsupported) return formError();
+        if (!status) return readError(m_info.name, status);
+    }
+
+    return done;
+}
+
+Result<std::vector<uint8_t>> IsoFile::readAll() const
+{
+    std::vector<uint8_t> data(m_info.size);
+    auto n = read(0, data);
+    if (!n) return n.error();
+    data.resize(*n);
+    return data;
+}
+
+} // namespace cuebin
@@ -0,0 +1,369 @@
+#include "libcuebin/libraryScanner.hpp"
+#include "libcuebin/cueParser.hpp"
+
+#include "audioContainer.hpp"
+#include "compressedFile.hpp"
+#include "discImpl.hpp"
+#include "rawFile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+namespace cuebin {
+
+namespace {
+
+struct ScanTask {
+    std::filesystem::path path;
+    bool directory = false;
+};
+
+// One deque per worker. Owners push and pop at the back, so a directory's
+// sheets are parsed while its entries are still in the page cache; thieves
+// take from the front, where the oldest (usually largest) subtrees wait.
+// Workers with nothing to take sleep until a push or the last finish().
+class TaskQueues {
+public:
+    explicit TaskQueues(size_t workers) : m_queues(workers) {}
+
+    void push(size_t worker, ScanTask task)
+    {
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            Queue& q = m_queues[worker];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+            m_queued.fetch_add(1, std::memory_order_release);
+        }
+        wake(false);
+    }
+
+    // Takes the next task, waiting while other workers may still push one.
+    // False once every task has finished.
+    bool next(size_t worker, ScanTask& task)
+    {
+        while (!pop(worker, task)) {
+            std::unique_lock<std::mutex> lock(m_waitMutex);
+            m_wake.wait(lock, [this]() {
+                return m_queued.load(std::memory_order_acquire) > 0 || idle();
+            });
+            if (idle()) return false;
+        }
+        return true;
+    }
+
+    // Called once a popped task has run and pushed its children
+    void finish() noexcept
+    {
+        if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) wake(true);
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<ScanTask> tasks;
+    };
+
+    bool pop(size_t worker, ScanTask& task)
+    {
+        for (size_t i = 0; i < m_queues.size(); ++i) {
+            Queue& q = m_queues[(worker + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            if (i == 0) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool idle() const noexcept { return m_pending.load(std::memory_order_acquire) == 0; }
+
+    // Counters change before the lock is taken, so a worker checking them
+    // under m_waitMutex cannot miss the notification
+    void wake(bool all) noexcept
+    {
+        { std::lock_guard<std::mutex> lock(m_waitMutex); }
+        if (all) {
+            m_wake.notify_all();
+        } else {
+            m_wake.notify_one();
+        }
+    }
+
+    std::vector<Queue> m_queues;
+    std::atomic<size_t> m_pending{0}; // Pushed and not yet finished
+    std::atomic<size_t> m_queued{0};  // Pushed and not yet popped
+    std::mutex m_waitMutex;
+    std::condition_variable m_wake;
+};
+
+// Holds one of the ScanOptions::maxOpenFiles slots
+class OpenSlot {
+public:
+    explicit OpenSlot(std::counting_semaphore<>& slots) : m_slots(slots) { m_slots.acquire(); }
+    ~OpenSlot() { m_slots.release(); }
+
+    OpenSlot(const OpenSlot&) = delete;
+    OpenSlot& operator=(const OpenSlot&) = delete;
+
+private:
+    std::counting_semaphore<>& m_slots;
+};
+
+struct WorkerOutput {
+    std::vector<CatalogEntry> entries;
+    std::vector<CatalogTrack> tracks; // Entries' firstTrack index this array
+    std::string text;                 // Reused CUE read buffer
+};
+
+bool isCueFile(const std::filesystem::path& path)
+{
+    auto ext = path.extension().native();
+    return ext.size() == 4 && ext[0] == '.'
+        && (ext[1] | 0x20) == 'c' && (ext[2] | 0x20) == 'u' && (ext[3] | 0x20) == 'e';
+}
+
+class Scanner {
+public:
+    Scanner(const ScanOptions& options, size_t workers)
+        : m_options(options)
+        , m_slots(std::max(1u, options.maxOpenFiles))
+        , m_queues(workers)
+        , m_outputs(workers)
+    {}
+
+    void seed(size_t worker, ScanTask task) { m_queues.push(worker, std::move(task)); }
+
+    DiscCatalog run()
+    {
+        std::vector<std::thread> threads;
+        for (size_t w = 1; w < m_outputs.size(); ++w) threads.emplace_back([this, w]() { work(w); });
+        work(0);
+        for (auto& t : threads) t.join();
+        return merge();
+    }
+
+private:
+    void work(size_t worker)
+    {
+        ScanTask task;
+        while (m_queues.next(worker, task)) {
+            if (task.directory) {
+                scanDirectory(worker, task.path);
+            } else {
+                scanSheet(m_outputs[worker], task.path);
+            }
+            m_queues.finish();
+        }
+    }
+
+    void scanDirectory(size_t worker, const std::filesystem::path& dir)
+    {
+        std::vector<ScanTask> found;
+        {
+            OpenSlot slot(m_slots);
+            auto dirOptions = std::filesystem::directory_options::skip_permission_denied;
+            std::error_code ec;
+            std::filesystem::directory_iterator it(dir, dirOptions, ec);
+            for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+                const auto& entry = *it;
+                std::error_code typeEc;
+                if (entry.is_directory(typeEc)) {
+                    if (!m_options.recursive) continue;
+                    if (!m_options.followSymlinks && entry.is_symlink(typeEc)) continue;
+                    found.push_back({entry.path(), true});
+                } else if (isCueFile(entry.path()) && entry.is_regular_file(typeEc)) {
+                    found.push_back({entry.path(), false});
+                }
+            }
+            if (ec) spdlog::warn("Cannot list directory {}: {}", dir.string(), ec.message());
+        }
+        for (auto& task : found) m_queues.push(worker, std::move(task));
+    }
+
+    void scanSheet(WorkerOutput& out, const std::filesystem::path& cuePath)
+    {
+        CatalogEntry entry;
+        entry.cuePath = cuePath;
+        entry.firstTrack = static_cast<uint32_t>(out.tracks.size());
+
+        auto error = validate(out, cuePath, entry);
+        if (error) {
+            out.tracks.resize(entry.firstTrack);
+            entry.trackCount = 0;
+            entry.totalSectors = 0;
+            entry.error = std::move(error);
+        }
+        out.entries.push_back(std::move(entry));
+    }
+
+    std::optional<Error> readText(const std::filesystem::path& path, std::string& text)
+    {
+        OpenSlot slot(m_slots);
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        RawFile file;
+        if (ec || !file.open(path)) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileNotFound, "Cannot open CUE file: " + path.string());
+        }
+        text.resize(size);
+        int64_t got = file.readAt(0, reinterpret_cast<uint8_t*>(text.data()), static_cast<int64_t>(size));
+        if (got < 0) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileReadError, "Cannot read CUE file: " + path.string());
+        }
+        text.resize(static_cast<size_t>(got));
+        return std::nullopt;
+    }
+
+    // Same probes as Disc::fromCue(), without setting up any I/O
+    Result<FileLayout> probeFile(const std::filesystem::path& path, FileType type)
+    {
+        OpenSlot slot(m_slots);
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        if (ec == std::errc::no_such_file_or_directory) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileNotFound, "BIN file not found: " + path.string());
+        }
+        if (ec) {
+            return LIBCUEBIN_ERROR(ErrorCode::FileReadError, "Cannot get file size: " + path.string());
+        }
+
+        FileLayout layout{0, static_cast<int64_t>(size)};
+        if (type == FileType::Wave || type == FileType::Aiff) {
+            auto container = parseAudioContainer(path, type);
+            if (!container) return container.error();
+            layout.dataOffset = container->dataOffset;
+            layout.dataSize = container->dataSize;
+        } else if (CompressedFile::detect(path)) {
+            CompressedFile compressed;
+            if (!compressed.open(path, 1)) {
+                return LIBCUEBIN_ERROR(ErrorCode::FileReadError,
+                    "Invalid compressed image: " + path.string());
+            }
+            layout.dataSize = compressed.size();
+        }
+        return layout;
+    }
+
+    std::optional<Error> validate(WorkerOutput& out, const std::filesystem::path& cuePath,
+                                  CatalogEntry& entry)
+    {
+        if (auto error = readText(cuePath, out.text)) return error;
+        auto sheet = CueParser::parseString(out.text);
+        if (!sheet) return std::move(sheet.error());
+
+        std::vector<FileLayout> layouts;
+        layouts.reserve(sheet->files.size());
+        size_t trackTotal = 0;
+        for (const auto& file : sheet->files) {
+            if (file.tracks.empty()) {
+                return LIBCUEBIN_ERROR(ErrorCode::MissingTrack,
+                    "FILE without TRACK: " + std::string(file.filename));
+            }
+            trackTotal += file.tracks.size();
+            auto layout = probeFile(cuePath.parent_path() / file.filename, file.type);
+            if (!layout) return std::move(layout.error());
+            layouts.push_back(*layout);
+        }
+        if (trackTotal > MAX_TRACKS) {
+            return LIBCUEBIN_ERROR(ErrorCode::InvalidCueFormat,
+                "More than 99 tracks: " + std::to_string(trackTotal));
+        }
+
+        TrackTable tracks;
+        entry.totalSectors = layoutTracks(*sheet, layouts, tracks);
+        for (const auto& t : tracks) {
+            if (t.lengthSectors() <= 0) {
+                return LIBCUEBIN_ERROR(ErrorCode::InvalidCueFormat,
+                    "Track " + std::to_string(t.number()) + " has no sectors");
+            }
+            out.tracks.push_back({t.number(), t.mode(), t.startLba(), t.lengthSectors()});
+        }
+        entry.trackCount = static_cast<uint8_t>(tracks.size());
+        entry.fileCount = static_cast<uint8_t>(std::min<size_t>(sheet->files.size(), UINT8_MAX));
+        if (sheet->title) entry.title.emplace(*sheet->title);
+        return std::nullopt;
+    }
+
+    DiscCatalog merge()
+    {
+        struct Ref {
+            CatalogEntry* entry;
+            const WorkerOutput* output;
+        };
+        std::vector<Ref> refs;
+        size_t trackTotal = 0;
+        for (auto& output : m_outputs) {
+            for (auto& entry : output.entries) refs.push_back({&entry, &output});
+            trackTotal += output.tracks.size();
+        }
+        std::sort(refs.begin(), refs.end(), [](const Ref& a, const Ref& b) {
+            return a.entry->cuePath < b.entry->cuePath;
+        });
+
+        DiscCatalog catalog;
+        catalog.discs.reserve(refs.size());
+        catalog.tracks.reserve(trackTotal);
+        for (const auto& ref : refs) {
+            auto first = ref.output->tracks.begin() + ref.entry->firstTrack;
+            ref.entry->firstTrack = static_cast<uint32_t>(catalog.tracks.size());
+            catalog.tracks.insert(catalog.tracks.end(), first, first + ref.entry->trackCount);
+            if (!ref.entry->ok()) ++catalog.failedCount;
+            catalog.discs.push_back(std::move(*ref.entry));
+        }
+        return catalog;
+    }
+
+    const ScanOptions& m_options;
+    std::counting_semaphore<> m_slots;
+    TaskQueues m_queues;
+    std::vector<WorkerOutput> m_outputs;
+};
+
+size_t workerCount(const ScanOptions& options)
+{
+    return options.threadCount ? options.threadCount
+                               : std::max(1u, std::thread::hardware_concurrency());
+}
+
+} // anonymous namespace
+
+Result<DiscCatalog> scanLibrary(const std::filesystem::path& root, const ScanOptions& options)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root, ec)) {
+        return LIBCUEBIN_ERROR(ErrorCode::PathNotFound,
+            "Library root is not a directory: " + root.string());
+    }
+
+    Scanner scanner(options, workerCount(options));
+    scanner.seed(0, {root, true});
+    DiscCatalog catalog = scanner.run();
+    spdlog::debug("Scanned {}: {} CUE sheets, {} failed",
+                  root.string(), catalog.discs.size(), catalog.failedCount);
+    return catalog;
+}
+
+DiscCatalog scanCueSheets(std::span<const std::filesystem::path> cuePaths, const ScanOptions& options)
+{
+    size_t workers = std::max<size_t>(1, std::min(workerCount(options), cuePaths.size()));
+    Scanner scanner(options, workers);
+    for (size_t i = 0; i < cuePaths.size(); ++i) scanner.seed(i % workers, {cuePaths[i], false});
+    return scanner.run();
+}
+
+} // namespace cuebin
@@ -0,0 +1,110 @@
+#include "rawFile.hpp"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace cuebin {
+
+RawFile::~RawFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool RawFile::open(const std::filesystem::path& path)
+{
+    close();
+    HANDLE h = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) return false;
+    m_handle = h;
+    return true;
+}
+
+void RawFile::close() noexcept
+{
+    if (m_handle) CloseHandle(m_handle);
+    m_handle = nullptr;
+}
+
+bool RawFile::isOpen() const noexcept
+{
+    return m_handle != nullptr;
+}
+
+int64_t RawFile::readAt(int64_t offset, uint8_t* dst, int64_t size) const noexcept
+{
+    if (offset < 0) return -1;
+
+    int64_t total = 0;
+    while (total < size) {
+        // An explicit offset in OVERLAPPED makes ReadFile positional
+        OVERLAPPED ov{};
+        uint64_t pos = static_cast<uint64_t>(offset + total);
+        ov.Offset = static_cast<DWORD>(pos & 0xFFFFFFFFu);
+        ov.OffsetHigh = static_cast<DWORD>(pos >> 32);
+
+        DWORD chunk = static_cast<DWORD>(std::min<int64_t>(size - total, 1 << 30));
+        DWORD got = 0;
+        if (!ReadFile(m_handle, dst + total, chunk, &got, &ov)) {
+            if (GetLastError() == ERROR_HANDLE_EOF) break;
+            return -1;
+        }
+        if (got == 0) break;
+        total += got;
+    }
+    return total;
+}
+
+#else
+
+bool RawFile::open(const std::filesystem::path& path)
+{
+    close();
+    m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    return m_fd >= 0;
+}
+
+void RawFile::close() noexcept
+{
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+}
+
+bool RawFile::isOpen() const noexcept
+{
+    return m_fd >= 0;
+}
+
+int64_t RawFile::readAt(int64_t offset, uint8_t* dst, int64_t size) const noexcept
+{
+    if (offset < 0) return -1;
+
+    int64_t total = 0;
+    while (total < size) {
+        ssize_t got = ::pread(m_fd, dst + total, static_cast<size_t>(size - total),
+                              static_cast<off_t>(offset + total));
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (got == 0) break;
+        total += got;
+    }
+    return total;
+}
+
+#endif
+
+} // namespace cuebin
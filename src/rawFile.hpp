@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace cuebin {
+
+// Unbuffered read-only file supporting positional reads. Reads do not share
+// a file position, so any number of threads may call readAt() concurrently.
+class RawFile {
+public:
+    RawFile() = default;
+    ~RawFile();
+
+    RawFile(const RawFile&) = delete;
+    RawFile& operator=(const RawFile&) = delete;
+
+    bool open(const std::filesystem::path& path);
+    void close() noexcept;
+
+    bool isOpen() const noexcept;
+
+#ifndef _WIN32
+    int fd() const noexcept { return m_fd; }
+#endif
+
+    // Reads up to `size` bytes at `offset`, retrying short reads until
+    // `size` bytes are read or end of file is reached.
+    // Returns the number of bytes read, or -1 on error.
+    int64_t readAt(int64_t offset, uint8_t* dst, int64_t size) const noexcept;
+
+private:
+#ifdef _WIN32
+    void* m_handle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace cuebin
@@ -0,0 +1,151 @@
+#include "readAhead.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace cuebin {
+
+ReadAhead::ReadAhead(Fetch fetch, int32_t totalSectors, int32_t minWindow, int32_t maxWindow)
+    : m_fetch(std::move(fetch))
+    , m_totalSectors(totalSectors)
+    , m_minWindow(std::max(1, minWindow))
+    , m_maxWindow(std::max(m_minWindow, maxWindow))
+    , m_window(m_minWindow)
+{
+    m_buffer.resize(static_cast<size_t>(m_maxWindow) * RAW_SECTOR_SIZE);
+    m_modes.resize(m_maxWindow);
+    m_stats.windowSectors = m_window;
+    m_worker = std::thread(&ReadAhead::workerLoop, this);
+}
+
+ReadAhead::~ReadAhead()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+bool ReadAhead::tryRead(int32_t lba, int32_t count, uint8_t* out, TrackMode* modes) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (lba < m_bufStart || static_cast<int64_t>(lba) + count > m_bufStart + m_bufCount) {
+        return false;
+    }
+
+    size_t first = static_cast<size_t>(lba - m_bufStart);
+    std::memcpy(out, m_buffer.data() + first * RAW_SECTOR_SIZE,
+                static_cast<size_t>(count) * RAW_SECTOR_SIZE);
+    if (modes) std::copy_n(m_modes.begin() + first, count, modes);
+    return true;
+}
+
+void ReadAhead::noteAccess(int32_t lba, int32_t count, bool hit) noexcept
+{
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        bool sequential = lba == m_nextExpected;
+        m_nextExpected = lba + count;
+        int32_t bufEnd = m_bufStart + m_bufCount;
+
+        if (hit) {
+            ++m_stats.hits;
+            m_bufConsumedEnd = std::max(m_bufConsumedEnd, m_nextExpected);
+        }
+
+        if (!sequential) {
+            // The run broke: if most of the window went unread, it was too
+            // large for this reader
+            if (m_bufCount > 0 && bufEnd - m_bufConsumedEnd >= m_bufCount / 2) {
+                m_window = std::max(m_minWindow, m_window / 2);
+            }
+            if (!hit) m_bufCount = 0;
+            m_streak = 0;
+            m_stats.windowSectors = m_window;
+            return;
+        }
+
+        ++m_streak;
+        if (!hit && m_streak > SEQUENTIAL_THRESHOLD) {
+            // The reader caught up with the prefetcher: fetch further ahead
+            ++m_stats.misses;
+            m_window = std::min(m_maxWindow, m_window * 2);
+        }
+        m_stats.windowSectors = m_window;
+
+        if (m_streak < SEQUENTIAL_THRESHOLD) return;
+
+        int32_t ahead = 0;
+        if (m_bufCount > 0 && m_nextExpected >= m_bufStart && m_nextExpected <= bufEnd) {
+            ahead = bufEnd - m_nextExpected;
+        }
+
+        if (!m_inFlight && !m_requested && ahead < m_window / 2
+            && m_nextExpected < m_totalSectors) {
+            m_requestStart = m_nextExpected;
+            m_requestCount = std::min(m_window, m_totalSectors - m_nextExpected);
+            m_requested = true;
+            wake = true;
+        }
+    }
+    if (wake) m_wake.notify_one();
+}
+
+ReadAheadStats ReadAhead::stats() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void ReadAhead::workerLoop()
+{
+    std::vector<uint8_t> staging(m_buffer.size());
+    std::vector<TrackMode> stagingModes(m_modes.size());
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this]() { return m_stop || m_requested; });
+        if (m_stop) break;
+
+        int32_t start = m_requestStart;
+        int32_t count = m_requestCount;
+        m_requested = false;
+        m_inFlight = true;
+
+        // Carry over the part of the current window the new one overlaps
+        int32_t carried = 0;
+        int32_t bufEnd = m_bufStart + m_bufCount;
+        if (m_bufCount > 0 && start >= m_bufStart && start < bufEnd) {
+            carried = std::min(bufEnd, start + count) - start;
+            size_t first = static_cast<size_t>(start - m_bufStart);
+            std::memcpy(staging.data(), m_buffer.data() + first * RAW_SECTOR_SIZE,
+                        static_cast<size_t>(carried) * RAW_SECTOR_SIZE);
+            std::copy_n(m_modes.begin() + first, carried, stagingModes.begin());
+        }
+
+        lock.unlock();
+        Status status;
+        if (carried < count) {
+            status = m_fetch(start + carried, count - carried,
+                             staging.data() + static_cast<size_t>(carried) * RAW_SECTOR_SIZE,
+                             stagingModes.data() + carried);
+        }
+        lock.lock();
+
+        m_inFlight = false;
+        if (!status) continue;
+
+        std::swap(m_buffer, staging);
+        std::swap(m_modes, stagingModes);
+        m_bufStart = start;
+        m_bufCount = count;
+        m_bufConsumedEnd = start;
+        m_stats.prefetchedSectors += static_cast<uint64_t>(count - carried);
+    }
+}
+
+} // namespace cuebin
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "libcuebin/disc.hpp"
+
+namespace cuebin {
+
+// Background prefetcher for sequential readers. It watches the LBAs handed
+// to noteAccess(); once a sequential run is detected, a worker thread fetches
+// the next window of sectors into a buffer that tryRead() serves from.
+//
+// The window adapts to the consumer: it doubles when a sequential read
+// arrives before the prefetch covering it, and halves when a prefetched
+// window is discarded mostly unread (the run broke or the reader is slow).
+class ReadAhead {
+public:
+    // Reads `count` framed sectors into `out` (count * RAW_SECTOR_SIZE bytes)
+    // and their modes into `modes`, bypassing the read-ahead buffer.
+    using Fetch = std::function<Status(int32_t lba, int32_t count, uint8_t* out, TrackMode* modes)>;
+
+    ReadAhead(Fetch fetch, int32_t totalSectors, int32_t minWindow, int32_t maxWindow);
+    ~ReadAhead();
+
+    ReadAhead(const ReadAhead&) = delete;
+    ReadAhead& operator=(const ReadAhead&) = delete;
+
+    // Copies [lba, lba + count) from the prefetched window if it is fully
+    // covered. Returns false (and copies nothing) otherwise.
+    bool tryRead(int32_t lba, int32_t count, uint8_t* out, TrackMode* modes) noexcept;
+
+    // Records a completed read so sequential runs can be detected.
+    void noteAccess(int32_t lba, int32_t count, bool hit) noexcept;
+
+    ReadAheadStats stats() const noexcept;
+
+private:
+    // Number of back-to-back sequential reads before prefetching starts
+    static constexpr int SEQUENTIAL_THRESHOLD = 2;
+
+    void workerLoop();
+
+    Fetch m_fetch;
+    int32_t m_totalSectors;
+    int32_t m_minWindow;
+    int32_t m_maxWindow;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+
+    // Prefetched window [m_bufStart, m_bufStart + m_bufCount)
+    std::vector<uint8_t> m_buffer;
+    std::vector<TrackMode> m_modes;
+    int32_t m_bufStart = 0;
+    int32_t m_bufCount = 0;
+    int32_t m_bufConsumedEnd = 0;
+
+    // Sequential run detection
+    int32_t m_nextExpected = -1;
+    int m_streak = 0;
+    int32_t m_window;
+
+    // Pending prefetch request, consumed by the worker
+    bool m_requested = false;
+    bool m_inFlight = false;
+    int32_t m_requestStart = 0;
+    int32_t m_requestCount = 0;
+
+    ReadAheadStats m_stats;
+
+    std::thread m_worker;
+};
+
+} // namespace cuebin
@@ -0,0 +1,395 @@
+#include "libcuebin/disc.hpp"
+#include "libcuebin/hash.hpp"
+
+#include "discImpl.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+namespace cuebin {
+
+// Snapshot layout, all integers little-endian:
+//   header  "CUEBINS1", u32 version, u32 payload size, u32 CRC32 of the
+//           payload, u32 reserved
+//   payload CUE stamp, total sectors, sheet-level fields, then per FILE its
+//           name, type, stamp and data region followed by its tracks: the
+//           CUE fields and the resolved LBA/byte layout
+// Strings are a u32 length and the bytes; optional fields a u8 presence flag.
+namespace {
+
+constexpr char MAGIC[8] = {'C', 'U', 'E', 'B', 'I', 'N', 'S', '1'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 24;
+
+constexpr uint8_t FILE_BIG_ENDIAN = 1 << 0;
+constexpr uint8_t FILE_COMPRESSED = 1 << 1;
+
+class Writer {
+public:
+    std::vector<uint8_t> bytes;
+
+    void u8(uint8_t v) { bytes.push_back(v); }
+
+    void u32(uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i) bytes.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+
+    void i32(int32_t v) { u32(static_cast<uint32_t>(v)); }
+
+    void i64(int64_t v)
+    {
+        auto u = static_cast<uint64_t>(v);
+        u32(static_cast<uint32_t>(u));
+        u32(static_cast<uint32_t>(u >> 32));
+    }
+
+    void str(std::string_view s)
+    {
+        u32(static_cast<uint32_t>(s.size()));
+        bytes.insert(bytes.end(), s.begin(), s.end());
+    }
+
+    void optStr(const std::optional<std::pmr::string>& s)
+    {
+        u8(s.has_value());
+        if (s) str(*s);
+    }
+
+    void msf(MSF m)
+    {
+        u8(m.minute);
+        u8(m.second);
+        u8(m.frame);
+    }
+
+    void optMsf(const std::optional<MSF>& m)
+    {
+        u8(m.has_value());
+        if (m) msf(*m);
+    }
+
+    void stamp(const FileStamp& s)
+    {
+        i64(s.size);
+        i64(s.mtimeNs);
+    }
+};
+
+// Bounds-checked cursor; once a read runs past the end every later read
+// returns zero and ok() stays false
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : m_p(data), m_end(data + size) {}
+
+    bool ok() const noexcept { return m_ok; }
+    bool atEnd() const noexcept { return m_p == m_end; }
+
+    uint8_t u8()
+    {
+        if (!take(1)) return 0;
+        return m_p[-1];
+    }
+
+    uint32_t u32()
+    {
+        if (!take(4)) return 0;
+        const uint8_t* p = m_p - 4;
+        return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8
+             | static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+    }
+
+    int32_t i32() { return static_cast<int32_t>(u32()); }
+
+    int64_t i64()
+    {
+        uint64_t lo = u32();
+        uint64_t hi = u32();
+        return static_cast<int64_t>(lo | hi << 32);
+    }
+
+    // Views into the snapshot bytes
+    std::string_view str()
+    {
+        uint32_t size = u32();
+        if (!take(size)) return {};
+        return std::string_view(reinterpret_cast<const char*>(m_p - size), size);
+    }
+
+    void optStr(std::optional<std::pmr::string>& field, const CueAllocator& alloc)
+    {
+        if (u8()) assignString(field, str(), alloc);
+    }
+
+    MSF msf()
+    {
+        uint8_t m = u8();
+        uint8_t s = u8();
+        uint8_t f = u8();
+        return MSF(m, s, f);
+    }
+
+    std::optional<MSF> optMsf()
+    {
+        if (!u8()) return std::nullopt;
+        return msf();
+    }
+
+    FileStamp stamp()
+    {
+        FileStamp s;
+        s.size = i64();
+        s.mtimeNs = i64();
+        return s;
+    }
+
+    // Reads a count of items each taking at least `minBytes`, failing on
+    // counts the remaining bytes cannot hold
+    uint32_t count(size_t minBytes)
+    {
+        uint32_t n = u32();
+        if (static_cast<size_t>(m_end - m_p) / minBytes < n) m_ok = false;
+        return m_ok ? n : 0;
+    }
+
+    void fail() noexcept { m_ok = false; }
+
+private:
+    bool take(size_t n)
+    {
+        if (!m_ok || static_cast<size_t>(m_end - m_p) < n) {
+            m_ok = false;
+            return false;
+        }
+        m_p += n;
+        return true;
+    }
+
+    const uint8_t* m_p;
+    const uint8_t* m_end;
+    bool m_ok = true;
+};
+
+void putLe32(uint8_t* p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+uint32_t getLe32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8
+         | static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+} // anonymous namespace
+
+bool Disc::Impl::writeSnapshot(const std::filesystem::path& snapshotPath) const
+{
+    Writer w;
+    w.bytes.resize(HEADER_SIZE);
+    w.stamp(cueStamp);
+    w.i32(totalSectors);
+
+    w.optStr(sheet.catalog);
+    w.optStr(sheet.cdtextfile);
+    w.optStr(sheet.title);
+    w.optStr(sheet.performer);
+    w.optStr(sheet.songwriter);
+    w.u32(static_cast<uint32_t>(sheet.remarks.size()));
+    for (const auto& remark : sheet.remarks) w.str(remark);
+
+    size_t trackIndex = 0;
+    w.u32(static_cast<uint32_t>(sheet.files.size()));
+    for (size_t fi = 0; fi < sheet.files.size(); ++fi) {
+        const CueFile& file = sheet.files[fi];
+        const FileHandle& fh = *fileHandles[fi];
+        w.str(file.filename);
+        w.u8(static_cast<uint8_t>(file.type));
+        w.stamp(fh.stamp);
+        w.i64(fh.fileSize);
+        w.i64(fh.dataOffset);
+        w.i64(fh.dataSize);
+        w.u8(static_cast<uint8_t>((fh.bigEndianSamples ? FILE_BIG_ENDIAN : 0)
+                                  | (fh.compressed ? FILE_COMPRESSED : 0)));
+
+        w.u32(static_cast<uint32_t>(file.tracks.size()));
+        for (const CueTrack& ct : file.tracks) {
+            const Track& t = tracks[trackIndex++];
+            w.u8(ct.number);
+            w.u8(static_cast<uint8_t>(ct.mode));
+            w.u8(ct.flags);
+            w.optMsf(ct.pregap);
+            w.optMsf(ct.postgap);
+            w.optStr(ct.isrc);
+            w.optStr(ct.title);
+            w.optStr(ct.performer);
+            w.optStr(ct.songwriter);
+            w.u32(static_cast<uint32_t>(ct.indices.size()));
+            for (const auto& idx : ct.indices) {
+                w.u8(idx.number);
+                w.msf(idx.position);
+            }
+            w.i32(t.startLba());
+            w.i32(t.lengthSectors());
+            w.i32(t.pregapSectors());
+            w.i32(t.postgapSectors());
+            w.i64(t.fileByteOffset());
+            w.i32(t.fileStartLba());
+        }
+    }
+
+    uint8_t* header = w.bytes.data();
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    auto payload = std::span<const uint8_t>(w.bytes).subspan(HEADER_SIZE);
+    putLe32(header + 8, VERSION);
+    putLe32(header + 12, static_cast<uint32_t>(payload.size()));
+    putLe32(header + 16, crc32(payload));
+    putLe32(header + 20, 0);
+
+    // Written aside and renamed over, so readers never see a partial snapshot
+    auto tmpPath = snapshotPath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char*>(w.bytes.data()),
+                       static_cast<std::streamsize>(w.bytes.size()))) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, snapshotPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+Disc::ImplPtr Disc::Impl::loadSnapshot(const std::filesystem::path& snapshotPath,
+                                       const std::filesystem::path& cuePath,
+                                       const DiscOptions& options)
+{
+    auto snapshotStamp = statFile(snapshotPath);
+    auto cueStamp = statFile(cuePath);
+    if (!snapshotStamp || !cueStamp || snapshotStamp->size < static_cast<int64_t>(HEADER_SIZE)) {
+        return nullptr;
+    }
+
+    // The whole snapshot in one read
+    std::vector<uint8_t> bytes(static_cast<size_t>(snapshotStamp->size));
+    RawFile file;
+    if (!file.open(snapshotPath)
+        || file.readAt(0, bytes.data(), snapshotStamp->size) != snapshotStamp->size) {
+        return nullptr;
+    }
+
+    const uint8_t* header = bytes.data();
+    auto payload = std::span<const uint8_t>(bytes).subspan(HEADER_SIZE);
+    if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0 || getLe32(header + 8) != VERSION
+        || getLe32(header + 12) != payload.size() || getLe32(header + 16) != crc32(payload)) {
+        spdlog::debug("Ignoring invalid disc snapshot: {}", snapshotPath.string());
+        return nullptr;
+    }
+
+    Reader r(payload.data(), payload.size());
+    if (r.stamp() != *cueStamp) return nullptr;
+
+    auto impl = create(options);
+    impl->baseDir = cuePath.parent_path();
+    impl->cueStamp = *cueStamp;
+    impl->totalSectors = r.i32();
+
+    CueSheet& sheet = impl->sheet;
+    CueAllocator alloc = sheet.get_allocator();
+    r.optStr(sheet.catalog, alloc);
+    r.optStr(sheet.cdtextfile, alloc);
+    r.optStr(sheet.title, alloc);
+    r.optStr(sheet.performer, alloc);
+    r.optStr(sheet.songwriter, alloc);
+    sheet.remarks.resize(r.count(4));
+    for (auto& remark : sheet.remarks) remark = r.str();
+
+    sheet.files.resize(r.count(4));
+    for (size_t fi = 0; fi < sheet.files.size() && r.ok(); ++fi) {
+        CueFile& file = sheet.files[fi];
+        file.filename = r.str();
+        uint8_t type = r.u8();
+        if (type > static_cast<uint8_t>(FileType::MP3)) r.fail();
+        file.type = static_cast<FileType>(type);
+
+        auto handle = std::make_unique<FileHandle>();
+        handle->path = impl->baseDir / file.filename;
+        handle->index = impl->fileHandles.size();
+        handle->backend = options.ioBackend;
+        handle->stamp = r.stamp();
+        handle->fileSize = r.i64();
+        handle->dataOffset = r.i64();
+        handle->dataSize = r.i64();
+        uint8_t flags = r.u8();
+        handle->bigEndianSamples = flags & FILE_BIG_ENDIAN;
+
+        // Stale as soon as any file differs from when the snapshot was taken
+        if (!r.ok() || statFile(handle->path) != handle->stamp) return nullptr;
+        if (flags & FILE_COMPRESSED) {
+            handle->compressed = std::make_unique<CompressedFile>();
+            if (!handle->compressed->open(handle->path, options.compressedCacheChunks)) return nullptr;
+        }
+
+        file.tracks.resize(r.count(8));
+        for (CueTrack& ct : file.tracks) {
+            ct.number = r.u8();
+            uint8_t mode = r.u8();
+            if (mode > static_cast<uint8_t>(TrackMode::CDI_2352)) r.fail();
+            ct.mode = static_cast<TrackMode>(mode);
+            ct.flags = r.u8();
+            ct.pregap = r.optMsf();
+            ct.postgap = r.optMsf();
+            r.optStr(ct.isrc, alloc);
+            r.optStr(ct.title, alloc);
+            r.optStr(ct.performer, alloc);
+            r.optStr(ct.songwriter, alloc);
+            ct.indices.resize(r.count(4));
+            for (auto& idx : ct.indices) {
+                idx.number = r.u8();
+                idx.position = r.msf();
+            }
+
+            int32_t startLba = r.i32();
+            int32_t lengthSectors = r.i32();
+            int32_t pregapSectors = r.i32();
+            int32_t postgapSectors = r.i32();
+            int64_t fileByteOffset = r.i64();
+            int32_t fileStartLba = r.i32();
+            if (!r.ok() || impl->tracks.full()) return nullptr;
+
+            impl->tracks.emplace_back(
+                ct.number, ct.mode, sectorSizeForMode(ct.mode),
+                startLba, lengthSectors,
+                pregapSectors, postgapSectors,
+                &ct,
+                fi, fileByteOffset,
+                fileStartLba
+            );
+        }
+
+        impl->fileHandles.push_back(std::move(handle));
+    }
+
+    if (!r.ok() || !r.atEnd() || sheet.files.empty()) {
+        spdlog::debug("Ignoring malformed disc snapshot: {}", snapshotPath.string());
+        return nullptr;
+    }
+
+    spdlog::debug("Loaded disc snapshot: {}", snapshotPath.string());
+    return impl;
+}
+
+Status Disc::saveSnapshot(const std::filesystem::path& path) const
+{
+    if (!m_impl->writeSnapshot(path)) return ErrorCode::FileReadError;
+    return {};
+}
+
+} // namespace cuebin
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string_view>
+
+namespace cuebin {
+
+// ASCII case-insensitive comparison against an upper-case literal; CUE
+// keywords, modes and flags are plain ASCII, so no locale is involved
+constexpr bool equalsIgnoreCase(std::string_view s, std::string_view upper) noexcept
+{
+    if (s.size() != upper.size()) return false;
+    for (size_t i = 0; i < s.size(); ++i) {
+        char c = s[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - ('a' - 'A'));
+        if (c != upper[i]) return false;
+    }
+    return true;
+}
+
+} // namespace cuebin
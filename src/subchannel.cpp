@@ -0,0 +1,366 @@
+#include "libcuebin/subchannel.hpp"
+
+#include "discImpl.hpp"
+
+#include <array>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LIBCUEBIN_HAS_SSE2 1
+#endif
+
+namespace cuebin {
+
+namespace {
+
+constexpr int32_t FIRST_SUBCHANNEL_LBA = -MSF::PREGAP_FRAMES;
+constexpr int32_t MAX_SUBCHANNEL_LBA = 100 * MSF::FRAMES_PER_MINUTE - MSF::PREGAP_FRAMES;
+
+constexpr std::array<uint8_t, 100> makeBcdTable()
+{
+    std::array<uint8_t, 100> t{};
+    for (uint8_t i = 0; i < 100; ++i) t[i] = toBcd(i);
+    return t;
+}
+
+// BCD second << 8 | BCD frame for each frame offset within a minute
+constexpr std::array<uint16_t, MSF::FRAMES_PER_MINUTE> makeSecondFrameTable()
+{
+    std::array<uint16_t, MSF::FRAMES_PER_MINUTE> t{};
+    for (int i = 0; i < MSF::FRAMES_PER_MINUTE; ++i) {
+        t[i] = static_cast<uint16_t>(toBcd(static_cast<uint8_t>(i / MSF::FRAMES_PER_SECOND)) << 8
+                                     | toBcd(static_cast<uint8_t>(i % MSF::FRAMES_PER_SECOND)));
+    }
+    return t;
+}
+
+// MSB-first table for the polynomial 0x1021
+constexpr std::array<uint16_t, 256> makeCrc16Table()
+{
+    std::array<uint16_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i << 8;
+        for (int k = 0; k < 8; ++k) c = (c << 1) ^ ((c & 0x8000) ? 0x1021u : 0);
+        t[i] = static_cast<uint16_t>(c);
+    }
+    return t;
+}
+
+constexpr std::array<uint8_t, 256> makeBitReverseTable()
+{
+    std::array<uint8_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t r = 0;
+        for (int k = 0; k < 8; ++k) r |= ((i >> k) & 1) << (7 - k);
+        t[i] = static_cast<uint8_t>(r);
+    }
+    return t;
+}
+
+constexpr auto BCD = makeBcdTable();
+constexpr auto SECOND_FRAME_BCD = makeSecondFrameTable();
+constexpr auto CRC16_TABLE = makeCrc16Table();
+[[maybe_unused]] constexpr auto BIT_REVERSE = makeBitReverseTable();
+
+// `frames` < 100 minutes
+inline void writeMsf(uint8_t* p, int32_t frames) noexcept
+{
+    int32_t minute = frames / MSF::FRAMES_PER_MINUTE;
+    uint16_t sf = SECOND_FRAME_BCD[frames - minute * MSF::FRAMES_PER_MINUTE];
+    p[0] = BCD[minute];
+    p[1] = static_cast<uint8_t>(sf >> 8);
+    p[2] = static_cast<uint8_t>(sf);
+}
+
+inline uint16_t crc16(const uint8_t* data, size_t size) noexcept
+{
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc = static_cast<uint16_t>((crc << 8) ^ CRC16_TABLE[(crc >> 8) ^ data[i]]);
+    }
+    return static_cast<uint16_t>(~crc);
+}
+
+uint8_t controlFor(const Track& track, uint8_t flags) noexcept
+{
+    uint8_t control = track.isData() ? Q_CONTROL_DATA : 0;
+    if (flags & static_cast<uint8_t>(TrackFlag::DCP)) control |= Q_CONTROL_COPY_PERMITTED;
+    if (flags & static_cast<uint8_t>(TrackFlag::CH4)) control |= Q_CONTROL_FOUR_CHANNEL;
+    if (flags & static_cast<uint8_t>(TrackFlag::PRE)) control |= Q_CONTROL_PREEMPHASIS;
+    return static_cast<uint8_t>(control << 4 | 1);
+}
+
+} // anonymous namespace
+
+void deinterleaveSubchannel(std::span<const uint8_t, SUBCHANNEL_SIZE> interleaved,
+                            SubchannelData out) noexcept
+{
+    const uint8_t* in = interleaved.data();
+    uint8_t* dst = out.data();
+#if defined(LIBCUEBIN_HAS_SSE2)
+    // 16 input bytes hold two bytes of every channel. movemask gathers one
+    // channel's bits LSB-first; doubling each byte moves the next channel
+    // into bit 7.
+    for (size_t g = 0; g < SUBCHANNEL_SIZE / 16; ++g) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + g * 16));
+        for (size_t c = 0; c < 8; ++c) {
+            auto bits = static_cast<uint32_t>(_mm_movemask_epi8(v));
+            dst[c * SUBCHANNEL_CHANNEL_SIZE + 2 * g] = BIT_REVERSE[bits & 0xFF];
+            dst[c * SUBCHANNEL_CHANNEL_SIZE + 2 * g + 1] = BIT_REVERSE[bits >> 8];
+            v = _mm_add_epi8(v, v);
+        }
+    }
+#else
+    for (size_t j = 0; j < SUBCHANNEL_CHANNEL_SIZE; ++j) {
+        for (size_t c = 0; c < 8; ++c) {
+            uint32_t byte = 0;
+            for (size_t k = 0; k < 8; ++k) byte = (byte << 1) | ((in[j * 8 + k] >> (7 - c)) & 1);
+            dst[c * SUBCHANNEL_CHANNEL_SIZE + j] = static_cast<uint8_t>(byte);
+        }
+    }
+#endif
+}
+
+void interleaveSubchannel(std::span<const uint8_t, SUBCHANNEL_SIZE> deinterleaved,
+                          SubchannelData out) noexcept
+{
+    const uint8_t* in = deinterleaved.data();
+    uint8_t* dst = out.data();
+#if defined(LIBCUEBIN_HAS_SSE2)
+    // Broadcast two bytes of a channel over the 16 output bytes they cover,
+    // test one bit per lane and merge the results into the channel's bit.
+    const __m128i lanes = _mm_setr_epi8(
+        static_cast<char>(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+        static_cast<char>(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    for (size_t g = 0; g < SUBCHANNEL_SIZE / 16; ++g) {
+        __m128i acc = _mm_setzero_si128();
+        for (size_t c = 0; c < 8; ++c) {
+            const uint8_t* src = in + c * SUBCHANNEL_CHANNEL_SIZE + 2 * g;
+            __m128i x = _mm_cvtsi32_si128(src[0] | (src[1] << 8));
+            x = _mm_unpacklo_epi8(x, x);
+            x = _mm_unpacklo_epi16(x, x);
+            x = _mm_unpacklo_epi32(x, x);
+            __m128i set = _mm_cmpeq_epi8(_mm_and_si128(x, lanes), lanes);
+            acc = _mm_or_si128(acc, _mm_and_si128(set, _mm_set1_epi8(static_cast<char>(0x80 >> c))));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + g * 16), acc);
+    }
+#else
+    for (size_t j = 0; j < SUBCHANNEL_CHANNEL_SIZE; ++j) {
+        for (size_t k = 0; k < 8; ++k) {
+            uint32_t byte = 0;
+            for (size_t c = 0; c < 8; ++c) {
+                byte |= ((in[c * SUBCHANNEL_CHANNEL_SIZE + j] >> (7 - k)) & 1u) << (7 - c);
+            }
+            dst[j * 8 + k] = static_cast<uint8_t>(byte);
+        }
+    }
+#endif
+}
+
+uint16_t subchannelQCrc(std::span<const uint8_t, 10> q) noexcept
+{
+    return crc16(q.data(), q.size());
+}
+
+bool checkSubchannelQ(std::span<const uint8_t, SUBCHANNEL_CHANNEL_SIZE> q) noexcept
+{
+    uint16_t crc = crc16(q.data(), 10);
+    return q[10] == (crc >> 8) && q[11] == (crc & 0xFF);
+}
+
+void Disc::Impl::loadSubchannel(const std::filesystem::path& cuePath)
+{
+    // Records of each file's first sector in a sidecar covering the whole image
+    std::vector<int64_t> fileRecords(fileHandles.size() + 1, 0);
+    for (size_t fi = 0; fi < fileHandles.size(); ++fi) {
+        uint16_t ss = RAW_SECTOR_SIZE;
+        for (const auto& t : tracks) {
+            if (t.fileIndex() == fi) { ss = t.sectorSize(); break; }
+        }
+        fileRecords[fi + 1] = fileRecords[fi] + fileHandles[fi]->dataSize / ss;
+    }
+
+    std::vector<uint8_t> flags;
+    for (const auto& file : sheet.files) {
+        for (const auto& ct : file.tracks) flags.push_back(ct.flags);
+    }
+
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const Track& t = tracks[i];
+        const FileHandle& fh = *fileHandles[t.fileIndex()];
+
+        SubchannelTrack st;
+        st.start = t.startLba();
+        st.begin = i == 0 ? std::min(FIRST_SUBCHANNEL_LBA, st.start) : st.start - t.pregapSectors();
+        st.dataEnd = t.endLba();
+        st.end = st.dataEnd + t.postgapSectors();
+        st.subRecord = fileRecords[t.fileIndex()] + (t.fileByteOffset() - fh.dataOffset) / t.sectorSize();
+        st.track = &t;
+        st.controlAdr = controlFor(t, flags[i]);
+        st.number = t.number();
+
+        // Index positions are file-relative; the track's LBAs start at INDEX 01
+        int32_t index01 = 0;
+        for (const auto& idx : t.indices()) {
+            if (idx.number == 1) index01 = idx.position.toLba();
+        }
+        st.firstIndex = static_cast<uint16_t>(subchannelIndices.size());
+        for (const auto& idx : t.indices()) {
+            if (idx.number < 2) continue;
+            subchannelIndices.push_back({st.start + idx.position.toLba() - index01, idx.number});
+        }
+        st.indexCount = static_cast<uint16_t>(subchannelIndices.size() - st.firstIndex);
+        subchannelTracks.push_back(st);
+    }
+    if (!subchannelTracks.empty()) leadOutControlAdr = subchannelTracks.back().controlAdr;
+
+    std::vector<std::filesystem::path> candidates;
+    for (const char* ext : {".sub", ".SUB"}) {
+        candidates.push_back(std::filesystem::path(cuePath).replace_extension(ext));
+        if (!sheet.files.empty()) {
+            candidates.push_back((baseDir / sheet.files.front().filename).replace_extension(ext));
+        }
+    }
+    for (const auto& path : candidates) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        if (ec || size < SUBCHANNEL_SIZE || !subFile.open(path)) continue;
+        subFileRecords = static_cast<int64_t>(size / SUBCHANNEL_SIZE);
+        if (size % SUBCHANNEL_SIZE != 0) {
+            spdlog::warn("Subchannel file {} is not a whole number of 96-byte records", path.string());
+        }
+        spdlog::info("Using subchannel file {} ({} records)", path.string(), subFileRecords);
+        break;
+    }
+}
+
+void Disc::Impl::synthesizeQ(int32_t lba, uint8_t* q) const noexcept
+{
+    // Last track whose pregap starts at or before `lba`
+    const SubchannelTrack* t = nullptr;
+    size_t lo = 0;
+    size_t hi = subchannelTracks.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (subchannelTracks[mid].begin <= lba) {
+            t = &subchannelTracks[mid];
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    uint8_t index = 1;
+    int32_t relative;
+    if (!t || lba >= t->end) {
+        q[0] = leadOutControlAdr;
+        q[1] = Q_TRACK_LEAD_OUT;
+        relative = lba - totalSectors;
+    } else {
+        q[0] = t->controlAdr;
+        q[1] = BCD[t->number];
+        if (lba < t->start) {
+            index = 0;
+            relative = t->start - lba; // Counts down to INDEX 01
+        } else {
+            relative = lba - t->start;
+            const SubchannelIndex* idx = subchannelIndices.data() + t->firstIndex;
+            for (uint16_t i = 0; i < t->indexCount && idx[i].lba <= lba; ++i) index = idx[i].number;
+        }
+    }
+    q[2] = BCD[index];
+    writeMsf(q + 3, relative);
+    q[6] = 0;
+    writeMsf(q + 7, lba + MSF::PREGAP_FRAMES);
+
+    uint16_t crc = crc16(q, 10);
+    q[10] = static_cast<uint8_t>(crc >> 8);
+    q[11] = static_cast<uint8_t>(crc);
+}
+
+bool Disc::hasSubchannelFile() const noexcept
+{
+    return m_impl->subFile.isOpen();
+}
+
+Status Disc::synthesizeSubchannelQ(int32_t lba, SubchannelQ out) const noexcept
+{
+    if (lba < FIRST_SUBCHANNEL_LBA || lba >= MAX_SUBCHANNEL_LBA) return ErrorCode::LBAOutOfRange;
+    m_impl->synthesizeQ(lba, out.data());
+    return {};
+}
+
+Status Disc::readSubchannel(int32_t lba, SubchannelData out) const noexcept
+{
+    if (lba < FIRST_SUBCHANNEL_LBA || lba >= MAX_SUBCHANNEL_LBA) return ErrorCode::LBAOutOfRange;
+    const auto& d = *m_impl;
+
+    // Stored data only exists for sectors that are in a file
+    if (const Track* trk = d.findTrack(lba)) {
+        if (d.subFile.isOpen()) {
+            const SubchannelTrack& st = d.subchannelTracks[static_cast<size_t>(trk - d.tracks.data())];
+            int64_t record = st.subRecord + (lba - st.start);
+            if (record < d.subFileRecords) {
+                int64_t got = d.subFile.readAt(record * static_cast<int64_t>(SUBCHANNEL_SIZE),
+                                               out.data(), SUBCHANNEL_SIZE);
+                if (got != static_cast<int64_t>(SUBCHANNEL_SIZE)) return ErrorCode::FileReadError;
+                return {};
+            }
+        } else if (trk->sectorSize() > RAW_SECTOR_SIZE) {
+            // CDG: interleaved P..W after the 2352 bytes of audio
+            std::array<uint8_t, SUBCHANNEL_SIZE> raw;
+            int64_t offset = trk->fileByteOffset()
+                           + static_cast<int64_t>(lba - trk->fileStartLba()) * trk->sectorSize()
+                           + static_cast<int64_t>(RAW_SECTOR_SIZE);
+            const auto& fh = *d.fileHandles[trk->fileIndex()];
+            if (!fh.ensureOpen()) return ErrorCode::FileReadError;
+            int64_t got = fh.readAt(offset, raw.data(), SUBCHANNEL_SIZE);
+            if (got != static_cast<int64_t>(SUBCHANNEL_SIZE)) return ErrorCode::FileReadError;
+            deinterleaveSubchannel(raw, out);
+            return {};
+        }
+    }
+
+    // P flags the pause between tracks; R..W carry nothing on a plain disc
+    uint8_t q[SUBCHANNEL_CHANNEL_SIZE];
+    d.synthesizeQ(lba, q);
+    uint8_t p = q[1] != Q_TRACK_LEAD_OUT && q[2] == 0 ? 0xFF : 0x00;
+    std::memset(out.data(), p, SUBCHANNEL_CHANNEL_SIZE);
+    std::memcpy(out.data() + SUBCHANNEL_Q_OFFSET, q, SUBCHANNEL_CHANNEL_SIZE);
+    std::memset(out.data() + SUBCHANNEL_Q_OFFSET + SUBCHANNEL_CHANNEL_SIZE, 0,
+                SUBCHANNEL_SIZE - SUBCHANNEL_Q_OFFSET - SUBCHANNEL_CHANNEL_SIZE);
+    return {};
+}
+
+Status Disc::readSubchannelQ(int32_t lba, SubchannelQ out) const noexcept
+{
+    if (lba < FIRST_SUBCHANNEL_LBA || lba >= MAX_SUBCHANNEL_LBA) return ErrorCode::LBAOutOfRange;
+    const auto& d = *m_impl;
+
+    const Track* trk = d.findTrack(lba);
+    if (trk && d.subFile.isOpen()) {
+        const SubchannelTrack& st = d.subchannelTracks[static_cast<size_t>(trk - d.tracks.data())];
+        int64_t record = st.subRecord + (lba - st.start);
+        if (record < d.subFileRecords) {
+            int64_t got = d.subFile.readAt(record * static_cast<int64_t>(SUBCHANNEL_SIZE)
+                                           + static_cast<int64_t>(SUBCHANNEL_Q_OFFSET),
+                                           out.data(), SUBCHANNEL_CHANNEL_SIZE);
+            if (got != static_cast<int64_t>(SUBCHANNEL_CHANNEL_SIZE)) return ErrorCode::FileReadError;
+            return {};
+        }
+    } else if (trk && trk->sectorSize() > RAW_SECTOR_SIZE) {
+        std::array<uint8_t, SUBCHANNEL_SIZE> all;
+        if (auto status = readSubchannel(lba, all); !status) return status;
+        std::memcpy(out.data(), all.data() + SUBCHANNEL_Q_OFFSET, SUBCHANNEL_CHANNEL_SIZE);
+        return {};
+    }
+
+    d.synthesizeQ(lba, out.data());
+    return {};
+}
+
+} // namespace cuebin
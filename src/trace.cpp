@@ -0,0 +1,23 @@
+#include "libcuebin/trace.hpp"
+
+#include <atomic>
+
+namespace cuebin {
+
+namespace {
+
+std::atomic<TraceObserver*> installedObserver{nullptr};
+
+} // anonymous namespace
+
+void setTraceObserver(TraceObserver* observer) noexcept
+{
+    installedObserver.store(observer, std::memory_order_release);
+}
+
+TraceObserver* traceObserver() noexcept
+{
+    return installedObserver.load(std::memory_order_acquire);
+}
+
+} // namespace cuebin
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "libcuebin/trace.hpp"
+
+// LIBCUEBIN_TRACE(point, args...) fires a trace point: a USDT probe named
+// libcuebin:point when built with LIBCUEBIN_USDT, then the installed
+// TraceObserver. Without LIBCUEBIN_TRACING it expands to nothing and its
+// arguments are never evaluated.
+
+#ifdef LIBCUEBIN_TRACING
+
+#include "libcuebin/cueTypes.hpp"
+
+#ifdef LIBCUEBIN_USDT
+#include <sys/sdt.h>
+#define LIBCUEBIN_SDT(probe) probe
+#else
+#define LIBCUEBIN_SDT(probe) ((void)0)
+#endif
+
+namespace cuebin::detail::trace {
+
+inline void fileOpen(const std::filesystem::path& path, size_t fileIndex, bool ok) noexcept
+{
+    LIBCUEBIN_SDT(DTRACE_PROBE3(libcuebin, file_open, path.c_str(), fileIndex, static_cast<int>(ok)));
+    if (auto* observer = traceObserver()) observer->fileOpen(path, fileIndex, ok);
+}
+
+inline void readBegin(int32_t lba, int32_t sectors, size_t fileIndex, int64_t offset, int64_t size) noexcept
+{
+    LIBCUEBIN_SDT(DTRACE_PROBE5(libcuebin, read_begin, lba, sectors, fileIndex, offset, size));
+    if (auto* observer = traceObserver()) observer->readBegin(lba, sectors, fileIndex, offset, size);
+}
+
+inline void readEnd(int32_t lba, int32_t sectors, size_t fileIndex, int64_t offset, int64_t got) noexcept
+{
+    LIBCUEBIN_SDT(DTRACE_PROBE5(libcuebin, read_end, lba, sectors, fileIndex, offset, got));
+    if (auto* observer = traceObserver()) observer->readEnd(lba, sectors, fileIndex, offset, got);
+}
+
+inline void cacheHit(size_t fileIndex, int64_t blockIndex) noexcept
+{
+    LIBCUEBIN_SDT(DTRACE_PROBE2(libcuebin, cache_hit, fileIndex, blockIndex));
+    if (auto* observer = traceObserver()) observer->cacheHit(fileIndex, blockIndex);
+}
+
+inline void cacheMiss(size_t fileIndex, int64_t blockIndex) noexcept
+{
+    LIBCUEBIN_SDT(DTRACE_PROBE2(libcuebin, cache_miss, fileIndex, blockIndex));
+    if (auto* observer = traceObserver()) observer->cacheMiss(fileIndex, blockIndex);
+}
+
+inline void readError(int32_t lba, int32_t sectors, ErrorCode code) noexcept
+{
+    LIBCUEBIN_SDT(DTRACE_PROBE3(libcuebin, read_error, lba, sectors, static_cast<int>(code)));
+    if (auto* observer = traceObserver()) observer->readError(lba, sectors, code);
+}
+
+inline void parseBegin(const std::filesystem::path& path) noexcept
+{
+    LIBCUEBIN_SDT(DTRACE_PROBE1(libcuebin, parse_begin, path.c_str()));
+    if (auto* observer = traceObserver()) observer->parseBegin(path);
+}
+
+inline void parseEnd(const std::filesystem::path& path, const Result<CueSheet>& sheet) noexcept
+{
+    Status status = sheet ? Status{} : Status(sheet.error().code);
+    size_t tracks = 0;
+    if (sheet) {
+        for (const auto& file : sheet->files) tracks += file.tracks.size();
+    }
+    LIBCUEBIN_SDT(DTRACE_PROBE3(libcuebin, parse_end, path.c_str(),
+                                status ? -1 : static_cast<int>(status.code()), tracks));
+    if (auto* observer = traceObserver()) observer->parseEnd(path, status, tracks);
+}
+
+} // namespace cuebin::detail::trace
+
+#define LIBCUEBIN_TRACE(point, ...) ::cuebin::detail::trace::point(__VA_ARGS__)
+
+#else
+
+#define LIBCUEBIN_TRACE(point, ...) ((void)0)
+
+#endif
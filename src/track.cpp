@@ -5,10 +5,7 @@ namespace cuebin {
 Track::Track(uint8_t number, TrackMode mode, uint16_t sectorSize,
              int32_t startLba, int32_t lengthSectors,
              int32_t pregapSectors, int32_t postgapSectors,
-             std::vector<CueIndex> indices,
-             std::optional<std::string> title,
-             std::optional<std::string> performer,
-             std::optional<std::string> isrc,
+             const CueTrack* source,
              size_t fileIndex, int64_t fileByteOffset,
              int32_t fileStartLba)
     : m_number(number)
@@ -18,31 +15,31 @@ Track::Track(uint8_t number, TrackMode mode, uint16_t sectorSize,
     , m_lengthSectors(lengthSectors)
     , m_pregapSectors(pregapSectors)
     , m_postgapSectors(postgapSectors)
-    , m_indices(std::move(indices))
-    , m_title(std::move(title))
-    , m_performer(std::move(performer))
-    , m_isrc(std::move(isrc))
+    , m_source(source)
     , m_fileIndex(fileIndex)
     , m_fileByteOffset(fileByteOffset)
     , m_fileStartLba(fileStartLba)
 {}
 
-std::optional<std::string_view> Track::title() const noexcept
+static std::optional<std::string_view> view(const std::optional<std::pmr::string>& s) noexcept
 {
-    if (m_title) return std::string_view(*m_title);
+    if (s) return std::string_view(*s);
     return std::nullopt;
 }
 
+std::optional<std::string_view> Track::title() const noexcept
+{
+    return view(m_source->title);
+}
+
 std::optional<std::string_view> Track::performer() const noexcept
 {
-    if (m_performer) return std::string_view(*m_performer);
-    return std::nullopt;
+    return view(m_source->performer);
 }
 
 std::optional<std::string_view> Track::isrc() const noexcept
 {
-    if (m_isrc) return std::string_view(*m_isrc);
-    return std::nullopt;
+    return view(m_source->isrc);
 }
 
 } // namespace cuebin
@@ -0,0 +1,112 @@
+#include "libcuebin/disc.hpp"
+#include "libcuebin/ecc.hpp"
+
+#include "discImpl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+namespace cuebin {
+
+namespace {
+
+struct VerifyChunk {
+    int32_t lba;
+    int32_t count;
+    TrackMode mode;
+};
+
+} // anonymous namespace
+
+Result<VerifyReport> Disc::verify(const VerifyOptions& options) const
+{
+    int32_t chunkSectors = std::max(1, options.chunkSectors);
+
+    // Cooked MODE1/2048 sectors keep no EDC, so there is nothing to check
+    std::vector<VerifyChunk> chunks;
+    int32_t sectorsChecked = 0;
+    for (const auto& trk : m_impl->tracks) {
+        if (trk.isAudio() || trk.mode() == TrackMode::Mode1_2048) continue;
+        for (int32_t lba = trk.startLba(); lba < trk.endLba(); lba += chunkSectors) {
+            int32_t count = std::min(chunkSectors, trk.endLba() - lba);
+            chunks.push_back({lba, count, trk.mode()});
+            sectorsChecked += count;
+        }
+    }
+
+    unsigned threadCount = options.threadCount ? options.threadCount
+                                               : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, chunks.size()));
+
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<bool> failed{false};
+    std::mutex resultMutex;
+    std::vector<SectorIssue> issues;
+    std::optional<Error> error;
+
+    auto worker = [&]() {
+        std::vector<uint8_t> buffer(static_cast<size_t>(chunkSectors) * RAW_SECTOR_SIZE);
+        std::vector<SectorIssue> local;
+
+        while (!failed.load(std::memory_order_relaxed)) {
+            size_t index = nextChunk.fetch_add(1);
+            if (index >= chunks.size()) break;
+            const auto& chunk = chunks[index];
+
+            // One positional read per chunk, straight from the file. 2336-byte
+            // sectors are framed as raw so the EDC offsets line up.
+            Status status = m_impl->forEachSegment(chunk.lba, chunk.count, buffer.data(), nullptr,
+                [](ReadSegment seg) noexcept -> Status {
+                    int64_t bytesRead = seg.file->readPositional(seg.offset, seg.dst, seg.bytes);
+                    if (bytesRead < 0) return ErrorCode::FileSeekError;
+                    seg.rawSectors = seg.packedSize < RAW_SECTOR_SIZE;
+                    return frameSegment(seg, bytesRead);
+                });
+
+            if (!status) {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                if (!error) {
+                    error = LIBCUEBIN_ERROR(status.code(),
+                        "Verify failed to read LBA range [" + std::to_string(chunk.lba) + ", "
+                        + std::to_string(chunk.lba + chunk.count) + ")");
+                }
+                failed = true;
+                break;
+            }
+
+            for (int32_t i = 0; i < chunk.count; ++i) {
+                RawSector sector(buffer.data() + static_cast<size_t>(i) * RAW_SECTOR_SIZE,
+                                 RAW_SECTOR_SIZE);
+                SectorCheck check = checkSector(chunk.mode, sector);
+                if (check != SectorCheck::Ok) {
+                    local.push_back({chunk.lba + i, check == SectorCheck::Repairable});
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(resultMutex);
+        issues.insert(issues.end(), local.begin(), local.end());
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t) threads.emplace_back(worker);
+    if (threadCount > 0) worker();
+    for (auto& t : threads) t.join();
+
+    if (error) return *error;
+
+    std::sort(issues.begin(), issues.end(),
+              [](const SectorIssue& a, const SectorIssue& b) { return a.lba < b.lba; });
+    spdlog::debug("Verified {} sectors: {} bad", sectorsChecked, issues.size());
+
+    VerifyReport report;
+    report.sectorsChecked = sectorsChecked;
+    report.badSectors = std::move(issues);
+    return report;
+}
+
+} // namespace cuebin
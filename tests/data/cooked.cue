@@ -0,0 +1,3 @@
+FILE "cooked.bin" BINARY
+  TRACK 01 MODE1/2048
+    INDEX 01 00:00:00
@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+#include "libcuebin/asyncReader.hpp"
+#include "libcuebin/disc.hpp"
+#include "ioUring.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+class AsyncReaderTest : public ::testing::TestWithParam<AsyncBackend> {
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_async";
+        std::filesystem::create_directories(dir);
+
+        // Raw data track in one file, cooked MODE1/2048 track in another
+        std::vector<uint8_t> raw(2352 * 120, 0xAB);
+        for (size_t i = 0; i < 120; ++i) raw[i * 2352] = static_cast<uint8_t>(i);
+        std::ofstream(dir / "raw.bin", std::ios::binary)
+            .write(reinterpret_cast<const char*>(raw.data()), raw.size());
+
+        std::vector<uint8_t> cooked(2048 * 80, 0x5C);
+        for (size_t i = 0; i < 80; ++i) cooked[i * 2048] = static_cast<uint8_t>(200 + i % 50);
+        std::ofstream(dir / "cooked.bin", std::ios::binary)
+            .write(reinterpret_cast<const char*>(cooked.data()), cooked.size());
+
+        std::ofstream(dir / "async.cue")
+            << "FILE \"raw.bin\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n"
+            << "FILE \"cooked.bin\" BINARY\n  TRACK 02 MODE1/2048\n    INDEX 01 00:00:00\n";
+
+        auto reader = AsyncReader::create({GetParam()});
+        if (!reader && reader.error().code == ErrorCode::Unsupported) {
+            GTEST_SKIP() << reader.error().message;
+        }
+        ASSERT_TRUE(reader.ok()) << reader.error().message;
+        m_reader = std::make_unique<AsyncReader>(std::move(*reader));
+    }
+
+    void TearDown() override {
+        m_reader.reset();
+        std::filesystem::remove_all(dir);
+    }
+
+    AsyncReader& reader() { return *m_reader; }
+
+private:
+    std::unique_ptr<AsyncReader> m_reader;
+};
+
+} // anonymous namespace
+
+TEST_P(AsyncReaderTest, CompletionQueueMatchesSyncReads) {
+    auto disc = Disc::fromCue(dir / "async.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    EXPECT_EQ(reader().backend(), GetParam());
+
+    // Ranges inside each track and one straddling the file boundary
+    struct Range { int32_t lba; int32_t count; };
+    std::vector<Range> ranges = {{0, 1}, {10, 40}, {110, 20}, {125, 50}, {199, 1}};
+
+    std::vector<std::vector<uint8_t>> buffers;
+    std::vector<std::vector<TrackMode>> modes;
+    for (const auto& r : ranges) {
+        buffers.emplace_back(r.count * RAW_SECTOR_SIZE, 0xEE);
+        modes.emplace_back(r.count);
+    }
+
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        auto id = reader().submit(*disc, ranges[i].lba, ranges[i].count, buffers[i], modes[i],
+                                  {}, reinterpret_cast<void*>(i));
+        ASSERT_TRUE(id.ok()) << id.error().message;
+    }
+
+    std::vector<AsyncCompletion> done(ranges.size());
+    size_t received = 0;
+    while (received < ranges.size()) {
+        received += reader().wait(std::span(done).subspan(received));
+    }
+    EXPECT_EQ(reader().inFlight(), 0u);
+
+    for (const auto& c : done) {
+        ASSERT_TRUE(c.status.ok());
+        size_t i = reinterpret_cast<size_t>(c.userData);
+        EXPECT_EQ(c.lba, ranges[i].lba);
+
+        std::vector<uint8_t> expected(ranges[i].count * RAW_SECTOR_SIZE);
+        std::vector<TrackMode> expectedModes(ranges[i].count);
+        ASSERT_TRUE(disc->readSectorsInto(ranges[i].lba, ranges[i].count, expected, expectedModes).ok());
+        EXPECT_EQ(buffers[i], expected) << "range " << i;
+        EXPECT_EQ(modes[i], expectedModes) << "range " << i;
+    }
+}
+
+TEST_P(AsyncReaderTest, CallbacksAcrossDiscs) {
+    auto first = Disc::fromCue(dir / "async.cue");
+    auto second = Disc::fromCue(dir / "async.cue");
+    ASSERT_TRUE(first.ok()) << first.error().message;
+    ASSERT_TRUE(second.ok()) << second.error().message;
+
+    constexpr int kReads = 32;
+    std::vector<std::vector<uint8_t>> buffers(kReads, std::vector<uint8_t>(4 * RAW_SECTOR_SIZE));
+    std::atomic<int> completed{0};
+    std::atomic<int> failed{0};
+
+    for (int i = 0; i < kReads; ++i) {
+        const Disc& disc = (i % 2) ? *second : *first;
+        int32_t lba = (i * 7) % 116;
+        auto id = reader().submit(disc, lba, 4, buffers[i], {},
+            [&, lba, i](const AsyncCompletion& c) {
+                if (!c.status || buffers[i][0] != static_cast<uint8_t>(lba)) ++failed;
+                ++completed;
+            });
+        ASSERT_TRUE(id.ok()) << id.error().message;
+    }
+
+    std::vector<AsyncCompletion> none(1);
+    reader().wait(none);
+    EXPECT_EQ(completed.load(), kReads);
+    EXPECT_EQ(failed.load(), 0);
+    // Callback completions never reach the queue
+    EXPECT_EQ(reader().poll(none), 0u);
+}
+
+TEST_P(AsyncReaderTest, GapSectors) {
+    auto disc = Disc::fromCue(dir / "async.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    // Entirely within the lead-in: nothing to read from any file
+    auto sector = syncWait(reader().readSector(*disc, -5));
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    auto expected = disc->readSector(-5);
+    ASSERT_TRUE(expected.ok());
+    EXPECT_EQ(sector->data, expected->data);
+
+    auto sectors = syncWait(reader().readSectors(*disc, -2, 4));
+    ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+    auto expectedRange = disc->readSectors(-2, 4);
+    ASSERT_TRUE(expectedRange.ok());
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ((*sectors)[i].data, (*expectedRange)[i].data) << "sector " << i;
+    }
+}
+
+TEST_P(AsyncReaderTest, InvalidRequests) {
+    auto disc = Disc::fromCue(dir / "async.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    std::vector<uint8_t> buffer(2 * RAW_SECTOR_SIZE);
+
+    auto id = reader().submit(*disc, 199, 2, buffer);
+    ASSERT_FALSE(id.ok());
+    EXPECT_EQ(id.error().code, ErrorCode::LBAOutOfRange);
+
+    id = reader().submit(*disc, 0, 3, buffer);
+    ASSERT_FALSE(id.ok());
+    EXPECT_EQ(id.error().code, ErrorCode::InvalidArgument);
+
+    EXPECT_EQ(reader().inFlight(), 0u);
+}
+
+TEST_P(AsyncReaderTest, CoroutineReadsMatchSyncReads) {
+    auto disc = Disc::fromCue(dir / "async.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    auto sector = syncWait(reader().readSector(*disc, 130));
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    auto expected = disc->readSector(130);
+    ASSERT_TRUE(expected.ok());
+    EXPECT_EQ(sector->data, expected->data);
+    EXPECT_EQ(sector->mode, TrackMode::Mode1_2048);
+
+    auto sectors = syncWait(reader().readSectors(*disc, 115, 10));
+    ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+    auto expectedRange = disc->readSectors(115, 10);
+    ASSERT_TRUE(expectedRange.ok());
+    ASSERT_EQ(sectors->size(), expectedRange->size());
+    for (size_t i = 0; i < sectors->size(); ++i) {
+        EXPECT_EQ((*sectors)[i].data, (*expectedRange)[i].data) << "sector " << i;
+        EXPECT_EQ((*sectors)[i].mode, (*expectedRange)[i].mode) << "sector " << i;
+    }
+}
+
+TEST_P(AsyncReaderTest, CoroutineResumesOnExecutor) {
+    auto disc = Disc::fromCue(dir / "async.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    // Queues resumptions so they run on the thread that drains it
+    struct QueueExecutor : Executor {
+        std::mutex mutex;
+        std::deque<std::coroutine_handle<>> ready;
+        void post(std::coroutine_handle<> h) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back(h);
+        }
+    } executor;
+
+    std::thread::id resumedOn;
+    bool done = false;
+    auto body = [&]() -> Task<void> {
+        auto sector = co_await reader().readSector(*disc, 5, executor);
+        resumedOn = std::this_thread::get_id();
+        EXPECT_TRUE(sector.ok());
+        if (sector) EXPECT_EQ(sector->data[0], 5);
+        done = true;
+    };
+
+    auto task = body();
+    std::thread driver([&]() {
+        // syncWait starts the task here; it then resumes on the draining thread
+        syncWait(std::move(task));
+    });
+
+    while (!done) {
+        std::coroutine_handle<> h;
+        {
+            std::lock_guard<std::mutex> lock(executor.mutex);
+            if (!executor.ready.empty()) {
+                h = executor.ready.front();
+                executor.ready.pop_front();
+            }
+        }
+        if (h) h.resume();
+        else std::this_thread::yield();
+    }
+    driver.join();
+    EXPECT_EQ(resumedOn, std::this_thread::get_id());
+}
+
+TEST_P(AsyncReaderTest, CoroutineReadErrors) {
+    auto disc = Disc::fromCue(dir / "async.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    auto sector = syncWait(reader().readSector(*disc, 200));
+    ASSERT_FALSE(sector.ok());
+    EXPECT_EQ(sector.error().code, ErrorCode::LBAOutOfRange);
+
+    auto sectors = syncWait(reader().readSectors(*disc, 0, 0));
+    ASSERT_FALSE(sectors.ok());
+    EXPECT_EQ(sectors.error().code, ErrorCode::InvalidArgument);
+    EXPECT_EQ(reader().inFlight(), 0u);
+}
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+TEST_P(AsyncReaderTest, SubmitFailureCompletesRequest) {
+    if (GetParam() != AsyncBackend::IoUring) GTEST_SKIP() << "io_uring submission only";
+    auto disc = Disc::fromCue(dir / "async.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    // A one-entry queue: the range's two file reads need two submissions
+    auto reader = AsyncReader::create({AsyncBackend::IoUring, 1});
+    ASSERT_TRUE(reader.ok()) << reader.error().message;
+    std::vector<uint8_t> buffer(20 * RAW_SECTOR_SIZE);
+    std::array<AsyncCompletion, 1> done{};
+
+    // Failing before either read reached the kernel, then after the first did
+    for (unsigned skip : {0u, 1u}) {
+        detail::failIoUringSubmit(skip);
+        auto id = reader->submit(*disc, 110, 20, buffer);
+        ASSERT_TRUE(id.ok()) << id.error().message;
+        ASSERT_EQ(reader->wait(done, 1), 1u) << "skip " << skip;
+        EXPECT_EQ(done[0].id, *id);
+        EXPECT_EQ(done[0].status.code(), ErrorCode::FileReadError) << "skip " << skip;
+        EXPECT_EQ(reader->inFlight(), 0u);
+    }
+
+    // The ring is still usable afterwards
+    auto id = reader->submit(*disc, 110, 20, buffer);
+    ASSERT_TRUE(id.ok()) << id.error().message;
+    ASSERT_EQ(reader->wait(done, 1), 1u);
+    EXPECT_TRUE(done[0].status) << static_cast<int>(done[0].status.code());
+    auto expected = disc->readSectors(110, 20);
+    ASSERT_TRUE(expected.ok());
+    for (size_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(std::memcmp(buffer.data() + i * RAW_SECTOR_SIZE, (*expected)[i].data.data(),
+                              RAW_SECTOR_SIZE), 0) << "sector " << i;
+    }
+}
+#endif
+
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncReaderTest,
+    ::testing::Values(AsyncBackend::ThreadPool, AsyncBackend::IoUring),
+    [](const auto& info) {
+        return info.param == AsyncBackend::IoUring ? "IoUring" : "ThreadPool";
+    });
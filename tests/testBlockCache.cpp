@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "libcuebin/blockCache.hpp"
+#include "libcuebin/disc.hpp"
+#include "blockCacheInternal.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+class BlockCacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_blockcache";
+        std::filesystem::create_directories(dir);
+
+        // 200 sectors = ~459 KiB, spanning several cache blocks
+        std::ofstream bin(dir / "cache.bin", std::ios::binary);
+        std::vector<uint8_t> data(2352 * 200, 0xCC);
+        for (size_t i = 0; i < 200; ++i) data[i * 2352] = static_cast<uint8_t>(i);
+        bin.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+        std::ofstream cue(dir / "cache.cue");
+        cue << "FILE \"cache.bin\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+
+        m_savedCapacity = BlockCache::capacity();
+        BlockCache::clear();
+        BlockCache::resetStats();
+    }
+
+    void TearDown() override {
+        BlockCache::setCapacity(m_savedCapacity);
+        BlockCache::clear();
+        std::filesystem::remove_all(dir);
+    }
+
+    static DiscOptions cached()
+    {
+        DiscOptions options;
+        options.useBlockCache = true;
+        return options;
+    }
+
+private:
+    size_t m_savedCapacity = 0;
+};
+
+} // anonymous namespace
+
+TEST_F(BlockCacheTest, SharedAcrossDiscs) {
+    auto first = Disc::fromCue(dir / "cache.cue", cached());
+    ASSERT_TRUE(first.ok()) << first.error().message;
+
+    auto sector = first->readSector(3);
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    EXPECT_EQ(sector->data[0], 3);
+
+    auto stats = BlockCache::stats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.bytesUsed, BlockCache::BLOCK_SIZE);
+
+    // A second Disc on the same image hits the block loaded by the first
+    auto second = Disc::fromCue(dir / "cache.cue", cached());
+    ASSERT_TRUE(second.ok()) << second.error().message;
+
+    sector = second->readSector(4);
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    EXPECT_EQ(sector->data[0], 4);
+    EXPECT_EQ(sector->data[2351], 0xCC);
+
+    stats = BlockCache::stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+TEST_F(BlockCacheTest, SectorsStraddlingBlocks) {
+    auto disc = Disc::fromCue(dir / "cache.cue", cached());
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    // Read everything twice: cold, then fully cached. Both must be exact.
+    for (int pass = 0; pass < 2; ++pass) {
+        auto sectors = disc->readSectors(0, 200);
+        ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+        for (int i = 0; i < 200; ++i) {
+            EXPECT_EQ((*sectors)[i].data[0], i);
+            EXPECT_EQ((*sectors)[i].data[1], 0xCC);
+            EXPECT_EQ((*sectors)[i].data[2351], 0xCC);
+        }
+    }
+
+    auto stats = BlockCache::stats();
+    EXPECT_GT(stats.hits, 0u);
+    // 200 sectors fit in 8 blocks, each loaded exactly once
+    EXPECT_EQ(stats.misses, 8u);
+}
+
+TEST_F(BlockCacheTest, OffByDefault) {
+    auto disc = Disc::fromCue(dir / "cache.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    for (int i = 0; i < 10; ++i) {
+        auto sector = disc->readSector(i);
+        ASSERT_TRUE(sector.ok()) << sector.error().message;
+    }
+
+    auto stats = BlockCache::stats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(stats.bytesUsed, 0u);
+}
+
+TEST_F(BlockCacheTest, CapacityIsEnforced) {
+    // Room for exactly one block per shard
+    BlockCache::setCapacity(16 * BlockCache::BLOCK_SIZE);
+
+    auto disc = Disc::fromCue(dir / "cache.cue", cached());
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    for (int pass = 0; pass < 3; ++pass) {
+        auto sectors = disc->readSectors(0, 200);
+        ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+        EXPECT_EQ((*sectors)[150].data[0], 150);
+    }
+
+    auto stats = BlockCache::stats();
+    EXPECT_LE(stats.bytesUsed, BlockCache::capacity());
+
+    BlockCache::setCapacity(0);
+    EXPECT_EQ(BlockCache::stats().bytesUsed, 0u);
+
+    // With no capacity nothing is retained, but reads still succeed
+    auto sector = disc->readSector(42);
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    EXPECT_EQ(sector->data[0], 42);
+    EXPECT_EQ(BlockCache::stats().bytesUsed, 0u);
+}
+
+TEST_F(BlockCacheTest, FileIdsFollowOpenDiscs) {
+    size_t before = detail::blockCacheFileIdCount();
+    {
+        auto first = Disc::fromCue(dir / "cache.cue", cached());
+        auto second = Disc::fromCue(dir / "cache.cue", cached());
+        ASSERT_TRUE(first.ok() && second.ok());
+        EXPECT_EQ(detail::blockCacheFileIdCount(), before + 1); // Shared by both
+
+        first = Disc::fromCue(dir / "cache.cue"); // Uncached: releases its reference
+        EXPECT_EQ(detail::blockCacheFileIdCount(), before + 1);
+    }
+    EXPECT_EQ(detail::blockCacheFileIdCount(), before);
+
+    // Distinct files opened one after another do not accumulate
+    for (int i = 0; i < 20; ++i) {
+        auto bin = dir / ("copy" + std::to_string(i) + ".bin");
+        std::filesystem::copy_file(dir / "cache.bin", bin);
+        std::ofstream(dir / "copy.cue") << "FILE \"" << bin.filename().string()
+                                        << "\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+        auto disc = Disc::fromCue(dir / "copy.cue", cached());
+        ASSERT_TRUE(disc.ok()) << disc.error().message;
+        ASSERT_TRUE(disc->readSector(0).ok());
+    }
+    EXPECT_EQ(detail::blockCacheFileIdCount(), before);
+}
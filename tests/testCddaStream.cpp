@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "libcuebin/cddaStream.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+constexpr size_t SECTOR_FRAMES = CddaStream::FRAMES_PER_SECTOR;
+
+std::vector<uint8_t> pattern(size_t sectors, uint8_t seed)
+{
+    std::vector<uint8_t> data(sectors * RAW_SECTOR_SIZE);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 7 + i / 2352 + seed);
+    return data;
+}
+
+void writeFile(const std::filesystem::path& path, const std::vector<uint8_t>& data)
+{
+    std::ofstream(path, std::ios::binary)
+        .write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+// Pulls exactly `frames` frames, as an audio callback would, waiting out underruns
+std::vector<int16_t> pull(CddaStream& stream, size_t frames)
+{
+    std::vector<int16_t> out;
+    std::vector<int16_t> buffer(2 * 1000);
+    while (out.size() < frames * 2 && !stream.finished()) {
+        size_t want = std::min<size_t>(1000, frames - out.size() / 2);
+        size_t got = stream.read(std::span<int16_t>(buffer).first(want * 2));
+        out.insert(out.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(got * 2));
+        if (got == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return out;
+}
+
+class CddaStreamTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+    std::vector<uint8_t> audio;    // Tracks 2 and 3
+    std::vector<uint8_t> motorola; // Track 4, big-endian samples
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_cdda";
+        std::filesystem::create_directories(dir);
+
+        audio = pattern(70, 1);
+        motorola = pattern(20, 2);
+        writeFile(dir / "data.bin", std::vector<uint8_t>(10 * RAW_SECTOR_SIZE));
+        writeFile(dir / "audio.bin", audio);
+        writeFile(dir / "motorola.bin", motorola);
+        std::ofstream(dir / "disc.cue")
+            << "FILE \"data.bin\" BINARY\n"
+            << "  TRACK 01 MODE1/2352\n    INDEX 01 00:00:00\n"
+            << "FILE \"audio.bin\" BINARY\n"
+            << "  TRACK 02 AUDIO\n    INDEX 01 00:00:00\n    POSTGAP 00:00:03\n"
+            << "  TRACK 03 AUDIO\n    PREGAP 00:00:02\n    INDEX 01 00:00:40\n    INDEX 02 00:00:50\n"
+            << "FILE \"motorola.bin\" MOTOROLA\n"
+            << "  TRACK 04 AUDIO\n    INDEX 01 00:00:00\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    // Tracks 2-4 as they should be played: gaps as silence, native byte order
+    std::vector<uint8_t> expected() const {
+        std::vector<uint8_t> pcm(audio.begin(), audio.begin() + 40 * RAW_SECTOR_SIZE);
+        pcm.resize(pcm.size() + 5 * RAW_SECTOR_SIZE);
+        pcm.insert(pcm.end(), audio.begin() + 40 * RAW_SECTOR_SIZE, audio.end());
+        for (size_t i = 0; i < motorola.size(); i += 2) {
+            pcm.push_back(motorola[i + 1]);
+            pcm.push_back(motorola[i]);
+        }
+        return pcm;
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(CddaStreamTest, PlaysGaplessWithGapsAndByteSwap) {
+    auto disc = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    CddaStreamOptions options;
+    options.bufferFrames = 4096; // Much smaller than the program: forces wraparound
+    options.chunkSectors = 3;
+    auto stream = CddaStream::open(*disc, options);
+    ASSERT_TRUE(stream.ok()) << stream.error().message;
+    EXPECT_EQ(stream->totalFrames(), 95 * SECTOR_FRAMES);
+
+    auto pcm = pull(*stream, stream->totalFrames());
+    EXPECT_TRUE(stream->finished());
+    EXPECT_TRUE(stream->status().ok());
+
+    auto want = expected();
+    ASSERT_EQ(pcm.size() * 2, want.size());
+    EXPECT_EQ(std::memcmp(pcm.data(), want.data(), want.size()), 0);
+
+    // Past the end: silence, no underrun
+    std::vector<int16_t> tail(64, 1);
+    uint64_t underruns = stream->underruns();
+    EXPECT_EQ(stream->read(tail), 0u);
+    EXPECT_EQ(tail, std::vector<int16_t>(64, 0));
+    EXPECT_EQ(stream->underruns(), underruns);
+}
+
+TEST_F(CddaStreamTest, ReportsTrackAndIndexPosition) {
+    auto disc = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    auto stream = CddaStream::open(*disc);
+    ASSERT_TRUE(stream.ok()) << stream.error().message;
+
+    auto pos = stream->position();
+    EXPECT_EQ(pos.track, 2);
+    EXPECT_EQ(pos.index, 1);
+    EXPECT_EQ(pos.lba, 10);
+
+    pull(*stream, 40 * SECTOR_FRAMES + 100);
+    pos = stream->position();
+    EXPECT_EQ(pos.track, 2); // POSTGAP
+    EXPECT_EQ(pos.lba, 50);
+    EXPECT_EQ(pos.frameInSector, 100u);
+
+    pull(*stream, 4 * SECTOR_FRAMES);
+    pos = stream->position();
+    EXPECT_EQ(pos.track, 3); // PREGAP
+    EXPECT_EQ(pos.index, 0);
+
+    pull(*stream, SECTOR_FRAMES);
+    pos = stream->position();
+    EXPECT_EQ(pos.track, 3);
+    EXPECT_EQ(pos.index, 1);
+    EXPECT_EQ(pos.lba, disc->track(3)->startLba());
+
+    pull(*stream, 10 * SECTOR_FRAMES);
+    EXPECT_EQ(stream->position().index, 2);
+
+    pull(*stream, 20 * SECTOR_FRAMES);
+    EXPECT_EQ(stream->position().track, 4);
+}
+
+TEST_F(CddaStreamTest, TrackRanges) {
+    auto disc = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    CddaStreamOptions options;
+    options.firstTrack = 4;
+    auto last = CddaStream::open(*disc, options);
+    ASSERT_TRUE(last.ok()) << last.error().message;
+    EXPECT_EQ(last->totalFrames(), 20 * SECTOR_FRAMES);
+
+    options.firstTrack = 1;
+    options.lastTrack = 1;
+    auto data = CddaStream::open(*disc, options);
+    ASSERT_FALSE(data.ok());
+    EXPECT_EQ(data.error().code, ErrorCode::InvalidArgument);
+
+    options.firstTrack = 3;
+    options.lastTrack = 9;
+    EXPECT_FALSE(CddaStream::open(*disc, options).ok());
+}
+
+TEST_F(CddaStreamTest, DestroyWhileProducing) {
+    auto disc = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    CddaStreamOptions options;
+    options.bufferFrames = 1024;
+    options.chunkSectors = 1;
+    auto stream = CddaStream::open(*disc, options);
+    ASSERT_TRUE(stream.ok());
+    pull(*stream, 10);
+    // The producer is blocked on a full ring; the destructor must stop it
+}
@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include "libcuebin/asyncReader.hpp"
+#include "libcuebin/compressedImage.hpp"
+#include "libcuebin/hash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+class CompressedImageTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+
+    static constexpr int32_t DATA_SECTORS = 100;
+    static constexpr int32_t AUDIO_SECTORS = 150;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_cbc";
+        std::filesystem::create_directories(dir / "out");
+
+        // Data sectors: a header and some bytes, the rest zero padding;
+        // the last 40 sectors are entirely zero
+        std::vector<uint8_t> data(static_cast<size_t>(DATA_SECTORS) * RAW_SECTOR_SIZE, 0);
+        for (int32_t s = 0; s < DATA_SECTORS - 40; ++s) {
+            uint8_t* sector = data.data() + static_cast<size_t>(s) * RAW_SECTOR_SIZE;
+            for (size_t i = 0; i < 300; ++i) sector[i] = static_cast<uint8_t>(s * 31 + i * i);
+        }
+
+        // Audio: two tones, then silence
+        std::vector<uint8_t> audio(static_cast<size_t>(AUDIO_SECTORS) * RAW_SECTOR_SIZE, 0);
+        size_t toneFrames = 100 * 588;
+        for (size_t f = 0; f < toneFrames; ++f) {
+            auto left = static_cast<int16_t>(8000 * std::sin(f * 0.031) + 50 * std::sin(f * 1.7));
+            auto right = static_cast<int16_t>(6000 * std::sin(f * 0.047));
+            uint8_t* p = audio.data() + f * 4;
+            p[0] = static_cast<uint8_t>(left);
+            p[1] = static_cast<uint8_t>(static_cast<uint16_t>(left) >> 8);
+            p[2] = static_cast<uint8_t>(right);
+            p[3] = static_cast<uint8_t>(static_cast<uint16_t>(right) >> 8);
+        }
+
+        std::ofstream bin(dir / "disc.bin", std::ios::binary);
+        bin.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        bin.write(reinterpret_cast<const char*>(audio.data()), static_cast<std::streamsize>(audio.size()));
+        bin.close();
+        std::ofstream(dir / "disc.cue")
+            << "TITLE \"Compressed\"\n"
+            << "FILE \"disc.bin\" BINARY\n"
+            << "  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n"
+            << "  TRACK 02 AUDIO\n    INDEX 00 00:01:25\n    INDEX 01 00:01:27\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    void expectSameSectors(const Disc& a, const Disc& b) {
+        ASSERT_EQ(a.totalSectors(), b.totalSectors());
+        auto left = a.readSectors(0, a.totalSectors());
+        auto right = b.readSectors(0, b.totalSectors());
+        ASSERT_TRUE(left.ok()) << left.error().message;
+        ASSERT_TRUE(right.ok()) << right.error().message;
+        for (int32_t i = 0; i < a.totalSectors(); ++i) {
+            ASSERT_EQ((*left)[i].data, (*right)[i].data) << "LBA " << i;
+        }
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(CompressedImageTest, RoundTripThroughDisc) {
+    auto original = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(original.ok()) << original.error().message;
+
+    auto stats = compressDisc(*original, dir / "out" / "disc.cue");
+    ASSERT_TRUE(stats.ok()) << stats.error().message;
+    EXPECT_EQ(stats->inputBytes, static_cast<uint64_t>(DATA_SECTORS + AUDIO_SECTORS) * RAW_SECTOR_SIZE);
+    EXPECT_LT(stats->outputBytes * 3, stats->inputBytes);
+    EXPECT_GT(stats->codecChunks[static_cast<size_t>(ChunkCodec::Zero)], 0u);
+    EXPECT_GT(stats->codecChunks[static_cast<size_t>(ChunkCodec::DeltaDeflate)], 0u);
+    EXPECT_TRUE(std::filesystem::exists(dir / "out" / "disc.bin.cbc"));
+
+    for (auto backend : {IoBackend::Stream, IoBackend::Mmap, IoBackend::Positional}) {
+        DiscOptions options;
+        options.ioBackend = backend;
+        options.compressedCacheChunks = 2;
+        auto compressed = Disc::fromCue(dir / "out" / "disc.cue", options);
+        ASSERT_TRUE(compressed.ok()) << compressed.error().message;
+        EXPECT_EQ(compressed->title(), "Compressed");
+        expectSameSectors(*original, *compressed);
+
+        auto user = compressed->readUserDataRange(DATA_SECTORS, 10);
+        auto expected = original->readUserDataRange(DATA_SECTORS, 10);
+        ASSERT_TRUE(user.ok()) << user.error().message;
+        EXPECT_EQ(*user, *expected);
+    }
+
+    // Hashes describe the original BIN, so DAT matching still works
+    auto compressed = Disc::fromCue(dir / "out" / "disc.cue");
+    ASSERT_TRUE(compressed.ok());
+    auto a = hashDisc(*original);
+    auto b = hashDisc(*compressed);
+    ASSERT_TRUE(a.ok() && b.ok());
+    EXPECT_EQ(a->files[0].digest, b->files[0].digest);
+    ASSERT_EQ(b->tracks.size(), 2u);
+    EXPECT_EQ(a->tracks[1].digest, b->tracks[1].digest);
+}
+
+TEST_F(CompressedImageTest, ConcurrentRandomAccess) {
+    std::vector<ByteExtent> audio = {{DATA_SECTORS * static_cast<int64_t>(RAW_SECTOR_SIZE),
+                                      (DATA_SECTORS + AUDIO_SECTORS) * static_cast<int64_t>(RAW_SECTOR_SIZE)}};
+    CompressOptions options;
+    options.chunkSectors = 4;
+    auto stats = compressFile(dir / "disc.bin", dir / "out" / "disc.cbc", audio, options);
+    ASSERT_TRUE(stats.ok()) << stats.error().message;
+    EXPECT_EQ(stats->chunks, static_cast<uint32_t>((DATA_SECTORS + AUDIO_SECTORS + 3) / 4));
+
+    // Same single-track layout on both sides, so LBAs map to the same bytes
+    std::ofstream(dir / "out" / "disc.cue")
+        << "FILE \"disc.cbc\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+    std::ofstream(dir / "plain.cue")
+        << "FILE \"disc.bin\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+    auto original = Disc::fromCue(dir / "plain.cue");
+    DiscOptions discOptions;
+    discOptions.ioBackend = IoBackend::Positional;
+    discOptions.compressedCacheChunks = 3;
+    auto compressed = Disc::fromCue(dir / "out" / "disc.cue", discOptions);
+    ASSERT_TRUE(original.ok() && compressed.ok());
+    ASSERT_EQ(compressed->totalSectors(), DATA_SECTORS + AUDIO_SECTORS);
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            uint32_t x = 12345u + static_cast<uint32_t>(t);
+            for (int i = 0; i < 200; ++i) {
+                x = x * 1664525 + 1013904223;
+                auto lba = static_cast<int32_t>(x % static_cast<uint32_t>(DATA_SECTORS + AUDIO_SECTORS - 3));
+                auto a = original->readSectors(lba, 3);
+                auto b = compressed->readSectors(lba, 3);
+                if (!a.ok() || !b.ok() || (*a)[0].data != (*b)[0].data || (*a)[2].data != (*b)[2].data) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(mismatches.load(), 0);
+
+    // io_uring cannot read compressed bytes; the request is decoded in place
+    auto reader = AsyncReader::create();
+    ASSERT_TRUE(reader.ok());
+    auto sectors = syncWait(reader->readSectors(*compressed, 120, 5));
+    ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+    EXPECT_EQ((*sectors)[4].data, original->readSector(124)->data);
+}
+
+TEST_F(CompressedImageTest, DetectsCorruption) {
+    auto stats = compressFile(dir / "disc.bin", dir / "out" / "disc.cbc");
+    ASSERT_TRUE(stats.ok()) << stats.error().message;
+    std::ofstream(dir / "out" / "disc.cue")
+        << "FILE \"disc.cbc\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+
+    {
+        // First chunk's payload starts right after the 40-byte header
+        std::fstream f(dir / "out" / "disc.cbc", std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(60);
+        f.put('\x5A');
+    }
+
+    auto disc = Disc::fromCue(dir / "out" / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    EXPECT_FALSE(disc->readSector(0).ok());
+    EXPECT_TRUE(disc->readSector(DATA_SECTORS + 10).ok());
+
+    std::ofstream(dir / "out" / "disc.cbc", std::ios::binary | std::ios::trunc) << "CUEBINZ1 truncated";
+    EXPECT_FALSE(Disc::fromCue(dir / "out" / "disc.cue").ok());
+
+    CompressOptions bad;
+    bad.level = 0;
+    EXPECT_EQ(compressFile(dir / "disc.bin", dir / "out" / "x.cbc", {}, bad).error().code,
+              ErrorCode::InvalidArgument);
+}
+
+TEST_F(CompressedImageTest, RejectsOutOfBoundsIndex) {
+    std::ofstream(dir / "out" / "disc.cue")
+        << "FILE \"disc.cbc\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+    auto stats = compressFile(dir / "disc.bin", dir / "out" / "disc.cbc");
+    ASSERT_TRUE(stats.ok()) << stats.error().message;
+    std::ifstream in(dir / "out" / "disc.cbc", std::ios::binary);
+    std::vector<uint8_t> pristine((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    uint64_t indexOffset = 0;
+    for (int i = 7; i >= 0; --i) indexOffset = indexOffset << 8 | pristine[32 + static_cast<size_t>(i)];
+
+    // Opens a copy of the image with `bytes` written at `offset`
+    auto openPatched = [&](uint64_t offset, const std::vector<uint8_t>& bytes) {
+        auto image = pristine;
+        std::copy(bytes.begin(), bytes.end(), image.begin() + static_cast<std::ptrdiff_t>(offset));
+        std::ofstream(dir / "out" / "disc.cbc", std::ios::binary | std::ios::trunc)
+            .write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        return Disc::fromCue(dir / "out" / "disc.cue").ok();
+    };
+
+    EXPECT_TRUE(openPatched(0, {}));
+    // Index offset past the end of the file
+    EXPECT_FALSE(openPatched(32, {0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00}));
+    // First chunk's stored size reaching into the index
+    EXPECT_FALSE(openPatched(indexOffset + 8, {0x00, 0x00, 0x10, 0x00}));
+    // First chunk's payload offset past the index
+    EXPECT_FALSE(openPatched(indexOffset, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F}));
+}
+
+TEST_F(CompressedImageTest, RejectsBadChunkSize) {
+    std::ofstream(dir / "out" / "disc.cue")
+        << "FILE \"disc.cbc\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+
+    // The whole image in one chunk, so any larger chunk size keeps the count
+    CompressOptions options;
+    options.chunkSectors = DATA_SECTORS + AUDIO_SECTORS;
+    auto stats = compressFile(dir / "disc.bin", dir / "out" / "disc.cbc", {}, options);
+    ASSERT_TRUE(stats.ok()) << stats.error().message;
+    ASSERT_EQ(stats->chunks, 1u);
+    std::ifstream in(dir / "out" / "disc.cbc", std::ios::binary);
+    std::vector<uint8_t> pristine((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    auto openWithChunkBytes = [&](uint32_t chunkBytes) {
+        auto image = pristine;
+        for (size_t i = 0; i < 4; ++i) image[12 + i] = static_cast<uint8_t>(chunkBytes >> (8 * i));
+        std::ofstream(dir / "out" / "disc.cbc", std::ios::binary | std::ios::trunc)
+            .write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        return Disc::fromCue(dir / "out" / "disc.cue").ok();
+    };
+
+    EXPECT_TRUE(openWithChunkBytes(options.chunkSectors * RAW_SECTOR_SIZE));
+    EXPECT_TRUE(openWithChunkBytes(1024 * RAW_SECTOR_SIZE));
+    // Not whole sectors, above the largest chunk the writer makes, and huge
+    EXPECT_FALSE(openWithChunkBytes(options.chunkSectors * RAW_SECTOR_SIZE + 1));
+    EXPECT_FALSE(openWithChunkBytes(1025 * RAW_SECTOR_SIZE));
+    EXPECT_FALSE(openWithChunkBytes(0xFFFFFFFF));
+
+    options.chunkSectors = 1025;
+    EXPECT_EQ(compressFile(dir / "disc.bin", dir / "out" / "x.cbc", {}, options).error().code,
+              ErrorCode::InvalidArgument);
+}
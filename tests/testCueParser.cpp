@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "libcuebin/cueParser.hpp"
+#include "libcuebin/cueWriter.hpp"
 
 #include <filesystem>
 
@@ -112,6 +113,35 @@ TEST(CueParserTest, ParseString) {
     EXPECT_EQ(sheet.files[0].tracks[0].mode, TrackMode::Mode1_2352);
 }
 
+TEST(CueParserTest, KeywordsAreCaseInsensitive) {
+    // CRLF line endings, mixed case, and no newline after the last line
+    std::string text = "title \"Disc\"\r\n"
+                       "File \"a b.bin\" binary\r\n"
+                       "  Track 01 mode2/2352\r\n"
+                       "    flags dcp Pre\r\n"
+                       "    Performer Someone Else\r\n"
+                       "    pregap 00:02:00\r\n"
+                       "    index 01 00:00:00\r\n"
+                       "  TRACKS are not a directive\r\n"
+                       "    Rem COMMENT x";
+    auto result = CueParser::parseString(text);
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    const auto& sheet = *result;
+    EXPECT_EQ(sheet.title, "Disc");
+    ASSERT_EQ(sheet.files.size(), 1u);
+    EXPECT_EQ(sheet.files[0].filename, "a b.bin");
+    ASSERT_EQ(sheet.files[0].tracks.size(), 1u);
+    const auto& track = sheet.files[0].tracks[0];
+    EXPECT_EQ(track.mode, TrackMode::Mode2_2352);
+    EXPECT_EQ(track.flags, static_cast<uint8_t>(TrackFlag::DCP) | static_cast<uint8_t>(TrackFlag::PRE));
+    EXPECT_EQ(track.performer, "Someone Else");
+    EXPECT_EQ(track.pregap, MSF(0, 2, 0));
+    ASSERT_EQ(track.indices.size(), 1u);
+    ASSERT_EQ(sheet.remarks.size(), 1u);
+    EXPECT_EQ(sheet.remarks[0], " COMMENT x");
+}
+
 TEST(CueParserTest, AllTrackModes) {
     const char* cue_text = R"(FILE "test.bin" BINARY
   TRACK 01 AUDIO
@@ -226,3 +256,37 @@ TEST(CueParserTest, SectorSizes) {
     EXPECT_EQ(sectorSizeForMode(TrackMode::CDI_2336), 2336u);
     EXPECT_EQ(sectorSizeForMode(TrackMode::CDI_2352), 2352u);
 }
+
+TEST(CueParserTest, WriterRoundTrip) {
+    auto original = CueParser::parseFile(DATA_DIR / "metadata.cue");
+    ASSERT_TRUE(original.ok()) << original.error().message;
+
+    std::string text = CueWriter::toString(*original);
+    auto reparsed = CueParser::parseString(text);
+    ASSERT_TRUE(reparsed.ok()) << reparsed.error().message;
+    EXPECT_EQ(CueWriter::toString(*reparsed), text);
+
+    const auto& sheet = *reparsed;
+    EXPECT_EQ(sheet.remarks, original->remarks);
+    EXPECT_EQ(sheet.catalog, original->catalog);
+    EXPECT_EQ(sheet.title, original->title);
+    ASSERT_EQ(sheet.files.size(), 1u);
+    EXPECT_EQ(sheet.files[0].filename, "metadata.bin");
+    ASSERT_EQ(sheet.files[0].tracks.size(), 3u);
+    for (size_t i = 0; i < 3; ++i) {
+        const auto& a = original->files[0].tracks[i];
+        const auto& b = sheet.files[0].tracks[i];
+        EXPECT_EQ(b.number, a.number);
+        EXPECT_EQ(b.mode, a.mode);
+        EXPECT_EQ(b.flags, a.flags);
+        EXPECT_EQ(b.isrc, a.isrc);
+        EXPECT_EQ(b.title, a.title);
+        EXPECT_EQ(b.pregap, a.pregap);
+        EXPECT_EQ(b.postgap, a.postgap);
+        ASSERT_EQ(b.indices.size(), a.indices.size());
+        for (size_t j = 0; j < a.indices.size(); ++j) {
+            EXPECT_EQ(b.indices[j].number, a.indices[j].number);
+            EXPECT_EQ(b.indices[j].position, a.indices[j].position);
+        }
+    }
+}
@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 #include "libcuebin/disc.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 
 using namespace cuebin;
 
@@ -22,6 +26,16 @@ void createBinFile(const std::filesystem::path& path, size_t size, uint8_t fill
     f.write(reinterpret_cast<const char*>(data.data()), data.size());
 }
 
+// Helper to create a MODE1/2048 BIN file: first byte of each sector = sector index
+void createCookedBinFile(const std::filesystem::path& path, size_t sectors) {
+    std::ofstream f(path, std::ios::binary);
+    std::vector<uint8_t> data(sectors * 2048, 0x55);
+    for (size_t i = 0; i < sectors; ++i) {
+        data[i * 2048] = static_cast<uint8_t>(i & 0xFF);
+    }
+    f.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
 class DiscTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -45,6 +59,9 @@ protected:
         // metadata.cue: "metadata.bin"
         int32_t metaFrames = MSF(40, 0, 0).toLba();
         createBinFile(DATA_DIR / "metadata.bin", static_cast<size_t>(metaFrames) * 2352);
+
+        // cooked.cue: "cooked.bin" MODE1/2048, one marker per 2048-byte sector
+        createCookedBinFile(DATA_DIR / "cooked.bin", 50);
     }
 
     void TearDown() override {
@@ -55,6 +72,7 @@ protected:
         std::filesystem::remove(DATA_DIR / "audio02.bin");
         std::filesystem::remove(DATA_DIR / "audio03.bin");
         std::filesystem::remove(DATA_DIR / "metadata.bin");
+        std::filesystem::remove(DATA_DIR / "cooked.bin");
     }
 };
 
@@ -199,7 +217,7 @@ TEST_F(DiscTest, ReadSectorOutOfRange) {
 
     auto& disc = *result;
 
-    auto sector = disc.readSector(-1);
+    auto sector = disc.readSector(Disc::FIRST_LBA - 1);
     EXPECT_FALSE(sector.ok());
     EXPECT_EQ(sector.error().code, ErrorCode::LBAOutOfRange);
 
@@ -278,3 +296,550 @@ TEST_F(DiscTest, MoveConstruction) {
     Disc disc2 = std::move(disc1);
     EXPECT_EQ(disc2.trackCount(), 1u);
 }
+
+TEST_F(DiscTest, ReadSectorMmap) {
+    DiscOptions options;
+    options.ioBackend = IoBackend::Mmap;
+    auto result = Disc::fromCue(DATA_DIR / "multiFile.cue", options);
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+
+    auto sector = disc.readSector(5);
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    EXPECT_EQ(sector->mode, TrackMode::Mode2_2352);
+    EXPECT_EQ(sector->data[0], 5);
+    EXPECT_EQ(sector->data[1], 0xAA);
+
+    // First sector of the second file
+    sector = disc.readSector(300);
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    EXPECT_EQ(sector->mode, TrackMode::Audio);
+    EXPECT_EQ(sector->data[0], 0);
+
+    auto sectors = disc.readSectors(298, 4);
+    ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+    EXPECT_EQ((*sectors)[0].data[0], 42); // 298 & 0xFF
+    EXPECT_EQ((*sectors)[1].data[0], 43);
+    EXPECT_EQ((*sectors)[2].data[0], 0);
+    EXPECT_EQ((*sectors)[3].data[0], 1);
+}
+
+TEST_F(DiscTest, SectorViewMmap) {
+    DiscOptions options;
+    options.ioBackend = IoBackend::Mmap;
+    auto result = Disc::fromCue(DATA_DIR / "singleTrack.cue", options);
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+
+    auto view = disc.sectorView(7);
+    ASSERT_TRUE(view.ok()) << view.error().message;
+    ASSERT_EQ(view->size(), 2352u);
+    EXPECT_EQ((*view)[0], 7);
+    EXPECT_EQ((*view)[2351], 0xAA);
+
+    auto outOfRange = disc.sectorView(100);
+    EXPECT_FALSE(outOfRange.ok());
+    EXPECT_EQ(outOfRange.error().code, ErrorCode::LBAOutOfRange);
+}
+
+TEST_F(DiscTest, SectorViewRequiresMmap) {
+    auto result = Disc::fromCue(DATA_DIR / "singleTrack.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto view = result->sectorView(0);
+    EXPECT_FALSE(view.ok());
+    EXPECT_EQ(view.error().code, ErrorCode::InvalidArgument);
+}
+
+TEST_F(DiscTest, ReadSectorPositional) {
+    DiscOptions options;
+    options.ioBackend = IoBackend::Positional;
+    auto result = Disc::fromCue(DATA_DIR / "multiFile.cue", options);
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+
+    auto sector = disc.readSector(299);
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    EXPECT_EQ(sector->data[0], 299 & 0xFF);
+
+    sector = disc.readSector(501);
+    ASSERT_TRUE(sector.ok()) << sector.error().message;
+    EXPECT_EQ(sector->mode, TrackMode::Audio);
+    EXPECT_EQ(sector->data[0], 1);
+}
+
+namespace {
+
+// Reads every sector of the disc from `threadCount` threads at once.
+// Returns false if any read failed or returned the wrong sector.
+bool concurrentReadsCorrect(const Disc& disc, int threadCount, int passes) {
+    std::atomic<bool> failed{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&disc, &failed, t, passes]() {
+            int32_t total = disc.totalSectors();
+            for (int pass = 0; pass < passes; ++pass) {
+                for (int32_t i = 0; i < total; ++i) {
+                    // Each thread walks the disc from a different starting point
+                    int32_t lba = (i + t * 37) % total;
+                    auto sector = disc.readSector(lba);
+                    if (!sector || sector->data[0] != static_cast<uint8_t>(lba & 0xFF)) {
+                        failed = true;
+                        return;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    return !failed;
+}
+
+} // anonymous namespace
+
+// Correctness only: the throughput of concurrent reads per backend is
+// measured by BM_ParallelReadSingleFile in libcuebin_bench
+TEST_F(DiscTest, ConcurrentReadsPositional) {
+    for (auto backend : {IoBackend::Positional, IoBackend::Stream}) {
+        DiscOptions options;
+        options.ioBackend = backend;
+        options.useBlockCache = false; // Every read goes to the backend
+        auto disc = Disc::fromCue(DATA_DIR / "singleTrack.cue", options);
+        ASSERT_TRUE(disc.ok()) << disc.error().message;
+        EXPECT_TRUE(concurrentReadsCorrect(*disc, 8, 5)) << static_cast<int>(backend);
+    }
+}
+
+TEST_F(DiscTest, ReadSectorsAcrossTracks) {
+    auto result = Disc::fromCue(DATA_DIR / "multiTrack.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+    const auto* t2 = disc.track(2);
+    ASSERT_NE(t2, nullptr);
+
+    // A range straddling the track 1 / track 2 boundary must match
+    // sector-by-sector reads, including the per-track mode
+    int32_t start = t2->startLba() - 3;
+    auto sectors = disc.readSectors(start, 6);
+    ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+    ASSERT_EQ(sectors->size(), 6u);
+
+    for (int32_t i = 0; i < 6; ++i) {
+        auto single = disc.readSector(start + i);
+        ASSERT_TRUE(single.ok()) << single.error().message;
+        EXPECT_EQ((*sectors)[i].mode, single->mode);
+        EXPECT_EQ((*sectors)[i].data, single->data);
+    }
+    EXPECT_EQ((*sectors)[2].mode, TrackMode::Mode2_2352);
+    EXPECT_EQ((*sectors)[3].mode, TrackMode::Audio);
+}
+
+TEST_F(DiscTest, ReadSectorsCookedPadding) {
+    auto result = Disc::fromCue(DATA_DIR / "cooked.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+    EXPECT_EQ(disc.totalSectors(), 50);
+
+    auto sectors = disc.readSectors(0, 50);
+    ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+
+    for (int32_t i = 0; i < 50; ++i) {
+        const auto& s = (*sectors)[i];
+        EXPECT_EQ(s.mode, TrackMode::Mode1_2048);
+        EXPECT_EQ(s.data[0], i);
+        EXPECT_EQ(s.data[2047], 0x55);
+        EXPECT_EQ(s.data[2048], 0);
+        EXPECT_EQ(s.data[2351], 0);
+    }
+
+    auto single = disc.readSector(17);
+    ASSERT_TRUE(single.ok()) << single.error().message;
+    EXPECT_EQ(single->data, (*sectors)[17].data);
+}
+
+TEST_F(DiscTest, ReadSectorsOutOfRange) {
+    auto result = Disc::fromCue(DATA_DIR / "singleTrack.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+
+    auto sectors = disc.readSectors(98, 3);
+    EXPECT_FALSE(sectors.ok());
+    EXPECT_EQ(sectors.error().code, ErrorCode::LBAOutOfRange);
+
+    sectors = disc.readSectors(0, 0);
+    EXPECT_FALSE(sectors.ok());
+    EXPECT_EQ(sectors.error().code, ErrorCode::InvalidArgument);
+}
+
+TEST_F(DiscTest, ReadSectorInto) {
+    auto result = Disc::fromCue(DATA_DIR / "singleTrack.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+
+    std::array<uint8_t, RAW_SECTOR_SIZE> buffer{};
+    TrackMode mode = TrackMode::Audio;
+    auto status = disc.readSectorInto(9, buffer, &mode);
+    ASSERT_TRUE(status.ok());
+    EXPECT_EQ(buffer[0], 9);
+    EXPECT_EQ(buffer[1], 0xAA);
+    EXPECT_EQ(mode, TrackMode::Mode2_2352);
+
+    // Mode is optional
+    status = disc.readSectorInto(10, buffer);
+    ASSERT_TRUE(status.ok());
+    EXPECT_EQ(buffer[0], 10);
+
+    status = disc.readSectorInto(100, buffer);
+    EXPECT_FALSE(status.ok());
+    EXPECT_EQ(status.code(), ErrorCode::LBAOutOfRange);
+
+    std::array<uint8_t, 2048> tooSmall{};
+    status = disc.readSectorInto(0, tooSmall);
+    EXPECT_FALSE(status.ok());
+    EXPECT_EQ(status.code(), ErrorCode::InvalidArgument);
+}
+
+TEST_F(DiscTest, ReadSectorsIntoAcrossFiles) {
+    auto result = Disc::fromCue(DATA_DIR / "multiFile.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+
+    constexpr int32_t kCount = 4;
+    std::vector<uint8_t> buffer(kCount * RAW_SECTOR_SIZE);
+    std::array<TrackMode, kCount> modes{};
+    auto status = disc.readSectorsInto(298, kCount, buffer, modes);
+    ASSERT_TRUE(status.ok());
+
+    EXPECT_EQ(buffer[0 * RAW_SECTOR_SIZE], 298 & 0xFF);
+    EXPECT_EQ(buffer[1 * RAW_SECTOR_SIZE], 299 & 0xFF);
+    EXPECT_EQ(buffer[2 * RAW_SECTOR_SIZE], 0);
+    EXPECT_EQ(buffer[3 * RAW_SECTOR_SIZE], 1);
+    EXPECT_EQ(modes[1], TrackMode::Mode2_2352);
+    EXPECT_EQ(modes[2], TrackMode::Audio);
+
+    std::array<TrackMode, 2> shortModes{};
+    status = disc.readSectorsInto(298, kCount, buffer, shortModes);
+    EXPECT_EQ(status.code(), ErrorCode::InvalidArgument);
+}
+
+TEST_F(DiscTest, ReadSectorsIntoCooked) {
+    auto result = Disc::fromCue(DATA_DIR / "cooked.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+
+    // Fill with garbage to check that padding is written, not assumed
+    std::vector<uint8_t> buffer(10 * RAW_SECTOR_SIZE, 0xEE);
+    auto status = disc.readSectorsInto(5, 10, buffer);
+    ASSERT_TRUE(status.ok());
+
+    for (size_t i = 0; i < 10; ++i) {
+        const uint8_t* sector = buffer.data() + i * RAW_SECTOR_SIZE;
+        EXPECT_EQ(sector[0], 5 + i);
+        EXPECT_EQ(sector[1], 0x55);
+        EXPECT_EQ(sector[2047], 0x55);
+        EXPECT_EQ(sector[2048], 0);
+        EXPECT_EQ(sector[2351], 0);
+    }
+}
+
+TEST_F(DiscTest, ReadUserDataCooked) {
+    auto result = Disc::fromCue(DATA_DIR / "cooked.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto data = result->readUserDataRange(3, 4);
+    ASSERT_TRUE(data.ok()) << data.error().message;
+    ASSERT_EQ(data->size(), 4 * MODE1_USER_DATA_SIZE);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ((*data)[i * 2048], 3 + i);
+        EXPECT_EQ((*data)[i * 2048 + 2047], 0x55);
+    }
+
+    auto one = result->readUserData(49);
+    ASSERT_TRUE(one.ok());
+    EXPECT_EQ(one->size(), MODE1_USER_DATA_SIZE);
+    EXPECT_EQ((*one)[0], 49);
+}
+
+TEST_F(DiscTest, ReadUserDataAcrossModes) {
+    auto result = Disc::fromCue(DATA_DIR / "multiFile.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    // data.bin is filled with 0xAA: a repeated subheader with the Form 2 bit set
+    auto data = result->readUserDataRange(298, 3);
+    ASSERT_TRUE(data.ok()) << data.error().message;
+    ASSERT_EQ(data->size(), 2 * MODE2_FORM2_USER_DATA_SIZE + RAW_SECTOR_SIZE);
+    EXPECT_EQ((*data)[0], 0xAA);
+    // Audio sectors come back whole, marker byte included
+    EXPECT_EQ((*data)[2 * MODE2_FORM2_USER_DATA_SIZE], 0);
+
+    std::vector<uint8_t> small(100);
+    EXPECT_EQ(result->readUserDataInto(0, 1, small).code(), ErrorCode::InvalidArgument);
+    EXPECT_EQ(result->readUserDataInto(699, 2, small).code(), ErrorCode::LBAOutOfRange);
+}
+
+TEST_F(DiscTest, ReadUserDataMode2Forms) {
+    auto dir = std::filesystem::temp_directory_path() / "libcuebin_userdata";
+    std::filesystem::create_directories(dir);
+
+    // Form 1, Form 2 and formless sectors, once raw and once as 2336 bytes
+    std::vector<uint8_t> raw(3 * 2352, 0);
+    const uint8_t submodes[3] = {0x08, 0x20, 0x00};
+    for (size_t i = 0; i < 3; ++i) {
+        uint8_t* sector = raw.data() + i * 2352;
+        uint8_t* sub = sector + 16;
+        sub[2] = submodes[i];
+        sub[6] = i == 2 ? 0xFF : submodes[i]; // Mismatched copies: not XA
+        for (size_t b = 24; b < 2352; ++b) sector[b] = static_cast<uint8_t>(i + 1);
+        sector[24] = 0xF0 + static_cast<uint8_t>(i);
+    }
+    std::ofstream(dir / "raw.bin", std::ios::binary)
+        .write(reinterpret_cast<const char*>(raw.data()), raw.size());
+    {
+        std::ofstream cooked(dir / "cooked.bin", std::ios::binary);
+        for (size_t i = 0; i < 3; ++i) {
+            cooked.write(reinterpret_cast<const char*>(raw.data() + i * 2352 + 16), 2336);
+        }
+    }
+    std::ofstream(dir / "forms.cue")
+        << "FILE \"raw.bin\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n"
+        << "FILE \"cooked.bin\" BINARY\n  TRACK 02 MODE2/2336\n    INDEX 01 00:00:00\n";
+
+    auto result = Disc::fromCue(dir / "forms.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto data = result->readUserDataRange(0, 6);
+    ASSERT_TRUE(data.ok()) << data.error().message;
+    size_t perTrack = MODE1_USER_DATA_SIZE + MODE2_FORM2_USER_DATA_SIZE + MODE2_USER_DATA_SIZE;
+    ASSERT_EQ(data->size(), 2 * perTrack);
+
+    for (size_t t = 0; t < 2; ++t) {
+        const uint8_t* p = data->data() + t * perTrack;
+        EXPECT_EQ(p[0], 0xF0);
+        EXPECT_EQ(p[2047], 1);
+        p += MODE1_USER_DATA_SIZE;
+        EXPECT_EQ(p[0], 0xF1);
+        EXPECT_EQ(p[2323], 2);
+        p += MODE2_FORM2_USER_DATA_SIZE;
+        // Formless Mode 2 keeps the would-be subheader
+        EXPECT_EQ(p[6], 0xFF);
+        EXPECT_EQ(p[8], 0xF2);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(DiscTest, ReadAheadSequential) {
+    DiscOptions options;
+    options.readAhead = true;
+    options.readAheadMinSectors = 8;
+    options.readAheadMaxSectors = 32;
+    auto result = Disc::fromCue(DATA_DIR / "multiFile.cue", options);
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    auto& disc = *result;
+
+    // Establish a sequential run so the prefetcher kicks in
+    for (int32_t lba = 0; lba < 3; ++lba) {
+        auto sector = disc.readSector(lba);
+        ASSERT_TRUE(sector.ok()) << sector.error().message;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (disc.readAheadStats().prefetchedSectors == 0
+           && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_GT(disc.readAheadStats().prefetchedSectors, 0u);
+
+    // Stream across the data/audio file boundary; prefetched data must be
+    // identical to what a direct read returns
+    auto reference = Disc::fromCue(DATA_DIR / "multiFile.cue");
+    ASSERT_TRUE(reference.ok()) << reference.error().message;
+
+    for (int32_t lba = 3; lba < 400; ++lba) {
+        auto sector = disc.readSector(lba);
+        auto expected = reference->readSector(lba);
+        ASSERT_TRUE(sector.ok()) << sector.error().message;
+        ASSERT_TRUE(expected.ok()) << expected.error().message;
+        ASSERT_EQ(sector->mode, expected->mode) << "LBA " << lba;
+        ASSERT_EQ(sector->data, expected->data) << "LBA " << lba;
+    }
+
+    auto stats = disc.readAheadStats();
+    EXPECT_GT(stats.hits, 0u);
+    EXPECT_GE(stats.windowSectors, 8);
+    EXPECT_LE(stats.windowSectors, 32);
+}
+
+TEST_F(DiscTest, ReadAheadDisabledByDefault) {
+    auto result = Disc::fromCue(DATA_DIR / "singleTrack.cue");
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    for (int32_t lba = 0; lba < 10; ++lba) {
+        ASSERT_TRUE(result->readSector(lba).ok());
+    }
+
+    auto stats = result->readAheadStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.prefetchedSectors, 0u);
+}
+
+TEST_F(DiscTest, ReadAheadRandomAccess) {
+    DiscOptions options;
+    options.readAhead = true;
+    auto result = Disc::fromCue(DATA_DIR / "singleTrack.cue", options);
+    ASSERT_TRUE(result.ok()) << result.error().message;
+
+    // Random reads never form a run, so nothing is prefetched
+    for (int32_t lba : {50, 3, 97, 12, 64, 31, 88, 5}) {
+        auto sector = result->readSector(lba);
+        ASSERT_TRUE(sector.ok()) << sector.error().message;
+        EXPECT_EQ(sector->data[0], lba);
+    }
+
+    EXPECT_EQ(result->readAheadStats().prefetchedSectors, 0u);
+}
+
+namespace {
+
+void put16(std::string& s, uint16_t v, bool big) {
+    s += static_cast<char>(big ? v >> 8 : v & 0xFF);
+    s += static_cast<char>(big ? v & 0xFF : v >> 8);
+}
+
+void put32(std::string& s, uint32_t v, bool big) {
+    put16(s, static_cast<uint16_t>(big ? v >> 16 : v & 0xFFFF), big);
+    put16(s, static_cast<uint16_t>(big ? v & 0xFFFF : v >> 16), big);
+}
+
+std::string pcmBytes(const std::vector<uint8_t>& pcm, bool swap) {
+    std::string s(pcm.begin(), pcm.end());
+    if (swap) {
+        for (size_t i = 0; i + 1 < s.size(); i += 2) std::swap(s[i], s[i + 1]);
+    }
+    return s;
+}
+
+void writeWave(const std::filesystem::path& path, const std::vector<uint8_t>& pcm, uint16_t channels = 2) {
+    std::string body = "WAVE";
+    body += "fmt ";
+    put32(body, 16, false);
+    put16(body, 1, false);
+    put16(body, channels, false);
+    put32(body, 44100, false);
+    put32(body, 44100 * 2u * channels, false);
+    put16(body, static_cast<uint16_t>(2 * channels), false);
+    put16(body, 16, false);
+    body += "LIST"; // Odd-sized chunk: padded to an even length
+    put32(body, 3, false);
+    body += std::string("abc\0", 4);
+    body += "data";
+    put32(body, static_cast<uint32_t>(pcm.size()), false);
+    body += pcmBytes(pcm, false);
+
+    std::string file = "RIFF";
+    put32(file, static_cast<uint32_t>(body.size()), false);
+    std::ofstream(path, std::ios::binary) << file << body;
+}
+
+void writeAiff(const std::filesystem::path& path, const std::vector<uint8_t>& pcm, bool sowt) {
+    std::string comm;
+    put16(comm, 2, true);
+    put32(comm, static_cast<uint32_t>(pcm.size() / 4), true);
+    put16(comm, 16, true);
+    comm += std::string("\x40\x0E\xAC\x44\0\0\0\0\0\0", 10); // 44100 as 80-bit extended
+    if (sowt) comm += "sowt";
+
+    std::string body = sowt ? "AIFC" : "AIFF";
+    body += "COMM";
+    put32(body, static_cast<uint32_t>(comm.size()), true);
+    body += comm;
+    body += "SSND";
+    put32(body, static_cast<uint32_t>(pcm.size() + 8 + 4), true);
+    put32(body, 4, true); // Offset: 4 bytes of alignment padding
+    put32(body, 0, true);
+    body += "pad!";
+    body += pcmBytes(pcm, !sowt);
+
+    std::string file = "FORM";
+    put32(file, static_cast<uint32_t>(body.size()), true);
+    std::ofstream(path, std::ios::binary) << file << body;
+}
+
+} // anonymous namespace
+
+TEST_F(DiscTest, WaveAndAiffTracks) {
+    auto dir = std::filesystem::temp_directory_path() / "libcuebin_container";
+    std::filesystem::create_directories(dir);
+
+    std::vector<uint8_t> pcm(10 * 2352);
+    for (size_t i = 0; i < pcm.size(); ++i) pcm[i] = static_cast<uint8_t>(i * 13 + i / 2352);
+    writeWave(dir / "01.wav", pcm);
+    writeAiff(dir / "02.aiff", pcm, false);
+    writeAiff(dir / "03.aifc", pcm, true);
+    std::ofstream(dir / "disc.cue")
+        << "FILE \"01.wav\" WAVE\n  TRACK 01 AUDIO\n    INDEX 01 00:00:00\n"
+        << "FILE \"02.aiff\" AIFF\n  TRACK 02 AUDIO\n    INDEX 01 00:00:00\n"
+        << "FILE \"03.aifc\" AIFF\n  TRACK 03 AUDIO\n    INDEX 01 00:00:00\n";
+
+    for (auto backend : {IoBackend::Stream, IoBackend::Mmap, IoBackend::Positional}) {
+        DiscOptions options;
+        options.ioBackend = backend;
+        auto result = Disc::fromCue(dir / "disc.cue", options);
+        ASSERT_TRUE(result.ok()) << result.error().message;
+        ASSERT_EQ(result->totalSectors(), 30);
+
+        for (uint8_t t = 1; t <= 3; ++t) {
+            EXPECT_EQ(result->track(t)->lengthSectors(), 10);
+            int32_t start = result->track(t)->startLba();
+
+            auto sectors = result->readSectors(start, 10);
+            ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+            for (int32_t i = 0; i < 10; ++i) {
+                EXPECT_EQ(std::memcmp((*sectors)[i].data.data(), pcm.data() + i * 2352, 2352), 0)
+                    << "track " << int(t) << " sector " << i;
+            }
+
+            auto user = result->readUserDataRange(start, 10);
+            ASSERT_TRUE(user.ok()) << user.error().message;
+            EXPECT_EQ(*user, pcm) << "track " << int(t);
+        }
+
+        if (backend == IoBackend::Mmap) {
+            auto view = result->sectorView(0);
+            ASSERT_TRUE(view.ok()) << view.error().message;
+            EXPECT_EQ(std::memcmp(view->data(), pcm.data(), 2352), 0);
+            EXPECT_EQ(result->sectorView(10).error().code, ErrorCode::Unsupported);
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(DiscTest, AudioContainerErrors) {
+    auto dir = std::filesystem::temp_directory_path() / "libcuebin_container_errors";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "disc.cue") << "FILE \"a.wav\" WAVE\n  TRACK 01 AUDIO\n    INDEX 01 00:00:00\n";
+
+    writeWave(dir / "a.wav", std::vector<uint8_t>(2352), 1);
+    auto mono = Disc::fromCue(dir / "disc.cue");
+    ASSERT_FALSE(mono.ok());
+    EXPECT_EQ(mono.error().code, ErrorCode::Unsupported);
+
+    createBinFile(dir / "a.wav", 2352);
+    auto raw = Disc::fromCue(dir / "disc.cue");
+    ASSERT_FALSE(raw.ok());
+    EXPECT_EQ(raw.error().code, ErrorCode::InvalidFileType);
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,327 @@
+#include <gtest/gtest.h>
+#include "libcuebin/disc.hpp"
+#include "libcuebin/ecc.hpp"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+// Bit-at-a-time EDC straight from the polynomial, independent of the tables
+uint32_t referenceEdc(const uint8_t* data, size_t size) {
+    uint32_t edc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        edc ^= data[i];
+        for (int k = 0; k < 8; ++k) edc = (edc >> 1) ^ ((edc & 1) ? 0xD8018001u : 0);
+    }
+    return edc;
+}
+
+uint32_t storedEdc(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint8_t gfMulAlpha(uint8_t v) {
+    return static_cast<uint8_t>((v << 1) ^ ((v & 0x80) ? 0x1D : 0));
+}
+
+// Both RS syndromes of a codeword are zero when its parity is consistent
+bool syndromesZero(const std::vector<uint8_t>& word) {
+    uint8_t s0 = 0;
+    uint8_t s1 = 0;
+    for (uint8_t v : word) {
+        s0 ^= v;
+        s1 = static_cast<uint8_t>(gfMulAlpha(s1) ^ v);
+    }
+    return s0 == 0 && s1 == 0;
+}
+
+// Checks every P column and Q diagonal of the 2340 bytes after the sync
+bool eccConsistent(const uint8_t* sector) {
+    const uint8_t* s = sector + HEADER_OFFSET;
+    for (size_t col = 0; col < 86; ++col) {
+        std::vector<uint8_t> word;
+        for (size_t k = 0; k < 26; ++k) word.push_back(s[col + 86 * k]);
+        if (!syndromesZero(word)) return false;
+    }
+    for (size_t diag = 0; diag < 52; ++diag) {
+        std::vector<uint8_t> word;
+        size_t index = (diag / 2) * 86 + (diag & 1);
+        for (size_t k = 0; k < 43; ++k) {
+            word.push_back(s[index]);
+            index = (index + 88) % 2236;
+        }
+        word.push_back(s[2236 + diag]);
+        word.push_back(s[2236 + 52 + diag]);
+        if (!syndromesZero(word)) return false;
+    }
+    return true;
+}
+
+std::array<uint8_t, RAW_SECTOR_SIZE> patternSector(uint8_t seed) {
+    std::array<uint8_t, RAW_SECTOR_SIZE> sector{};
+    for (size_t i = 0; i < sector.size(); ++i) sector[i] = static_cast<uint8_t>(i * 31 + seed);
+    return sector;
+}
+
+} // anonymous namespace
+
+TEST(EccTest, EdcMatchesPolynomial) {
+    auto data = patternSector(7);
+    EXPECT_EQ(computeEdc(data), referenceEdc(data.data(), data.size()));
+    EXPECT_EQ(computeEdc({}), 0u);
+
+    // Incremental computation matches a single pass
+    uint32_t partial = computeEdc(std::span(data).first(1000));
+    EXPECT_EQ(computeEdc(std::span(data).subspan(1000), partial), computeEdc(data));
+}
+
+TEST(EccTest, EncodeMode1Sector) {
+    auto sector = patternSector(1);
+    encodeMode1Sector(16, sector);
+
+    const uint8_t sync[12] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+    EXPECT_EQ(std::memcmp(sector.data(), sync, sizeof(sync)), 0);
+    // LBA 16 is MSF 00:02:16, stored as BCD
+    EXPECT_EQ(sector[12], 0x00);
+    EXPECT_EQ(sector[13], 0x02);
+    EXPECT_EQ(sector[14], 0x16);
+    EXPECT_EQ(sector[15], 0x01);
+
+    // User data untouched, EDC over sync..data, reserved bytes zero
+    auto original = patternSector(1);
+    EXPECT_EQ(std::memcmp(sector.data() + 16, original.data() + 16, 2048), 0);
+    EXPECT_EQ(storedEdc(sector.data() + MODE1_EDC_OFFSET),
+              referenceEdc(sector.data(), MODE1_EDC_OFFSET));
+    for (size_t i = MODE1_EDC_OFFSET + 4; i < ECC_P_OFFSET; ++i) EXPECT_EQ(sector[i], 0) << i;
+    EXPECT_TRUE(eccConsistent(sector.data()));
+
+    // A single flipped byte breaks the parity
+    sector[100] ^= 0x01;
+    EXPECT_FALSE(eccConsistent(sector.data()));
+}
+
+TEST(EccTest, EncodeMode2Sectors) {
+    auto form1 = patternSector(2);
+    encodeMode2Form1Sector(4500, form1);
+    // LBA 4500 is MSF 01:02:00
+    EXPECT_EQ(form1[12], 0x01);
+    EXPECT_EQ(form1[13], 0x02);
+    EXPECT_EQ(form1[14], 0x00);
+    EXPECT_EQ(form1[15], 0x02);
+    EXPECT_EQ(storedEdc(form1.data() + MODE2_FORM1_EDC_OFFSET),
+              referenceEdc(form1.data() + SUBHEADER_OFFSET, MODE2_FORM1_EDC_OFFSET - SUBHEADER_OFFSET));
+
+    // Form 1 parity is computed over a zeroed header
+    auto zeroed = form1;
+    std::memset(zeroed.data() + HEADER_OFFSET, 0, 4);
+    EXPECT_TRUE(eccConsistent(zeroed.data()));
+    EXPECT_FALSE(eccConsistent(form1.data()));
+
+    auto form2 = patternSector(3);
+    encodeMode2Form2Sector(4500, form2);
+    EXPECT_EQ(form2[15], 0x02);
+    EXPECT_EQ(storedEdc(form2.data() + MODE2_FORM2_EDC_OFFSET),
+              referenceEdc(form2.data() + SUBHEADER_OFFSET, MODE2_FORM2_EDC_OFFSET - SUBHEADER_OFFSET));
+}
+
+class RawSectorDiscTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_ecc";
+        std::filesystem::create_directories(dir);
+
+        std::vector<uint8_t> mode1(2048 * 20);
+        for (size_t i = 0; i < mode1.size(); ++i) mode1[i] = static_cast<uint8_t>(i * 7);
+        std::ofstream(dir / "mode1.bin", std::ios::binary)
+            .write(reinterpret_cast<const char*>(mode1.data()), mode1.size());
+
+        std::vector<uint8_t> mode2(2336 * 10);
+        for (size_t i = 0; i < mode2.size(); ++i) mode2[i] = static_cast<uint8_t>(i * 13);
+        std::ofstream(dir / "mode2.bin", std::ios::binary)
+            .write(reinterpret_cast<const char*>(mode2.data()), mode2.size());
+
+        std::ofstream(dir / "raw.cue")
+            << "FILE \"mode1.bin\" BINARY\n  TRACK 01 MODE1/2048\n    INDEX 01 00:00:00\n"
+            << "FILE \"mode2.bin\" BINARY\n  TRACK 02 MODE2/2336\n    INDEX 01 00:00:00\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+};
+
+TEST_F(RawSectorDiscTest, CookedSectorsRebuiltAsRaw) {
+    DiscOptions options;
+    options.rawSectors = true;
+    auto disc = Disc::fromCue(dir / "raw.cue", options);
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    auto cooked = Disc::fromCue(dir / "raw.cue");
+    ASSERT_TRUE(cooked.ok()) << cooked.error().message;
+
+    for (int32_t lba : {0, 7, 19}) {
+        auto raw = disc->readSector(lba);
+        auto plain = cooked->readSector(lba);
+        ASSERT_TRUE(raw.ok()) << raw.error().message;
+        ASSERT_TRUE(plain.ok());
+        EXPECT_EQ(raw->mode, TrackMode::Mode1_2048);
+
+        EXPECT_EQ(std::memcmp(raw->data.data() + 16, plain->data.data(), 2048), 0);
+        EXPECT_EQ(raw->data[15], 0x01);
+        EXPECT_EQ(storedEdc(raw->data.data() + MODE1_EDC_OFFSET),
+                  referenceEdc(raw->data.data(), MODE1_EDC_OFFSET));
+        EXPECT_TRUE(eccConsistent(raw->data.data())) << "LBA " << lba;
+    }
+
+    // MODE2/2336 keeps its stored subheader/EDC/ECC and gains sync and header
+    auto raw = disc->readSector(25);
+    auto plain = cooked->readSector(25);
+    ASSERT_TRUE(raw.ok()) << raw.error().message;
+    ASSERT_TRUE(plain.ok());
+    EXPECT_EQ(std::memcmp(raw->data.data() + 16, plain->data.data(), 2336), 0);
+    EXPECT_EQ(raw->data[12], 0x00);
+    EXPECT_EQ(raw->data[13], 0x02);
+    EXPECT_EQ(raw->data[14], 0x25);
+    EXPECT_EQ(raw->data[15], 0x02);
+}
+
+TEST_F(RawSectorDiscTest, BatchReadsMatchSingleReads) {
+    DiscOptions options;
+    options.rawSectors = true;
+    auto disc = Disc::fromCue(dir / "raw.cue", options);
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    // Spans both cooked tracks, exercising the in-place spread per run
+    auto range = disc->readSectors(0, 30);
+    ASSERT_TRUE(range.ok()) << range.error().message;
+    for (int32_t i = 0; i < 30; ++i) {
+        auto single = disc->readSector(i);
+        ASSERT_TRUE(single.ok());
+        EXPECT_EQ((*range)[i].data, single->data) << "LBA " << i;
+    }
+}
+
+TEST(EccTest, CheckSectorRepairsSingleErrors) {
+    auto clean = patternSector(4);
+    encodeMode1Sector(100, clean);
+    auto sector = clean;
+    EXPECT_EQ(checkSector(TrackMode::Mode1_2352, sector), SectorCheck::Ok);
+
+    // One bad byte in the data, one in the header, one in the parity
+    sector[500] ^= 0x5A;
+    sector[13] ^= 0x01;
+    sector[ECC_Q_OFFSET + 3] ^= 0xFF;
+    EXPECT_EQ(checkSector(TrackMode::Mode1_2352, sector), SectorCheck::Repairable);
+    EXPECT_EQ(sector, clean);
+
+    // A burst across a whole row defeats single-error correction
+    for (size_t i = 200; i < 400; ++i) sector[i] ^= 0xA5;
+    EXPECT_EQ(checkSector(TrackMode::Mode1_2352, sector), SectorCheck::Unrecoverable);
+}
+
+TEST(EccTest, CheckSectorMode2Forms) {
+    auto form1 = patternSector(5);
+    form1[SUBHEADER_OFFSET + 2] = 0x08;
+    form1[SUBHEADER_OFFSET + 6] = 0x08;
+    encodeMode2Form1Sector(300, form1);
+    auto clean = form1;
+    EXPECT_EQ(checkSector(TrackMode::Mode2_2352, form1), SectorCheck::Ok);
+
+    form1[1000] ^= 0x10;
+    EXPECT_EQ(checkSector(TrackMode::Mode2_2352, form1), SectorCheck::Repairable);
+    EXPECT_EQ(form1, clean);
+
+    auto form2 = patternSector(6);
+    form2[SUBHEADER_OFFSET + 2] = SUBMODE_FORM2;
+    form2[SUBHEADER_OFFSET + 6] = SUBMODE_FORM2;
+    encodeMode2Form2Sector(300, form2);
+    EXPECT_EQ(checkSector(TrackMode::Mode2_2352, form2), SectorCheck::Ok);
+
+    // Form 2 has no parity to repair from
+    form2[1000] ^= 0x10;
+    EXPECT_EQ(checkSector(TrackMode::Mode2_2352, form2), SectorCheck::Unrecoverable);
+
+    // ...and an unrecorded (zero) EDC is not an error
+    std::memset(form2.data() + MODE2_FORM2_EDC_OFFSET, 0, 4);
+    EXPECT_EQ(checkSector(TrackMode::Mode2_2352, form2), SectorCheck::Ok);
+}
+
+TEST(EccTest, CheckSectorMode0) {
+    // A genuine mode 0 sector: header only, zero body, no EDC
+    std::array<uint8_t, RAW_SECTOR_SIZE> empty{};
+    writeSectorHeader(150, 0, empty);
+    EXPECT_EQ(checkSector(TrackMode::Mode1_2352, empty), SectorCheck::Ok);
+
+    // A Mode 1 sector whose mode byte was corrupted to 0 is not mode 0
+    auto clean = patternSector(7);
+    encodeMode1Sector(150, clean);
+    auto sector = clean;
+    sector[HEADER_OFFSET + 3] = 0x00;
+    EXPECT_NE(checkSector(TrackMode::Mode1_2352, sector), SectorCheck::Ok);
+    EXPECT_EQ(sector, clean);
+
+    // Nor is a corrupted data sector that also lost its mode byte
+    sector[HEADER_OFFSET + 3] = 0x00;
+    for (size_t i = 200; i < 400; ++i) sector[i] ^= 0xA5;
+    EXPECT_EQ(checkSector(TrackMode::Mode1_2352, sector), SectorCheck::Unrecoverable);
+}
+
+TEST_F(RawSectorDiscTest, VerifyReportsBadSectors) {
+    // 40 MODE1/2352 sectors followed by 12 MODE2/2336 Form 1 sectors
+    std::vector<uint8_t> raw;
+    for (int32_t lba = 0; lba < 40; ++lba) {
+        auto sector = patternSector(static_cast<uint8_t>(lba));
+        encodeMode1Sector(lba, sector);
+        raw.insert(raw.end(), sector.begin(), sector.end());
+    }
+    raw[5 * 2352 + 700] ^= 0x01;                                      // Repairable
+    for (size_t i = 0; i < 300; ++i) raw[20 * 2352 + 100 + i] ^= 0xFF; // Not repairable
+    std::ofstream(dir / "verify1.bin", std::ios::binary)
+        .write(reinterpret_cast<const char*>(raw.data()), raw.size());
+
+    std::vector<uint8_t> cooked;
+    for (int32_t lba = 40; lba < 52; ++lba) {
+        auto sector = patternSector(static_cast<uint8_t>(lba));
+        std::memset(sector.data() + SUBHEADER_OFFSET, 0, 8);
+        encodeMode2Form1Sector(lba, sector);
+        cooked.insert(cooked.end(), sector.begin() + 16, sector.end());
+    }
+    cooked[7 * 2336 + 50] ^= 0x80; // LBA 47, repairable
+    std::ofstream(dir / "verify2.bin", std::ios::binary)
+        .write(reinterpret_cast<const char*>(cooked.data()), cooked.size());
+
+    std::ofstream(dir / "verify.cue")
+        << "FILE \"verify1.bin\" BINARY\n  TRACK 01 MODE1/2352\n    INDEX 01 00:00:00\n"
+        << "FILE \"verify2.bin\" BINARY\n  TRACK 02 MODE2/2336\n    INDEX 01 00:00:00\n";
+
+    auto disc = Disc::fromCue(dir / "verify.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    VerifyOptions options;
+    options.threadCount = 3;
+    options.chunkSectors = 7;
+    auto report = disc->verify(options);
+    ASSERT_TRUE(report.ok()) << report.error().message;
+
+    EXPECT_EQ(report->sectorsChecked, 52);
+    ASSERT_EQ(report->badSectors.size(), 3u);
+    EXPECT_EQ(report->badSectors[0].lba, 5);
+    EXPECT_TRUE(report->badSectors[0].repairable);
+    EXPECT_EQ(report->badSectors[1].lba, 20);
+    EXPECT_FALSE(report->badSectors[1].repairable);
+    EXPECT_EQ(report->badSectors[2].lba, 47);
+    EXPECT_TRUE(report->badSectors[2].repairable);
+
+    // Single-threaded scans agree
+    auto serial = disc->verify({1, 1024});
+    ASSERT_TRUE(serial.ok());
+    ASSERT_EQ(serial->badSectors.size(), 3u);
+    EXPECT_EQ(serial->badSectors[1].lba, 20);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "libcuebin/disc.hpp"
+#include "libcuebin/ecc.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+// Track 1: 20 raw Mode 2 sectors of 0xAA, then a 10-sector POSTGAP.
+// Track 2: a 20-sector PREGAP, then 30 audio sectors of 0x55.
+// Track 3: 10 cooked Mode 1 sectors of 0x33, then a 5-sector POSTGAP.
+class GapSectorsTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+    std::filesystem::path cue;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_gaps";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        cue = dir / "game.cue";
+
+        write("data.bin", 20 * RAW_SECTOR_SIZE, 0xAA);
+        write("audio.bin", 30 * RAW_SECTOR_SIZE, 0x55);
+        write("cooked.bin", 10 * MODE1_USER_DATA_SIZE, 0x33);
+        std::ofstream(cue) << "FILE \"data.bin\" BINARY\n"
+                           << "  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n    POSTGAP 00:00:10\n"
+                           << "FILE \"audio.bin\" BINARY\n"
+                           << "  TRACK 02 AUDIO\n    PREGAP 00:00:20\n    INDEX 01 00:00:00\n"
+                           << "FILE \"cooked.bin\" BINARY\n"
+                           << "  TRACK 03 MODE1/2048\n    INDEX 01 00:00:00\n    POSTGAP 00:00:05\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    void write(const char* name, size_t size, uint8_t fill)
+    {
+        std::vector<char> data(size, static_cast<char>(fill));
+        std::ofstream(dir / name, std::ios::binary).write(data.data(), static_cast<std::streamsize>(size));
+    }
+
+    Disc open(bool rawSectors = false)
+    {
+        DiscOptions options;
+        options.ioBackend = IoBackend::Positional;
+        options.rawSectors = rawSectors;
+        auto disc = Disc::fromCue(cue, options);
+        EXPECT_TRUE(disc.ok()) << disc.error().message;
+        return std::move(*disc);
+    }
+
+    static bool allEqual(const uint8_t* data, size_t size, uint8_t value)
+    {
+        return std::all_of(data, data + size, [value](uint8_t b) { return b == value; });
+    }
+
+    // Sync, then the BCD MSF of `lba` and the mode byte
+    static void expectHeader(const std::array<uint8_t, RAW_SECTOR_SIZE>& sector, int32_t lba, uint8_t mode)
+    {
+        static constexpr uint8_t SYNC[12] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                             0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+        EXPECT_TRUE(std::equal(SYNC, SYNC + 12, sector.begin())) << lba;
+        MSF msf = MSF::toPhysicalMsf(lba);
+        auto bcd = [](uint8_t v) { return static_cast<uint8_t>((v / 10) << 4 | v % 10); };
+        EXPECT_EQ(sector[12], bcd(msf.minute)) << lba;
+        EXPECT_EQ(sector[13], bcd(msf.second)) << lba;
+        EXPECT_EQ(sector[14], bcd(msf.frame)) << lba;
+        EXPECT_EQ(sector[15], mode) << lba;
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(GapSectorsTest, Layout) {
+    Disc disc = open();
+    ASSERT_EQ(disc.totalSectors(), 95);
+
+    EXPECT_EQ(disc.findTrack(0)->number(), 1);
+    EXPECT_EQ(disc.findTrack(19)->number(), 1);
+    EXPECT_EQ(disc.findTrack(20), nullptr); // Track 1 postgap
+    EXPECT_EQ(disc.findTrack(49), nullptr); // Track 2 pregap
+    EXPECT_EQ(disc.findTrack(50)->number(), 2);
+    EXPECT_EQ(disc.findTrack(80)->number(), 3);
+    EXPECT_EQ(disc.findTrack(90), nullptr); // Track 3 postgap
+    EXPECT_EQ(disc.findTrack(-1), nullptr);
+    EXPECT_EQ(disc.findTrack(95), nullptr);
+    for (int32_t lba = Disc::FIRST_LBA - 1; lba <= disc.totalSectors(); ++lba) {
+        const Track* trk = disc.findTrack(lba);
+        bool stored = (lba >= 0 && lba < 20) || (lba >= 50 && lba < 90);
+        EXPECT_EQ(trk != nullptr, stored) << lba;
+    }
+}
+
+TEST_F(GapSectorsTest, GapsAreReadWithoutIo) {
+    Disc disc = open();
+    std::array<uint8_t, RAW_SECTOR_SIZE> sector;
+    TrackMode mode{};
+
+    for (int32_t lba : {-150, -1, 20, 29, 30, 49, 90, 94}) {
+        ASSERT_TRUE(disc.readSectorInto(lba, sector, &mode)) << lba;
+    }
+    auto stats = disc.ioStats();
+    EXPECT_EQ(stats.total.readCalls, 0u);
+    EXPECT_EQ(stats.total.lazyOpens, 0u);
+
+    ASSERT_TRUE(disc.readSectorInto(40, sector, &mode));
+    EXPECT_EQ(mode, TrackMode::Audio);
+    EXPECT_TRUE(allEqual(sector.data(), sector.size(), 0));
+
+    ASSERT_TRUE(disc.readSectorInto(0, sector));
+    EXPECT_EQ(disc.ioStats().total.readCalls, 1u);
+}
+
+TEST_F(GapSectorsTest, DataGapsAreFormattedSectors) {
+    Disc disc = open();
+    std::array<uint8_t, RAW_SECTOR_SIZE> sector;
+    TrackMode mode{};
+
+    for (int32_t lba : {-150, -75, -1, 20, 25, 29}) {
+        ASSERT_TRUE(disc.readSectorInto(lba, sector, &mode)) << lba;
+        EXPECT_EQ(mode, TrackMode::Mode2_2352) << lba;
+        expectHeader(sector, lba, 2);
+        EXPECT_EQ(sector[SUBHEADER_OFFSET + 2], SUBMODE_FORM2) << lba;
+        EXPECT_EQ(sector[SUBHEADER_OFFSET + 6], SUBMODE_FORM2) << lba;
+        EXPECT_EQ(checkSector(TrackMode::Mode2_2352, sector), SectorCheck::Ok) << lba;
+    }
+
+    // Cooked Mode 1 gaps read like cooked sectors: zero user data
+    ASSERT_TRUE(disc.readSectorInto(92, sector, &mode));
+    EXPECT_EQ(mode, TrackMode::Mode1_2048);
+    EXPECT_TRUE(allEqual(sector.data(), sector.size(), 0));
+
+    // ...or as complete Mode 1 sectors when raw sectors are rebuilt
+    Disc raw = open(true);
+    ASSERT_TRUE(raw.readSectorInto(92, sector));
+    expectHeader(sector, 92, 1);
+    EXPECT_EQ(checkSector(TrackMode::Mode1_2048, sector), SectorCheck::Ok);
+}
+
+TEST_F(GapSectorsTest, RangesSpanGapsAndFiles) {
+    Disc disc = open();
+    constexpr int32_t first = -2;
+    constexpr int32_t count = 60; // Lead-in, track 1, postgap, pregap, track 2
+    std::vector<uint8_t> buffer(static_cast<size_t>(count) * RAW_SECTOR_SIZE);
+    std::vector<TrackMode> modes(count);
+    ASSERT_TRUE(disc.readSectorsInto(first, count, buffer, modes));
+
+    std::array<uint8_t, RAW_SECTOR_SIZE> one;
+    for (int32_t i = 0; i < count; ++i) {
+        int32_t lba = first + i;
+        const uint8_t* sector = buffer.data() + static_cast<size_t>(i) * RAW_SECTOR_SIZE;
+        ASSERT_TRUE(disc.readSectorInto(lba, one)) << lba;
+        EXPECT_TRUE(std::equal(one.begin(), one.end(), sector)) << lba;
+
+        if (lba >= 0 && lba < 20) {
+            EXPECT_TRUE(allEqual(sector, RAW_SECTOR_SIZE, 0xAA)) << lba;
+        } else if (lba >= 50) {
+            EXPECT_TRUE(allEqual(sector, RAW_SECTOR_SIZE, 0x55)) << lba;
+        }
+        TrackMode expected = lba < 30 ? TrackMode::Mode2_2352 : TrackMode::Audio;
+        EXPECT_EQ(modes[static_cast<size_t>(i)], expected) << lba;
+    }
+
+    auto sectors = disc.readSectors(Disc::FIRST_LBA, 200);
+    ASSERT_TRUE(sectors.ok()) << sectors.error().message;
+    EXPECT_EQ((*sectors)[150].data, (*disc.readSector(0)).data);
+
+    EXPECT_FALSE(disc.readSectorsInto(Disc::FIRST_LBA - 1, 2, buffer));
+    EXPECT_FALSE(disc.readSectorsInto(94, 2, buffer));
+}
+
+TEST_F(GapSectorsTest, UserDataOfGaps) {
+    Disc disc = open();
+
+    // 0xAA subheaders have the Form 2 bit set, like the synthesized gap
+    auto postgap = disc.readUserDataRange(18, 4);
+    ASSERT_TRUE(postgap.ok()) << postgap.error().message;
+    ASSERT_EQ(postgap->size(), 4 * MODE2_FORM2_USER_DATA_SIZE);
+    EXPECT_TRUE(allEqual(postgap->data(), 2 * MODE2_FORM2_USER_DATA_SIZE, 0xAA));
+    EXPECT_TRUE(allEqual(postgap->data() + 2 * MODE2_FORM2_USER_DATA_SIZE, 2 * MODE2_FORM2_USER_DATA_SIZE, 0));
+
+    auto pregap = disc.readUserDataRange(48, 4);
+    ASSERT_TRUE(pregap.ok()) << pregap.error().message;
+    ASSERT_EQ(pregap->size(), 4 * RAW_SECTOR_SIZE);
+    EXPECT_TRUE(allEqual(pregap->data(), 2 * RAW_SECTOR_SIZE, 0));
+    EXPECT_TRUE(allEqual(pregap->data() + 2 * RAW_SECTOR_SIZE, 2 * RAW_SECTOR_SIZE, 0x55));
+
+    auto cooked = disc.readUserData(94);
+    ASSERT_TRUE(cooked.ok()) << cooked.error().message;
+    EXPECT_EQ(cooked->size(), MODE1_USER_DATA_SIZE);
+
+    auto leadIn = disc.readUserData(-10);
+    ASSERT_TRUE(leadIn.ok()) << leadIn.error().message;
+    EXPECT_EQ(leadIn->size(), MODE2_FORM2_USER_DATA_SIZE);
+    EXPECT_TRUE(allEqual(leadIn->data(), leadIn->size(), 0));
+}
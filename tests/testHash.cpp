@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include "libcuebin/datIndex.hpp"
+#include "libcuebin/hash.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+std::span<const uint8_t> bytes(std::string_view s)
+{
+    return {reinterpret_cast<const uint8_t*>(s.data()), s.size()};
+}
+
+uint32_t referenceCrc32(std::span<const uint8_t> data)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint8_t b : data) {
+        crc ^= b;
+        for (int k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+HashDigest digestOf(std::span<const uint8_t> data)
+{
+    HashDigest d;
+    d.size = data.size();
+    d.crc32 = crc32(data);
+    Md5 md5;
+    md5.update(data);
+    d.md5 = md5.finish();
+    Sha1 sha1;
+    sha1.update(data);
+    d.sha1 = sha1.finish();
+    return d;
+}
+
+std::vector<uint8_t> pattern(size_t size, uint32_t seed)
+{
+    std::vector<uint8_t> data(size);
+    uint32_t x = seed;
+    for (auto& b : data) {
+        x = x * 1664525 + 1013904223;
+        b = static_cast<uint8_t>(x >> 24);
+    }
+    return data;
+}
+
+} // anonymous namespace
+
+TEST(Hash, KnownVectors) {
+    EXPECT_EQ(crc32(bytes("123456789")), 0xCBF43926u);
+    EXPECT_EQ(crc32(bytes("")), 0u);
+
+    HashDigest empty = digestOf(bytes(""));
+    EXPECT_EQ(empty.md5Hex(), "d41d8cd98f00b204e9800998ecf8427e");
+    EXPECT_EQ(empty.sha1Hex(), "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+
+    HashDigest abc = digestOf(bytes("abc"));
+    EXPECT_EQ(abc.crc32Hex(), "352441c2");
+    EXPECT_EQ(abc.md5Hex(), "900150983cd24fb0d6963f7d28e17f72");
+    EXPECT_EQ(abc.sha1Hex(), "a9993e364706816aba3e25717850c26c9cd0d89d");
+
+    // Two-block messages exercise the padding boundary
+    std::string_view longer = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    EXPECT_EQ(digestOf(bytes(longer)).sha1Hex(), "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+    EXPECT_EQ(digestOf(bytes(longer)).md5Hex(), "8215ef0796a20bcaaae116d3876c664a");
+}
+
+TEST(Hash, Crc32MatchesBitwiseReference) {
+    // Covers the table tail and, where available, the carry-less multiply bulk path
+    auto data = pattern(70000, 1);
+    for (size_t len : {0, 1, 15, 63, 64, 65, 127, 128, 1000, 4096, 69999}) {
+        for (size_t off : {0, 1, 7}) {
+            auto slice = std::span<const uint8_t>(data).subspan(off, len);
+            EXPECT_EQ(crc32(slice), referenceCrc32(slice)) << "len " << len << " offset " << off;
+        }
+    }
+}
+
+TEST(Hash, IncrementalUpdates) {
+    auto data = pattern(10000, 2);
+    HashDigest whole = digestOf(data);
+
+    uint32_t crc = 0;
+    Md5 md5;
+    Sha1 sha1;
+    size_t pos = 0;
+    for (size_t step : {1, 63, 64, 65, 200, 3000}) {
+        auto part = std::span<const uint8_t>(data).subspan(pos, step);
+        crc = crc32(part, crc);
+        md5.update(part);
+        sha1.update(part);
+        pos += step;
+    }
+    auto rest = std::span<const uint8_t>(data).subspan(pos);
+    crc = crc32(rest, crc);
+    md5.update(rest);
+    sha1.update(rest);
+
+    EXPECT_EQ(crc, whole.crc32);
+    EXPECT_EQ(md5.finish(), whole.md5);
+    EXPECT_EQ(sha1.finish(), whole.sha1);
+}
+
+class HashDiscTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+    std::vector<uint8_t> first;  // Data track (60 sectors) + audio with 2-sector pregap
+    std::vector<uint8_t> second; // One audio track
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_hash";
+        std::filesystem::create_directories(dir);
+
+        first = pattern(102 * 2352, 3);
+        second = pattern(30 * 2352, 4);
+        std::ofstream(dir / "disc (Track 1).bin", std::ios::binary)
+            .write(reinterpret_cast<const char*>(first.data()), static_cast<std::streamsize>(first.size()));
+        std::ofstream(dir / "disc (Track 3).bin", std::ios::binary)
+            .write(reinterpret_cast<const char*>(second.data()), static_cast<std::streamsize>(second.size()));
+        std::ofstream(dir / "disc.cue")
+            << "FILE \"disc (Track 1).bin\" BINARY\n"
+            << "  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n"
+            << "  TRACK 02 AUDIO\n    INDEX 00 00:00:60\n    INDEX 01 00:00:62\n"
+            << "FILE \"disc (Track 3).bin\" BINARY\n"
+            << "  TRACK 03 AUDIO\n    INDEX 01 00:00:00\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+};
+
+TEST_F(HashDiscTest, FilesAndTracks) {
+    auto disc = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    HashOptions options;
+    options.chunkBytes = 64 * 1024; // Several chunks per file, tracks split across them
+    auto hashes = hashDisc(*disc, options);
+    ASSERT_TRUE(hashes.ok()) << hashes.error().message;
+
+    ASSERT_EQ(hashes->files.size(), 2u);
+    EXPECT_EQ(hashes->files[0].path.filename(), "disc (Track 1).bin");
+    EXPECT_EQ(hashes->files[0].digest, digestOf(first));
+    EXPECT_EQ(hashes->files[1].digest, digestOf(second));
+
+    ASSERT_EQ(hashes->tracks.size(), 3u);
+    auto span = std::span<const uint8_t>(first);
+    EXPECT_EQ(hashes->tracks[0].trackNumber, 1);
+    EXPECT_EQ(hashes->tracks[0].digest, digestOf(span.first(60 * 2352)));
+    EXPECT_EQ(hashes->tracks[1].trackNumber, 2);
+    EXPECT_EQ(hashes->tracks[1].digest, digestOf(span.subspan(60 * 2352)));
+    EXPECT_EQ(hashes->tracks[2].trackNumber, 3);
+    EXPECT_EQ(hashes->tracks[2].digest, digestOf(second));
+}
+
+TEST_F(HashDiscTest, DatMatching) {
+    auto disc = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    auto hashes = hashDisc(*disc);
+    ASSERT_TRUE(hashes.ok()) << hashes.error().message;
+
+    const auto& f1 = hashes->files[0].digest;
+    const auto& f2 = hashes->files[1].digest;
+    auto rom = [](const std::string& name, const HashDigest& d, bool upper = false) {
+        std::string sha1 = d.sha1Hex();
+        if (upper) for (auto& c : sha1) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return "<rom name=\"" + name + "\" size=\"" + std::to_string(d.size) + "\" crc=\"" + d.crc32Hex()
+             + "\" md5=\"" + d.md5Hex() + "\" sha1=\"" + sha1 + "\"/>\n";
+    };
+
+    std::string xml =
+        "<?xml version=\"1.0\"?>\n"
+        "<!DOCTYPE datafile PUBLIC \"-//Logiqx//DTD ROM Management Datafile//EN\" \"x\">\n"
+        "<datafile>\n<!-- <game name=\"commented\"> -->\n"
+        "<game name=\"Test &amp; Disc (Europe)\">\n"
+        + rom("disc (Track 1).bin", f1) + rom("disc (Track 3).bin", f2, true)
+        + "<rom name=\"disc.CUE\" size=\"180\" crc=\"0badcafe\" sha1=\"" + std::string(40, '0') + "\"/>\n"
+        + "</game>\n<game name=\"Partial\">\n" + rom("a.bin", f2)
+        + "<rom name=\"b.bin\" size=\"1\" crc=\"00000000\"/>\n</game>\n"
+        "<game name=\"Other\">\n<rom name=\"c.bin\" size=\"5\" crc=\"12345678\"/>\n</game>\n"
+        "</datafile>\n";
+
+    auto dat = DatIndex::parse(xml);
+    ASSERT_TRUE(dat.ok()) << dat.error().message;
+    ASSERT_EQ(dat->games().size(), 3u);
+    EXPECT_EQ(dat->games()[0].name, "Test & Disc (Europe)");
+
+    auto found = dat->find(f2);
+    ASSERT_EQ(found.size(), 2u);
+
+    auto matches = dat->match(*hashes);
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0].game->name, "Test & Disc (Europe)");
+    // The CUE sheet ROM is not hashed, so it is not required either
+    EXPECT_EQ(matches[0].matchedRoms, 2u);
+    EXPECT_EQ(matches[0].requiredRoms, 2u);
+    EXPECT_EQ(matches[0].game->roms.size(), 3u);
+    EXPECT_TRUE(matches[0].complete());
+    EXPECT_EQ(matches[1].game->name, "Partial");
+    EXPECT_FALSE(matches[1].complete());
+
+    EXPECT_FALSE(DatIndex::parse("<datafile><game name=\"x\"><rom size=\"abc\"/></game>").ok());
+    EXPECT_FALSE(DatIndex::parse("<datafile><game name=\"x\"").ok());
+    EXPECT_EQ(DatIndex::load(dir / "missing.dat").error().code, ErrorCode::FileNotFound);
+}
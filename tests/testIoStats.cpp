@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "libcuebin/asyncReader.hpp"
+#include "libcuebin/disc.hpp"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+class IoStatsTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+    std::filesystem::path cue;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_iostats";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        cue = dir / "game.cue";
+
+        std::vector<char> data(40 * RAW_SECTOR_SIZE, 0);
+        std::ofstream(dir / "data.bin", std::ios::binary)
+            .write(data.data(), static_cast<std::streamsize>(data.size()));
+        std::ofstream(dir / "audio.bin", std::ios::binary)
+            .write(data.data(), static_cast<std::streamsize>(20 * RAW_SECTOR_SIZE));
+        std::ofstream(cue) << "FILE \"data.bin\" BINARY\n"
+                           << "  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n"
+                           << "FILE \"audio.bin\" BINARY\n"
+                           << "  TRACK 02 AUDIO\n    INDEX 01 00:00:00\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    Disc open(IoBackend backend = IoBackend::Positional, bool ioStats = true) {
+        DiscOptions options;
+        options.ioBackend = backend;
+        options.ioStats = ioStats;
+        auto disc = Disc::fromCue(cue, options);
+        EXPECT_TRUE(disc.ok());
+        return std::move(*disc);
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(IoStatsTest, CountsReadsPerFile) {
+    Disc disc = open();
+    std::array<uint8_t, RAW_SECTOR_SIZE> buffer;
+    for (int32_t lba = 0; lba < 10; ++lba) ASSERT_TRUE(disc.readSectorInto(lba, buffer));
+    ASSERT_TRUE(disc.readSectorInto(30, buffer)); // Skips ahead: one seek
+
+    std::vector<uint8_t> span(8 * RAW_SECTOR_SIZE);
+    ASSERT_TRUE(disc.readSectorsInto(36, 8, span)); // 4 sectors from each file
+
+    auto stats = disc.ioStats();
+    ASSERT_EQ(stats.files.size(), 2u);
+    EXPECT_EQ(stats.files[0].path.filename(), "data.bin");
+
+    const IoCounters& data = stats.files[0].counters;
+    EXPECT_EQ(data.sectorsRead, 15u);
+    EXPECT_EQ(data.readCalls, 12u);
+    EXPECT_EQ(data.bytesRead, 15u * RAW_SECTOR_SIZE);
+    EXPECT_EQ(data.seeks, 2u);
+    EXPECT_EQ(data.failedReads, 0u);
+    EXPECT_EQ(data.lazyOpens, 1u);
+    EXPECT_EQ(data.latency.count(), data.readCalls);
+
+    const IoCounters& audio = stats.files[1].counters;
+    EXPECT_EQ(audio.sectorsRead, 4u);
+    EXPECT_EQ(audio.readCalls, 1u);
+    EXPECT_EQ(audio.seeks, 0u);
+
+    EXPECT_EQ(stats.total.sectorsRead, 19u);
+    EXPECT_EQ(stats.total.readCalls, 13u);
+    EXPECT_EQ(stats.total.lazyOpens, 2u);
+    EXPECT_EQ(stats.total.latency.count(), 13u);
+    EXPECT_GT(stats.total.latency.quantileNs(0.5), 0u);
+    EXPECT_LE(stats.total.latency.quantileNs(0.5), stats.total.latency.quantileNs(0.99));
+
+    size_t written = 0;
+    ASSERT_TRUE(disc.readUserDataInto(40, 2, span, &written));
+    EXPECT_EQ(disc.ioStats().files[1].counters.sectorsRead, 6u);
+
+    disc.resetIoStats();
+    stats = disc.ioStats();
+    EXPECT_EQ(stats.total.sectorsRead, 0u);
+    EXPECT_EQ(stats.total.readCalls, 0u);
+    EXPECT_EQ(stats.total.latency.count(), 0u);
+}
+
+TEST_F(IoStatsTest, CountsFailedReads) {
+    // Mmap maps the file as it is at first access; shrinking it after load
+    // leaves the tail of the disc unreachable
+    Disc disc = open(IoBackend::Mmap);
+    std::filesystem::resize_file(dir / "data.bin", 10 * RAW_SECTOR_SIZE);
+
+    std::array<uint8_t, RAW_SECTOR_SIZE> buffer;
+    EXPECT_TRUE(disc.readSectorInto(0, buffer));
+    EXPECT_FALSE(disc.readSectorInto(20, buffer));
+
+    auto data = disc.ioStats().files[0].counters;
+    EXPECT_EQ(data.readCalls, 2u);
+    EXPECT_EQ(data.failedReads, 1u);
+    EXPECT_EQ(data.bytesRead, RAW_SECTOR_SIZE);
+    EXPECT_EQ(data.sectorsRead, 1u);
+}
+
+TEST_F(IoStatsTest, StreamBackendUnderContention) {
+    Disc disc = open(IoBackend::Stream);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&disc]() {
+            std::array<uint8_t, RAW_SECTOR_SIZE> buffer;
+            for (int i = 0; i < 200; ++i) (void)disc.readSectorInto(i % 40, buffer);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    auto stats = disc.ioStats();
+    EXPECT_EQ(stats.files[0].counters.readCalls, 800u);
+    EXPECT_EQ(stats.files[0].counters.sectorsRead, 800u);
+    EXPECT_EQ(stats.files[0].counters.lazyOpens, 1u);
+}
+
+TEST_F(IoStatsTest, CountsAsyncReads) {
+    for (auto backend : {AsyncBackend::ThreadPool, AsyncBackend::IoUring}) {
+        auto reader = AsyncReader::create({backend});
+        if (!reader && reader.error().code == ErrorCode::Unsupported) continue;
+        ASSERT_TRUE(reader.ok()) << reader.error().message;
+
+        Disc disc = open();
+        std::vector<uint8_t> span(8 * RAW_SECTOR_SIZE);
+        ASSERT_TRUE(reader->submit(disc, 36, 8, span).ok()); // 4 sectors from each file
+        std::array<AsyncCompletion, 1> done{};
+        ASSERT_EQ(reader->wait(done, 1), 1u);
+        ASSERT_TRUE(done[0].status);
+
+        auto stats = disc.ioStats();
+        for (const auto& file : stats.files) {
+            EXPECT_EQ(file.counters.sectorsRead, 4u) << static_cast<int>(backend);
+            EXPECT_EQ(file.counters.readCalls, 1u) << static_cast<int>(backend);
+            EXPECT_EQ(file.counters.bytesRead, 4u * RAW_SECTOR_SIZE) << static_cast<int>(backend);
+            EXPECT_EQ(file.counters.latency.count(), 1u) << static_cast<int>(backend);
+        }
+    }
+}
+
+TEST_F(IoStatsTest, DisabledStatsStayZero) {
+    Disc disc = open(IoBackend::Positional, false);
+    std::array<uint8_t, RAW_SECTOR_SIZE> buffer;
+    ASSERT_TRUE(disc.readSectorInto(0, buffer));
+    auto stats = disc.ioStats();
+    EXPECT_EQ(stats.total.readCalls, 0u);
+    EXPECT_EQ(stats.total.sectorsRead, 0u);
+    EXPECT_EQ(stats.total.lazyOpens, 0u);
+}
+
+TEST(LatencyHistogramTest, Quantiles) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.quantileNs(0.5), 0u);
+    h.buckets[3] = 90;  // [4, 8) ns
+    h.buckets[10] = 9;  // [512, 1024) ns
+    h.buckets[LatencyHistogram::BUCKET_COUNT - 1] = 1;
+    EXPECT_EQ(h.count(), 100u);
+    EXPECT_EQ(h.quantileNs(0.0), 8u);
+    EXPECT_EQ(h.quantileNs(0.9), 8u);
+    EXPECT_EQ(h.quantileNs(0.95), 1024u);
+    EXPECT_EQ(h.quantileNs(1.0), UINT64_MAX);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBoundNs(0), 1u);
+}
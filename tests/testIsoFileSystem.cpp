@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include "libcuebin/isoFileSystem.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+constexpr size_t BLOCK = 2048;
+
+// Minimal ISO9660 image writer for MODE1/2048 test discs
+class IsoBuilder {
+public:
+    explicit IsoBuilder(size_t sectors) : m_data(sectors * BLOCK, 0) {}
+
+    uint8_t* sector(size_t lba) { return m_data.data() + lba * BLOCK; }
+
+    static void putBoth32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            p[i] = static_cast<uint8_t>(v >> (8 * i));
+            p[7 - i] = static_cast<uint8_t>(v >> (8 * i));
+        }
+    }
+
+    // Appends a directory record at `pos`, moving to the next sector rather
+    // than straddling a boundary
+    void putRecord(size_t& pos, const std::string& name, uint32_t lba, uint32_t size, bool dir) {
+        size_t length = 33 + name.size() + ((name.size() % 2 == 0) ? 1 : 0);
+        if (pos % BLOCK + length > BLOCK) pos = (pos / BLOCK + 1) * BLOCK;
+        uint8_t* rec = m_data.data() + pos;
+        rec[0] = static_cast<uint8_t>(length);
+        putBoth32(rec + 2, lba);
+        putBoth32(rec + 10, size);
+        rec[25] = dir ? 0x02 : 0x00;
+        rec[32] = static_cast<uint8_t>(name.size());
+        std::memcpy(rec + 33, name.data(), name.size());
+        pos += length;
+    }
+
+    void putDirectory(uint32_t lba, uint32_t parentLba, uint32_t sectors,
+                      const std::vector<std::tuple<std::string, uint32_t, uint32_t, bool>>& children) {
+        size_t pos = lba * BLOCK;
+        putRecord(pos, std::string(1, '\0'), lba, sectors * BLOCK, true);
+        putRecord(pos, std::string(1, '\1'), parentLba, BLOCK, true);
+        for (const auto& [name, childLba, size, dir] : children) putRecord(pos, name, childLba, size, dir);
+    }
+
+    void write(const std::filesystem::path& path) {
+        std::ofstream(path, std::ios::binary)
+            .write(reinterpret_cast<const char*>(m_data.data()), m_data.size());
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+// Sectors: 16 PVD, 17 terminator, 18 path table, 19-20 root, 21 DATA,
+// 22 DATA/SUB, 23 SYSTEM.CNF, 24-26 DATA/BIG.BIN, 27 DATA/SUB/DEEP.TXT
+const std::string SYSTEM_CNF = "BOOT = cdrom:\\SLUS_000.01;1\r\nTCB = 4\r\nEVENT = 10\r\n";
+constexpr uint32_t BIG_SIZE = 5000;
+
+class IsoFileSystemTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_iso";
+        std::filesystem::create_directories(dir);
+
+        IsoBuilder iso(30);
+        uint8_t* pvd = iso.sector(16);
+        pvd[0] = 1;
+        std::memcpy(pvd + 1, "CD001", 5);
+        pvd[6] = 1;
+        std::memset(pvd + 40, ' ', 32);
+        std::memcpy(pvd + 40, "TEST_VOLUME", 11);
+        IsoBuilder::putBoth32(pvd + 80, 30);
+        pvd[128] = 0x00;
+        pvd[129] = 0x08; // 2048-byte blocks
+        IsoBuilder::putBoth32(pvd + 132, 10 + 14 + 12);
+        pvd[140] = 18;
+        pvd[156] = 34;
+        IsoBuilder::putBoth32(pvd + 156 + 2, 19);
+        IsoBuilder::putBoth32(pvd + 156 + 10, 2 * BLOCK);
+        pvd[156 + 25] = 0x02;
+        pvd[156 + 32] = 1;
+
+        uint8_t* term = iso.sector(17);
+        term[0] = 255;
+        std::memcpy(term + 1, "CD001", 5);
+
+        // L path table: root, DATA (parent 1), SUB (parent 2)
+        uint8_t* table = iso.sector(18);
+        const uint8_t pathTable[] = {
+            1, 0, 19, 0, 0, 0, 1, 0, 0, 0,
+            4, 0, 21, 0, 0, 0, 1, 0, 'D', 'A', 'T', 'A',
+            3, 0, 22, 0, 0, 0, 2, 0, 'S', 'U', 'B', 0,
+        };
+        std::memcpy(table, pathTable, sizeof(pathTable));
+
+        // Enough filler entries to push the root directory into a second sector
+        std::vector<std::tuple<std::string, uint32_t, uint32_t, bool>> root = {
+            {"SYSTEM.CNF;1", 23, static_cast<uint32_t>(SYSTEM_CNF.size()), false},
+            {"DATA", 21, BLOCK, true},
+        };
+        for (int i = 0; i < 60; ++i) {
+            char name[16];
+            std::snprintf(name, sizeof(name), "FILE%02d.DAT;1", i);
+            root.emplace_back(name, 23, 8, false);
+        }
+        iso.putDirectory(19, 19, 2, root);
+        iso.putDirectory(21, 19, 1, {{"BIG.BIN;1", 24, BIG_SIZE, false}, {"SUB", 22, BLOCK, true}});
+        iso.putDirectory(22, 21, 1, {{"DEEP.TXT;1", 27, 5, false}});
+
+        std::memcpy(iso.sector(23), SYSTEM_CNF.data(), SYSTEM_CNF.size());
+        for (uint32_t i = 0; i < BIG_SIZE; ++i) iso.sector(24)[i] = static_cast<uint8_t>(i * 3 + i / 256);
+        std::memcpy(iso.sector(27), "DEEP!", 5);
+
+        iso.write(dir / "iso.bin");
+        std::ofstream(dir / "iso.cue")
+            << "FILE \"iso.bin\" BINARY\n  TRACK 01 MODE1/2048\n    INDEX 01 00:00:00\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(IsoFileSystemTest, MountAndReadSystemCnf) {
+    auto disc = Disc::fromCue(dir / "iso.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    auto fs = IsoFileSystem::mount(*disc);
+    ASSERT_TRUE(fs.ok()) << fs.error().message;
+    EXPECT_EQ(fs->volumeId(), "TEST_VOLUME");
+    EXPECT_EQ(fs->volumeSectors(), 30u);
+    EXPECT_EQ(fs->loadedDirectoryCount(), 0u);
+
+    // PlayStation-style boot path: device prefix, backslash, version suffix
+    auto file = fs->open("cdrom:\\system.cnf;1");
+    ASSERT_TRUE(file.ok()) << file.error().message;
+    EXPECT_EQ(file->info().name, "SYSTEM.CNF");
+    EXPECT_EQ(file->size(), SYSTEM_CNF.size());
+
+    auto contents = file->readAll();
+    ASSERT_TRUE(contents.ok()) << contents.error().message;
+    EXPECT_EQ(std::string(contents->begin(), contents->end()), SYSTEM_CNF);
+    EXPECT_EQ(fs->loadedDirectoryCount(), 1u);
+}
+
+TEST_F(IsoFileSystemTest, DirectoriesLoadLazily) {
+    auto disc = Disc::fromCue(dir / "iso.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    auto fs = IsoFileSystem::mount(*disc);
+    ASSERT_TRUE(fs.ok()) << fs.error().message;
+
+    // The path table locates DATA/SUB without loading the root or DATA
+    auto deep = fs->stat("/data/sub/deep.txt");
+    ASSERT_TRUE(deep.ok()) << deep.error().message;
+    EXPECT_EQ(deep->size, 5u);
+    EXPECT_EQ(deep->extentLba, 27u);
+    EXPECT_EQ(fs->loadedDirectoryCount(), 1u);
+
+    // Repeated lookups come from the index
+    ASSERT_TRUE(fs->stat("DATA/SUB/DEEP.TXT").ok());
+    EXPECT_EQ(fs->loadedDirectoryCount(), 1u);
+
+    auto sub = fs->stat("data/sub");
+    ASSERT_TRUE(sub.ok()) << sub.error().message;
+    EXPECT_TRUE(sub->isDirectory);
+    EXPECT_EQ(fs->loadedDirectoryCount(), 2u);
+
+    // The root spans two sectors
+    auto list = fs->listDirectory("/");
+    ASSERT_TRUE(list.ok()) << list.error().message;
+    ASSERT_EQ(list->size(), 62u);
+    EXPECT_EQ((*list)[0].name, "SYSTEM.CNF");
+    EXPECT_EQ((*list)[61].name, "FILE59.DAT");
+    EXPECT_EQ(fs->loadedDirectoryCount(), 3u);
+}
+
+TEST_F(IsoFileSystemTest, ReadAtOffsets) {
+    auto disc = Disc::fromCue(dir / "iso.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    auto fs = IsoFileSystem::mount(*disc);
+    ASSERT_TRUE(fs.ok()) << fs.error().message;
+
+    auto file = fs->open("DATA/BIG.BIN");
+    ASSERT_TRUE(file.ok()) << file.error().message;
+
+    std::vector<uint8_t> expected(BIG_SIZE);
+    for (uint32_t i = 0; i < BIG_SIZE; ++i) expected[i] = static_cast<uint8_t>(i * 3 + i / 256);
+
+    // Unaligned head, whole middle sector, partial tail, and past the end
+    struct Case { uint64_t offset; size_t size; size_t expect; };
+    for (const auto& c : {Case{0, BIG_SIZE, BIG_SIZE}, Case{100, 4000, 4000}, Case{2048, 2048, 2048},
+                          Case{10, 20, 20}, Case{4990, 100, 10}, Case{BIG_SIZE, 10, 0}}) {
+        std::vector<uint8_t> out(c.size, 0xEE);
+        auto n = file->read(c.offset, out);
+        ASSERT_TRUE(n.ok()) << n.error().message;
+        ASSERT_EQ(*n, c.expect) << "offset " << c.offset;
+        EXPECT_TRUE(std::equal(out.begin(), out.begin() + c.expect, expected.begin() + c.offset))
+            << "offset " << c.offset;
+    }
+}
+
+TEST_F(IsoFileSystemTest, Errors) {
+    auto disc = Disc::fromCue(dir / "iso.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    auto fs = IsoFileSystem::mount(*disc);
+    ASSERT_TRUE(fs.ok()) << fs.error().message;
+
+    EXPECT_EQ(fs->stat("NOPE.TXT").error().code, ErrorCode::PathNotFound);
+    EXPECT_EQ(fs->stat("NOPE/FILE.TXT").error().code, ErrorCode::PathNotFound);
+    EXPECT_EQ(fs->stat("SYSTEM.CNF/X").error().code, ErrorCode::PathNotFound);
+    EXPECT_EQ(fs->open("DATA").error().code, ErrorCode::InvalidArgument);
+    EXPECT_EQ(fs->listDirectory("SYSTEM.CNF").error().code, ErrorCode::InvalidArgument);
+
+    // A blank data track has no volume descriptor; an audio disc has no data track
+    std::vector<uint8_t> blank(30 * BLOCK);
+    std::ofstream(dir / "blank.bin", std::ios::binary)
+        .write(reinterpret_cast<const char*>(blank.data()), blank.size());
+    std::ofstream(dir / "blank.cue")
+        << "FILE \"blank.bin\" BINARY\n  TRACK 01 MODE1/2048\n    INDEX 01 00:00:00\n";
+    std::ofstream(dir / "audio.cue")
+        << "FILE \"blank.bin\" BINARY\n  TRACK 01 AUDIO\n    INDEX 01 00:00:00\n";
+
+    auto blankDisc = Disc::fromCue(dir / "blank.cue");
+    ASSERT_TRUE(blankDisc.ok()) << blankDisc.error().message;
+    EXPECT_EQ(IsoFileSystem::mount(*blankDisc).error().code, ErrorCode::InvalidFileSystem);
+
+    auto audioDisc = Disc::fromCue(dir / "audio.cue");
+    ASSERT_TRUE(audioDisc.ok()) << audioDisc.error().message;
+    EXPECT_EQ(IsoFileSystem::mount(*audioDisc).error().code, ErrorCode::TrackNotFound);
+}
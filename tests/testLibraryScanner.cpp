@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "libcuebin/disc.hpp"
+#include "libcuebin/libraryScanner.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+void writeBin(const std::filesystem::path& path, size_t sectors)
+{
+    std::ofstream(path, std::ios::binary)
+        .write(std::string(sectors * RAW_SECTOR_SIZE, '\0').data(),
+               static_cast<std::streamsize>(sectors * RAW_SECTOR_SIZE));
+}
+
+void writeSingleTrackCue(const std::filesystem::path& cue, const std::string& bin)
+{
+    std::ofstream(cue) << "TITLE \"" << cue.stem().string() << "\"\n"
+                       << "FILE \"" << bin << "\" BINARY\n"
+                       << "  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n";
+}
+
+class LibraryScannerTest : public ::testing::Test {
+protected:
+    std::filesystem::path root;
+
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() / "libcuebin_library";
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root / "psx" / "rpg");
+        std::filesystem::create_directories(root / "saturn");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(LibraryScannerTest, ScansDirectoryTree) {
+    // 40 good discs spread over nested directories
+    for (int i = 0; i < 40; ++i) {
+        auto dir = i % 3 == 0 ? root : i % 3 == 1 ? root / "psx" / "rpg" : root / "saturn";
+        auto name = "game" + std::to_string(i);
+        writeBin(dir / (name + ".bin"), 10 + i);
+        writeSingleTrackCue(dir / (name + ".cue"), name + ".bin");
+    }
+    // Upper-case extension, and a multi-track disc
+    writeBin(root / "psx" / "two.bin", 30);
+    std::ofstream(root / "psx" / "TWO.CUE")
+        << "FILE \"two.bin\" BINARY\n  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n"
+        << "  TRACK 02 AUDIO\n    INDEX 01 00:00:20\n";
+    std::ofstream(root / "psx" / "notes.txt") << "not a sheet";
+
+    ScanOptions options;
+    options.threadCount = 4;
+    options.maxOpenFiles = 2;
+    auto catalog = scanLibrary(root, options);
+    ASSERT_TRUE(catalog.ok()) << catalog.error().message;
+    ASSERT_EQ(catalog->discs.size(), 41u);
+    EXPECT_EQ(catalog->failedCount, 0u);
+    EXPECT_TRUE(std::is_sorted(catalog->discs.begin(), catalog->discs.end(),
+        [](const CatalogEntry& a, const CatalogEntry& b) { return a.cuePath < b.cuePath; }));
+
+    for (const auto& entry : catalog->discs) {
+        ASSERT_TRUE(entry.ok()) << entry.cuePath;
+        auto disc = Disc::fromCue(entry.cuePath);
+        ASSERT_TRUE(disc.ok());
+        EXPECT_EQ(entry.totalSectors, disc->totalSectors());
+        auto tracks = catalog->tracksOf(entry);
+        ASSERT_EQ(tracks.size(), disc->trackCount());
+        for (size_t i = 0; i < tracks.size(); ++i) {
+            EXPECT_EQ(tracks[i].number, disc->tracks()[i].number());
+            EXPECT_EQ(tracks[i].startLba, disc->tracks()[i].startLba());
+            EXPECT_EQ(tracks[i].lengthSectors, disc->tracks()[i].lengthSectors());
+        }
+    }
+
+    auto two = std::find_if(catalog->discs.begin(), catalog->discs.end(),
+        [](const CatalogEntry& e) { return e.cuePath.filename() == "TWO.CUE"; });
+    ASSERT_NE(two, catalog->discs.end());
+    EXPECT_EQ(two->trackCount, 2);
+    EXPECT_EQ(catalog->tracksOf(*two)[1].mode, TrackMode::Audio);
+    EXPECT_FALSE(two->title.has_value());
+
+    auto game0 = std::find_if(catalog->discs.begin(), catalog->discs.end(),
+        [](const CatalogEntry& e) { return e.cuePath.filename() == "game0.cue"; });
+    ASSERT_NE(game0, catalog->discs.end());
+    EXPECT_EQ(game0->title, "game0");
+
+    options.recursive = false;
+    auto shallow = scanLibrary(root, options);
+    ASSERT_TRUE(shallow.ok());
+    EXPECT_EQ(shallow->discs.size(), 14u);
+}
+
+TEST_F(LibraryScannerTest, ReportsPerDiscErrors) {
+    writeBin(root / "good.bin", 20);
+    writeSingleTrackCue(root / "good.cue", "good.bin");
+    writeSingleTrackCue(root / "missing.cue", "nowhere.bin");
+    std::ofstream(root / "broken.cue") << "FILE \"good.bin\" BINARY\n  TRACK 01 MODE9/2352\n";
+    std::ofstream(root / "empty.cue") << "REM nothing here\n";
+
+    auto catalog = scanLibrary(root);
+    ASSERT_TRUE(catalog.ok());
+    ASSERT_EQ(catalog->discs.size(), 4u);
+    EXPECT_EQ(catalog->failedCount, 3u);
+
+    auto codeOf = [&](const std::string& name) {
+        for (const auto& e : catalog->discs) {
+            if (e.cuePath.filename() == name) return e.error ? e.error->code : ErrorCode::Unsupported;
+        }
+        return ErrorCode::PathNotFound;
+    };
+    EXPECT_EQ(codeOf("missing.cue"), ErrorCode::FileNotFound);
+    EXPECT_EQ(codeOf("broken.cue"), ErrorCode::InvalidTrackMode);
+    EXPECT_EQ(codeOf("empty.cue"), ErrorCode::InvalidCueFormat);
+
+    for (const auto& e : catalog->discs) {
+        if (!e.ok()) EXPECT_EQ(e.trackCount, 0);
+        else EXPECT_EQ(e.totalSectors, 20);
+    }
+
+    EXPECT_FALSE(scanLibrary(root / "absent").ok());
+}
+
+TEST_F(LibraryScannerTest, ScansExplicitList) {
+    std::vector<std::filesystem::path> sheets;
+    for (int i = 0; i < 10; ++i) {
+        auto name = "disc" + std::to_string(i);
+        writeBin(root / (name + ".bin"), 5);
+        writeSingleTrackCue(root / (name + ".cue"), name + ".bin");
+        sheets.push_back(root / (name + ".cue"));
+    }
+    sheets.push_back(root / "absent.cue");
+
+    auto catalog = scanCueSheets(sheets);
+    ASSERT_EQ(catalog.discs.size(), 11u);
+    EXPECT_EQ(catalog.failedCount, 1u);
+    EXPECT_EQ(catalog.tracks.size(), 10u);
+
+    EXPECT_TRUE(scanCueSheets({}).discs.empty());
+}
@@ -0,0 +1,310 @@
+#include <gtest/gtest.h>
+#include "libcuebin/compressedImage.hpp"
+#include "libcuebin/cueParser.hpp"
+#include "libcuebin/disc.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts heap allocations made by the current thread. Other threads (gtest,
+// spdlog) leave the count alone.
+namespace {
+thread_local size_t g_allocations = 0;
+
+void* countedAlloc(std::size_t size, std::size_t align)
+{
+    ++g_allocations;
+    if (size == 0) size = 1;
+    void* p = align <= alignof(std::max_align_t)
+        ? std::malloc(size)
+        : std::aligned_alloc(align, (size + align - 1) / align * align);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+} // anonymous namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size, 0); }
+void* operator new[](std::size_t size) { return countedAlloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t align) { return countedAlloc(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return countedAlloc(size, static_cast<std::size_t>(align)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+using namespace cuebin;
+
+namespace {
+
+// Upstream resource that tracks what is outstanding
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t outstandingBytes = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override
+    {
+        ++allocations;
+        outstandingBytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override
+    {
+        outstandingBytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+class RealTimeTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+    std::filesystem::path cue;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_realtime";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        cue = dir / "game.cue";
+
+        // Track 1 MODE1/2048 in its own file; tracks 2-3 audio sharing one,
+        // with a pregap and a .sub sidecar for the second file's sectors
+        std::vector<char> data(20 * 2048, 0);
+        for (size_t i = 0; i < 20; ++i) data[i * 2048] = static_cast<char>(i + 1);
+        std::ofstream(dir / "data.bin", std::ios::binary)
+            .write(data.data(), static_cast<std::streamsize>(data.size()));
+        std::vector<char> audio(30 * RAW_SECTOR_SIZE, 0x11);
+        std::ofstream(dir / "audio.bin", std::ios::binary)
+            .write(audio.data(), static_cast<std::streamsize>(audio.size()));
+        std::vector<char> sub(50 * 96, 0x22);
+        std::ofstream(dir / "game.sub", std::ios::binary)
+            .write(sub.data(), static_cast<std::streamsize>(sub.size()));
+
+        std::ofstream(cue) << "TITLE \"Real Time\"\nPERFORMER \"Nobody\"\n"
+                           << "FILE \"data.bin\" BINARY\n"
+                           << "  TRACK 01 MODE1/2048\n    INDEX 01 00:00:00\n"
+                           << "FILE \"audio.bin\" BINARY\n"
+                           << "  TRACK 02 AUDIO\n    TITLE \"Intro\"\n    ISRC JPSMK0100001\n"
+                           << "    PREGAP 00:00:02\n    INDEX 01 00:00:00\n"
+                           << "  TRACK 03 AUDIO\n    INDEX 00 00:00:15\n    INDEX 01 00:00:18\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+};
+
+// Runs every read API over the whole disc and returns the heap allocations
+// made. Results are folded into `ok` so no assertion runs while counting.
+size_t countReadAllocations(const Disc& disc, bool& ok)
+{
+    static std::vector<uint8_t> buffer(8 * RAW_SECTOR_SIZE);
+    static std::vector<TrackMode> modes(8);
+    std::array<uint8_t, SUBCHANNEL_SIZE> sub{};
+    std::array<uint8_t, SUBCHANNEL_CHANNEL_SIZE> q{};
+
+    size_t before = g_allocations;
+    ok = true;
+    int32_t total = disc.totalSectors();
+    for (int32_t lba = 0; lba < total; ++lba) {
+        const Track* trk = disc.findTrack(lba);
+        if (!trk) continue; // Pregap sectors are not stored
+        ok &= disc.readSectorInto(lba, buffer, modes.data()).ok();
+        auto sector = disc.readSector(lba);
+        ok &= sector.ok();
+        ok &= disc.readSector(MSF::fromLba(lba)).ok();
+        size_t written = 0;
+        ok &= disc.readUserDataInto(lba, 1, buffer, &written).ok();
+        ok &= written > 0;
+        ok &= trk->title().has_value() || trk->number() != 2;
+        ok &= !trk->indices().empty();
+    }
+    ok &= disc.readSectorsInto(5, 8, buffer, modes).ok();
+    ok &= disc.readSectorsInto(total - 8, 8, buffer).ok();
+    for (int32_t lba = -150; lba < total; ++lba) {
+        ok &= disc.readSubchannel(lba, sub).ok();
+        ok &= disc.readSubchannelQ(lba, q).ok();
+        ok &= disc.synthesizeSubchannelQ(lba, q).ok();
+    }
+    ok &= disc.track(2) != nullptr && disc.tracks().size() == 3;
+    ok &= disc.title() == "Real Time" && disc.performer() == "Nobody";
+
+    // Failures report their code without building a message
+    ok &= disc.readSector(Disc::FIRST_LBA - 1).error().code == ErrorCode::LBAOutOfRange;
+    ok &= disc.readSector(total).error().message.empty();
+    ok &= disc.readSectorInto(total, buffer).code() == ErrorCode::LBAOutOfRange;
+    ok &= disc.readSectorsInto(0, 9, buffer).code() == ErrorCode::InvalidArgument;
+    ok &= disc.readSectors(0, 1).error().code == ErrorCode::Unsupported;
+    ok &= disc.readUserData(0).error().code == ErrorCode::Unsupported;
+    ok &= disc.readSubchannelQ(total + 1000000, q).code() == ErrorCode::LBAOutOfRange;
+    return g_allocations - before;
+}
+
+} // anonymous namespace
+
+TEST_F(RealTimeTest, ReadsDoNotAllocate) {
+    for (auto backend : {IoBackend::Stream, IoBackend::Mmap, IoBackend::Positional}) {
+        CountingResource resource;
+        DiscOptions options;
+        options.ioBackend = backend;
+        options.realTime = true;
+        options.memoryResource = &resource;
+        auto disc = Disc::fromCue(cue, options);
+        ASSERT_TRUE(disc.ok()) << disc.error().message;
+        ASSERT_TRUE(disc->hasSubchannelFile());
+
+        bool ok = false;
+        EXPECT_EQ(countReadAllocations(*disc, ok), 0u) << static_cast<int>(backend);
+        EXPECT_TRUE(ok) << static_cast<int>(backend);
+
+        if (backend == IoBackend::Mmap) {
+            size_t before = g_allocations;
+            bool viewed = disc->sectorView(0).ok()
+                && disc->sectorView(-1).error().code == ErrorCode::LBAOutOfRange;
+            EXPECT_EQ(g_allocations - before, 0u);
+            EXPECT_TRUE(viewed);
+        }
+    }
+}
+
+TEST_F(RealTimeTest, ReadsMatchDefaultMode) {
+    auto normal = Disc::fromCue(cue);
+    DiscOptions options;
+    options.realTime = true;
+    auto realTime = Disc::fromCue(cue, options);
+    ASSERT_TRUE(normal.ok());
+    ASSERT_TRUE(realTime.ok());
+    ASSERT_EQ(normal->totalSectors(), realTime->totalSectors());
+
+    for (int32_t lba : {0, 7, 19, 22, 36, 40, 48}) {
+        auto a = normal->readSector(lba);
+        auto b = realTime->readSector(lba);
+        ASSERT_TRUE(a.ok()) << lba;
+        ASSERT_TRUE(b.ok()) << lba;
+        EXPECT_EQ(a->data, b->data) << lba;
+        EXPECT_EQ(a->mode, b->mode) << lba;
+    }
+    // Default-mode errors keep their descriptive messages, which the
+    // allocation counter sees
+    size_t before = g_allocations;
+    EXPECT_FALSE(normal->readSector(Disc::FIRST_LBA - 1).error().message.empty());
+    EXPECT_GT(g_allocations - before, 0u);
+}
+
+TEST_F(RealTimeTest, DefaultModeReadsDoNotAllocate) {
+    // Without real-time mode or the block cache, Into() reads only allocate
+    // when a file is first opened
+    for (auto backend : {IoBackend::Stream, IoBackend::Mmap, IoBackend::Positional}) {
+        DiscOptions options;
+        options.ioBackend = backend;
+        auto disc = Disc::fromCue(cue, options);
+        ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+        std::vector<uint8_t> buffer(static_cast<size_t>(disc->totalSectors()) * RAW_SECTOR_SIZE);
+        ASSERT_TRUE(disc->readSectorsInto(0, disc->totalSectors(), buffer));
+
+        size_t before = g_allocations;
+        bool ok = true;
+        for (int32_t lba = 0; lba < disc->totalSectors(); ++lba) {
+            ok &= disc->readSectorInto(lba, buffer).ok();
+        }
+        ok &= disc->readSectorsInto(0, disc->totalSectors(), buffer).ok();
+        EXPECT_EQ(g_allocations - before, 0u) << static_cast<int>(backend);
+        EXPECT_TRUE(ok) << static_cast<int>(backend);
+    }
+}
+
+TEST_F(RealTimeTest, CompressedChunkMissesDoNotAllocate) {
+    // Once warm, a miss inflates into buffers recycled from earlier misses
+    CompressOptions compress;
+    compress.chunkSectors = 4;
+    ASSERT_TRUE(compressFile(dir / "audio.bin", dir / "audio.cbc", {}, compress).ok());
+    std::ofstream(dir / "packed.cue") << "FILE \"audio.cbc\" BINARY\n  TRACK 01 AUDIO\n    INDEX 01 00:00:00\n";
+
+    DiscOptions options;
+    options.compressedCacheChunks = 1; // Every chunk change misses
+    auto disc = Disc::fromCue(dir / "packed.cue", options);
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+
+    std::vector<uint8_t> buffer(RAW_SECTOR_SIZE);
+    bool ok = true;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int32_t lba = 0; lba < disc->totalSectors(); ++lba) ok &= disc->readSectorInto(lba, buffer).ok();
+    }
+
+    size_t before = g_allocations;
+    for (int32_t lba = 0; lba < disc->totalSectors(); ++lba) ok &= disc->readSectorInto(lba, buffer).ok();
+    EXPECT_EQ(g_allocations - before, 0u);
+    EXPECT_TRUE(ok);
+}
+
+TEST_F(RealTimeTest, MetadataLivesInResource) {
+    CountingResource resource;
+    {
+        DiscOptions options;
+        options.realTime = true;
+        options.memoryResource = &resource;
+        auto disc = Disc::fromCue(cue, options);
+        ASSERT_TRUE(disc.ok());
+        EXPECT_GT(resource.allocations, 0u);
+        EXPECT_GT(resource.outstandingBytes, 0u);
+
+        const CueSheet& sheet = disc->cueSheet();
+        EXPECT_EQ(sheet.get_allocator().resource(), &resource);
+        EXPECT_EQ(sheet.files[1].tracks[0].get_allocator().resource(), &resource);
+        EXPECT_EQ(sheet.files[1].tracks[0].title->get_allocator().resource(), &resource);
+        EXPECT_EQ(disc->track(2)->isrc(), "JPSMK0100001");
+    }
+    EXPECT_EQ(resource.outstandingBytes, 0u);
+
+    // The parser alone, on a fixed buffer
+    std::array<std::byte, 4096> arena;
+    std::pmr::monotonic_buffer_resource monotonic(arena.data(), arena.size(),
+                                                  std::pmr::null_memory_resource());
+    auto sheet = CueParser::parseString(
+        "TITLE \"Arena\"\nREM one\nFILE \"a.bin\" BINARY\n"
+        "  TRACK 01 AUDIO\n    PERFORMER \"Someone with a rather long name\"\n"
+        "    INDEX 01 00:00:00\n", &monotonic);
+    ASSERT_TRUE(sheet.ok());
+    EXPECT_EQ(sheet->title, "Arena");
+    EXPECT_EQ(sheet->files[0].tracks[0].performer, "Someone with a rather long name");
+    EXPECT_EQ(sheet->files[0].tracks[0].get_allocator().resource(), &monotonic);
+}
+
+TEST_F(RealTimeTest, RejectsUnsupportedOptions) {
+    DiscOptions options;
+    options.realTime = true;
+    options.readAhead = true;
+    auto disc = Disc::fromCue(cue, options);
+    ASSERT_FALSE(disc.ok());
+    EXPECT_EQ(disc.error().code, ErrorCode::InvalidArgument);
+}
+
+TEST_F(RealTimeTest, RejectsMoreThan99Tracks) {
+    std::ofstream sheet(cue);
+    sheet << "FILE \"audio.bin\" BINARY\n";
+    for (int i = 1; i <= 100; ++i) {
+        sheet << "  TRACK " << i << " AUDIO\n    INDEX 01 " << MSF::fromLba(i / 4).toString() << "\n";
+    }
+    sheet.close();
+
+    auto disc = Disc::fromCue(cue);
+    ASSERT_FALSE(disc.ok());
+    EXPECT_EQ(disc.error().code, ErrorCode::InvalidCueFormat);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "libcuebin/disc.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+class SnapshotTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+    std::filesystem::path cue;
+    std::filesystem::path snapshot;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_snapshot";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        cue = dir / "game.cue";
+        snapshot = dir / "game.snap";
+
+        std::vector<char> data(40 * RAW_SECTOR_SIZE);
+        for (size_t i = 0; i < 40; ++i) data[i * RAW_SECTOR_SIZE] = static_cast<char>(i);
+        std::ofstream(dir / "game.bin", std::ios::binary)
+            .write(data.data(), static_cast<std::streamsize>(data.size()));
+        std::ofstream(dir / "track3.bin", std::ios::binary)
+            .write(data.data(), 10 * RAW_SECTOR_SIZE);
+        writeCue("AAAA");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    void writeCue(const std::string& title) {
+        std::ofstream(cue) << "CATALOG 1234567890123\nTITLE \"" << title << "\"\n"
+                           << "REM GENRE Puzzle\n"
+                           << "FILE \"game.bin\" BINARY\n"
+                           << "  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n"
+                           << "  TRACK 02 AUDIO\n    FLAGS DCP\n    TITLE \"Intro\"\n"
+                           << "    INDEX 00 00:00:20\n    INDEX 01 00:00:22\n"
+                           << "FILE \"track3.bin\" BINARY\n"
+                           << "  TRACK 03 AUDIO\n    PREGAP 00:00:05\n    INDEX 01 00:00:00\n"
+                           << "    POSTGAP 00:00:02\n";
+    }
+
+    // Rewrites the sheet with a title of the same length and restores its
+    // timestamp, so only a snapshot can still report the old title
+    void rewriteCueKeepingStamp(const std::string& title) {
+        auto mtime = std::filesystem::last_write_time(cue);
+        writeCue(title);
+        std::filesystem::last_write_time(cue, mtime);
+    }
+};
+
+void expectSameLayout(const Disc& a, const Disc& b)
+{
+    ASSERT_EQ(a.trackCount(), b.trackCount());
+    EXPECT_EQ(a.totalSectors(), b.totalSectors());
+    for (size_t i = 0; i < a.trackCount(); ++i) {
+        const Track& x = a.tracks()[i];
+        const Track& y = b.tracks()[i];
+        EXPECT_EQ(x.number(), y.number());
+        EXPECT_EQ(x.mode(), y.mode());
+        EXPECT_EQ(x.startLba(), y.startLba());
+        EXPECT_EQ(x.lengthSectors(), y.lengthSectors());
+        EXPECT_EQ(x.pregapSectors(), y.pregapSectors());
+        EXPECT_EQ(x.postgapSectors(), y.postgapSectors());
+        EXPECT_EQ(x.indices().size(), y.indices().size());
+        EXPECT_EQ(x.title(), y.title());
+        EXPECT_EQ(x.fileIndex(), y.fileIndex());
+        EXPECT_EQ(x.fileByteOffset(), y.fileByteOffset());
+    }
+    EXPECT_EQ(a.catalog(), b.catalog());
+    EXPECT_EQ(a.cueSheet().remarks, b.cueSheet().remarks);
+    EXPECT_EQ(a.cueSheet().files[0].tracks[1].flags, b.cueSheet().files[0].tracks[1].flags);
+}
+
+} // anonymous namespace
+
+TEST_F(SnapshotTest, RoundTripsLayout) {
+    auto parsed = Disc::fromCue(cue);
+    ASSERT_TRUE(parsed.ok()) << parsed.error().message;
+    ASSERT_TRUE(parsed->saveSnapshot(snapshot).ok());
+    ASSERT_TRUE(std::filesystem::exists(snapshot));
+
+    rewriteCueKeepingStamp("BBBB");
+    DiscOptions options;
+    options.snapshotPath = snapshot;
+    auto loaded = Disc::fromCue(cue, options);
+    ASSERT_TRUE(loaded.ok()) << loaded.error().message;
+    EXPECT_EQ(loaded->title(), "AAAA"); // Came from the snapshot
+    expectSameLayout(*parsed, *loaded);
+
+    for (const auto& t : parsed->tracks()) {
+        int32_t lba = t.endLba() - 1;
+        auto a = parsed->readSector(lba);
+        auto b = loaded->readSector(lba);
+        ASSERT_TRUE(a.ok() && b.ok()) << "LBA " << lba;
+        EXPECT_EQ(a->data, b->data);
+    }
+}
+
+TEST_F(SnapshotTest, WrittenByFromCueAndRefreshedWhenStale) {
+    DiscOptions options;
+    options.snapshotPath = snapshot;
+    ASSERT_TRUE(Disc::fromCue(cue, options).ok());
+    ASSERT_TRUE(std::filesystem::exists(snapshot));
+
+    // A touched CUE sheet invalidates the snapshot
+    writeCue("CCCC");
+    std::filesystem::last_write_time(cue, std::filesystem::last_write_time(cue) + std::chrono::seconds(5));
+    auto disc = Disc::fromCue(cue, options);
+    ASSERT_TRUE(disc.ok());
+    EXPECT_EQ(disc->title(), "CCCC");
+
+    // ...and is rewritten, so the next open uses it again
+    rewriteCueKeepingStamp("DDDD");
+    disc = Disc::fromCue(cue, options);
+    ASSERT_TRUE(disc.ok());
+    EXPECT_EQ(disc->title(), "CCCC");
+
+    // So does a BIN file that changed size
+    std::ofstream(dir / "track3.bin", std::ios::binary | std::ios::app).write("\0\0\0\0", 4);
+    disc = Disc::fromCue(cue, options);
+    ASSERT_TRUE(disc.ok());
+    EXPECT_EQ(disc->title(), "DDDD");
+}
+
+TEST_F(SnapshotTest, IgnoresCorruptSnapshot) {
+    auto parsed = Disc::fromCue(cue);
+    ASSERT_TRUE(parsed.ok());
+    ASSERT_TRUE(parsed->saveSnapshot(snapshot).ok());
+
+    {
+        std::fstream f(snapshot, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(40);
+        f.put('\x7F');
+    }
+    rewriteCueKeepingStamp("EEEE");
+
+    DiscOptions options;
+    options.snapshotPath = snapshot;
+    auto disc = Disc::fromCue(cue, options);
+    ASSERT_TRUE(disc.ok());
+    EXPECT_EQ(disc->title(), "EEEE");
+    expectSameLayout(*parsed, *disc);
+
+    std::ofstream(snapshot, std::ios::trunc) << "short";
+    EXPECT_TRUE(Disc::fromCue(cue, options).ok());
+}
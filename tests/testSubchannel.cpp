@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "libcuebin/disc.hpp"
+#include "libcuebin/subchannel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+using Q = std::array<uint8_t, SUBCHANNEL_CHANNEL_SIZE>;
+
+// Bit-by-bit reference: byte j*8+k holds bit 7-k of byte j of every channel
+std::array<uint8_t, SUBCHANNEL_SIZE> referenceInterleave(const std::array<uint8_t, SUBCHANNEL_SIZE>& in)
+{
+    std::array<uint8_t, SUBCHANNEL_SIZE> out{};
+    for (size_t c = 0; c < 8; ++c) {
+        for (size_t j = 0; j < SUBCHANNEL_CHANNEL_SIZE; ++j) {
+            for (size_t k = 0; k < 8; ++k) {
+                if (in[c * SUBCHANNEL_CHANNEL_SIZE + j] & (0x80 >> k)) out[j * 8 + k] |= 0x80 >> c;
+            }
+        }
+    }
+    return out;
+}
+
+uint16_t referenceCrc16(const uint8_t* data, size_t size)
+{
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int k = 0; k < 8; ++k) crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+    }
+    return static_cast<uint16_t>(~crc);
+}
+
+Q makeQ(uint8_t control, uint8_t track, uint8_t index, MSF relative, MSF absolute)
+{
+    Q q{control, track, index,
+        toBcd(relative.minute), toBcd(relative.second), toBcd(relative.frame), 0,
+        toBcd(absolute.minute), toBcd(absolute.second), toBcd(absolute.frame), 0, 0};
+    uint16_t crc = referenceCrc16(q.data(), 10);
+    q[10] = static_cast<uint8_t>(crc >> 8);
+    q[11] = static_cast<uint8_t>(crc);
+    return q;
+}
+
+void writeFile(const std::filesystem::path& path, const std::vector<uint8_t>& data)
+{
+    std::ofstream(path, std::ios::binary)
+        .write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+class SubchannelTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_sub";
+        std::filesystem::create_directories(dir);
+
+        // Track 1: LBAs [0, 10). Track 2: PREGAP [10, 12), INDEX 01 at 12,
+        // INDEX 02 at 17, POSTGAP [32, 35). Lead-out at 35.
+        writeFile(dir / "data.bin", std::vector<uint8_t>(10 * RAW_SECTOR_SIZE));
+        writeFile(dir / "audio.bin", std::vector<uint8_t>(20 * RAW_SECTOR_SIZE));
+        std::ofstream(dir / "disc.cue")
+            << "FILE \"data.bin\" BINARY\n"
+            << "  TRACK 01 MODE1/2352\n    INDEX 01 00:00:00\n"
+            << "FILE \"audio.bin\" BINARY\n"
+            << "  TRACK 02 AUDIO\n    FLAGS DCP PRE\n    PREGAP 00:00:02\n"
+            << "    INDEX 01 00:00:00\n    INDEX 02 00:00:05\n    POSTGAP 00:00:03\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    static Q readQ(const Disc& disc, int32_t lba) {
+        Q q{};
+        auto status = disc.readSubchannelQ(lba, q);
+        EXPECT_TRUE(status.ok()) << "LBA " << lba;
+        return q;
+    }
+};
+
+} // anonymous namespace
+
+TEST(SubchannelCodecTest, InterleaveRoundTrip) {
+    std::array<uint8_t, SUBCHANNEL_SIZE> channels{};
+    uint32_t x = 7;
+    for (auto& b : channels) {
+        x = x * 1103515245 + 12345;
+        b = static_cast<uint8_t>(x >> 16);
+    }
+
+    std::array<uint8_t, SUBCHANNEL_SIZE> interleaved{};
+    interleaveSubchannel(channels, interleaved);
+    EXPECT_EQ(interleaved, referenceInterleave(channels));
+
+    std::array<uint8_t, SUBCHANNEL_SIZE> back{};
+    deinterleaveSubchannel(interleaved, back);
+    EXPECT_EQ(back, channels);
+
+    // Q is the second channel: bit 6 of each interleaved byte
+    std::array<uint8_t, SUBCHANNEL_SIZE> onlyQ{};
+    onlyQ[SUBCHANNEL_Q_OFFSET] = 0x41;
+    interleaveSubchannel(onlyQ, interleaved);
+    EXPECT_EQ(interleaved[1], 0x40);
+    EXPECT_EQ(interleaved[7], 0x40);
+    EXPECT_EQ(interleaved[0], 0x00);
+}
+
+TEST(SubchannelCodecTest, QCrc) {
+    Q q = makeQ(0x41, 0x01, 0x01, MSF(0, 0, 0), MSF(0, 2, 0));
+    EXPECT_EQ(subchannelQCrc(std::span<const uint8_t, 10>(q.data(), 10)),
+              static_cast<uint16_t>(q[10] << 8 | q[11]));
+    EXPECT_TRUE(checkSubchannelQ(q));
+    q[11] ^= 0x01;
+    EXPECT_FALSE(checkSubchannelQ(q));
+
+    EXPECT_EQ(toBcd(59), 0x59);
+    EXPECT_EQ(fromBcd(0x74), 74);
+}
+
+TEST_F(SubchannelTest, SynthesizesFromLayout) {
+    auto disc = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    EXPECT_FALSE(disc->hasSubchannelFile());
+
+    EXPECT_EQ(readQ(*disc, -150), makeQ(0x41, 0x01, 0x00, MSF(0, 2, 0), MSF(0, 0, 0)));
+    EXPECT_EQ(readQ(*disc, 0), makeQ(0x41, 0x01, 0x01, MSF(0, 0, 0), MSF(0, 2, 0)));
+    EXPECT_EQ(readQ(*disc, 9), makeQ(0x41, 0x01, 0x01, MSF(0, 0, 9), MSF(0, 2, 9)));
+
+    // FLAGS DCP PRE; the pregap counts down to INDEX 01
+    EXPECT_EQ(readQ(*disc, 10), makeQ(0x31, 0x02, 0x00, MSF(0, 0, 2), MSF(0, 2, 10)));
+    EXPECT_EQ(readQ(*disc, 12), makeQ(0x31, 0x02, 0x01, MSF(0, 0, 0), MSF(0, 2, 12)));
+    EXPECT_EQ(readQ(*disc, 17), makeQ(0x31, 0x02, 0x02, MSF(0, 0, 5), MSF(0, 2, 17)));
+    EXPECT_EQ(readQ(*disc, 33), makeQ(0x31, 0x02, 0x02, MSF(0, 0, 21), MSF(0, 2, 33)));
+    EXPECT_EQ(readQ(*disc, 35), makeQ(0x31, 0xAA, 0x01, MSF(0, 0, 0), MSF(0, 2, 35)));
+    EXPECT_EQ(readQ(*disc, 35 + 4500), makeQ(0x31, 0xAA, 0x01, MSF(1, 0, 0), MSF(1, 2, 35)));
+
+    Q q{};
+    EXPECT_EQ(disc->readSubchannelQ(-151, q).code(), ErrorCode::LBAOutOfRange);
+    EXPECT_EQ(disc->readSubchannelQ(100 * 4500, q).code(), ErrorCode::LBAOutOfRange);
+
+    // Full subchannel: P marks the pregap, R..W are empty
+    std::array<uint8_t, SUBCHANNEL_SIZE> sub{};
+    ASSERT_TRUE(disc->readSubchannel(11, sub).ok());
+    EXPECT_EQ(sub[0], 0xFF);
+    Q pregapQ = readQ(*disc, 11);
+    EXPECT_TRUE(std::equal(pregapQ.begin(), pregapQ.end(), sub.begin() + SUBCHANNEL_Q_OFFSET));
+    EXPECT_EQ(sub[95], 0x00);
+    ASSERT_TRUE(disc->readSubchannel(12, sub).ok());
+    EXPECT_EQ(sub[0], 0x00);
+}
+
+TEST_F(SubchannelTest, ReadsSidecarFile) {
+    // One record per stored sector: 10 of track 1, then 20 of track 2
+    std::vector<uint8_t> sub(30 * SUBCHANNEL_SIZE);
+    for (size_t i = 0; i < sub.size(); ++i) sub[i] = static_cast<uint8_t>(i / SUBCHANNEL_SIZE + 1);
+    writeFile(dir / "disc.sub", sub);
+
+    auto disc = Disc::fromCue(dir / "disc.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    EXPECT_TRUE(disc->hasSubchannelFile());
+
+    std::array<uint8_t, SUBCHANNEL_SIZE> record{};
+    std::array<uint8_t, SUBCHANNEL_SIZE> expected{};
+    expected.fill(11);
+    ASSERT_TRUE(disc->readSubchannel(12, record).ok());
+    EXPECT_EQ(record, expected);
+    EXPECT_EQ(readQ(*disc, 0), (Q{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}));
+    EXPECT_EQ(readQ(*disc, 31)[0], 30);
+
+    // Sectors absent from the files are still synthesized
+    EXPECT_EQ(readQ(*disc, 10), makeQ(0x31, 0x02, 0x00, MSF(0, 0, 2), MSF(0, 2, 10)));
+    EXPECT_EQ(readQ(*disc, 35)[1], Q_TRACK_LEAD_OUT);
+
+    Q q{};
+    ASSERT_TRUE(disc->synthesizeSubchannelQ(0, q).ok());
+    EXPECT_EQ(q, makeQ(0x41, 0x01, 0x01, MSF(0, 0, 0), MSF(0, 2, 0)));
+}
+
+TEST_F(SubchannelTest, ReadsCdgSubchannel) {
+    std::array<uint8_t, SUBCHANNEL_SIZE> channels{};
+    for (size_t i = 0; i < channels.size(); ++i) channels[i] = static_cast<uint8_t>(i * 13 + 5);
+    auto interleaved = referenceInterleave(channels);
+
+    std::vector<uint8_t> bin(3 * 2448, 0);
+    std::copy(interleaved.begin(), interleaved.end(), bin.begin() + 2448 + RAW_SECTOR_SIZE);
+    writeFile(dir / "karaoke.bin", bin);
+    std::ofstream(dir / "karaoke.cue")
+        << "FILE \"karaoke.bin\" BINARY\n  TRACK 01 CDG\n    INDEX 01 00:00:00\n";
+
+    auto disc = Disc::fromCue(dir / "karaoke.cue");
+    ASSERT_TRUE(disc.ok()) << disc.error().message;
+    std::array<uint8_t, SUBCHANNEL_SIZE> sub{};
+    ASSERT_TRUE(disc->readSubchannel(1, sub).ok());
+    EXPECT_EQ(sub, channels);
+}
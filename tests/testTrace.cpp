@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+#include "libcuebin/asyncReader.hpp"
+#include "libcuebin/blockCache.hpp"
+#include "libcuebin/cueParser.hpp"
+#include "libcuebin/disc.hpp"
+#include "libcuebin/trace.hpp"
+#include "ioUring.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace cuebin;
+
+namespace {
+
+// Trace points as "name:arg,arg,..." strings, in the order they fired
+class RecordingObserver : public TraceObserver {
+public:
+    std::vector<std::string> events() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_events;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.clear();
+    }
+
+    void fileOpen(const std::filesystem::path& path, size_t fileIndex, bool ok) noexcept override
+    {
+        record("open:" + path.filename().string() + "," + std::to_string(fileIndex) + "," + std::to_string(ok));
+    }
+    void readBegin(int32_t lba, int32_t sectors, size_t fileIndex, int64_t offset, int64_t size) noexcept override
+    {
+        record("begin:" + join(lba, sectors, fileIndex, offset, size));
+    }
+    void readEnd(int32_t lba, int32_t sectors, size_t fileIndex, int64_t offset, int64_t got) noexcept override
+    {
+        record("end:" + join(lba, sectors, fileIndex, offset, got));
+    }
+    void cacheHit(size_t fileIndex, int64_t blockIndex) noexcept override
+    {
+        record("hit:" + join(fileIndex, blockIndex));
+    }
+    void cacheMiss(size_t fileIndex, int64_t blockIndex) noexcept override
+    {
+        record("miss:" + join(fileIndex, blockIndex));
+    }
+    void readError(int32_t lba, int32_t sectors, ErrorCode code) noexcept override
+    {
+        record("error:" + join(lba, sectors, static_cast<int>(code)));
+    }
+    void parseBegin(const std::filesystem::path& path) noexcept override
+    {
+        record("parse:" + path.filename().string());
+    }
+    void parseEnd(const std::filesystem::path& path, Status status, size_t trackCount) noexcept override
+    {
+        record("parsed:" + path.filename().string() + ","
+               + (status ? std::string("ok") : std::to_string(static_cast<int>(status.code()))) + ","
+               + std::to_string(trackCount));
+    }
+
+private:
+    template <typename... Args>
+    static std::string join(Args... args)
+    {
+        std::string out;
+        ((out += std::to_string(args) + ","), ...);
+        out.pop_back();
+        return out;
+    }
+
+    void record(std::string event)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.push_back(std::move(event));
+    }
+
+    mutable std::mutex m_mutex;
+    std::vector<std::string> m_events;
+};
+
+class TraceTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+    std::filesystem::path cue;
+    RecordingObserver observer;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "libcuebin_trace";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        cue = dir / "game.cue";
+
+        std::vector<char> data(20 * RAW_SECTOR_SIZE, 0);
+        std::ofstream(dir / "data.bin", std::ios::binary)
+            .write(data.data(), static_cast<std::streamsize>(data.size()));
+        std::ofstream(dir / "audio.bin", std::ios::binary)
+            .write(data.data(), static_cast<std::streamsize>(data.size()));
+        std::ofstream(cue) << "FILE \"data.bin\" BINARY\n"
+                           << "  TRACK 01 MODE2/2352\n    INDEX 01 00:00:00\n"
+                           << "FILE \"audio.bin\" BINARY\n"
+                           << "  TRACK 02 AUDIO\n    INDEX 01 00:00:00\n";
+
+        setTraceObserver(&observer);
+    }
+
+    void TearDown() override {
+        setTraceObserver(nullptr);
+        std::filesystem::remove_all(dir);
+    }
+
+    static std::vector<std::string> without(std::vector<std::string> events, const std::string& prefix)
+    {
+        std::erase_if(events, [&](const std::string& e) { return e.starts_with(prefix); });
+        return events;
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(TraceTest, ParseFile) {
+    auto sheet = CueParser::parseFile(cue);
+    ASSERT_TRUE(sheet.ok());
+    auto missing = CueParser::parseFile(dir / "missing.cue");
+    ASSERT_FALSE(missing.ok());
+
+    if (!TRACING_ENABLED) {
+        EXPECT_TRUE(observer.events().empty());
+        return;
+    }
+    std::vector<std::string> expected = {
+        "parse:game.cue", "parsed:game.cue,ok,2",
+        "parse:missing.cue", "parsed:missing.cue," + std::to_string(static_cast<int>(ErrorCode::FileNotFound)) + ",0",
+    };
+    EXPECT_EQ(observer.events(), expected);
+}
+
+TEST_F(TraceTest, SectorReads) {
+    DiscOptions options;
+    options.ioBackend = IoBackend::Positional;
+    auto disc = Disc::fromCue(cue, options);
+    ASSERT_TRUE(disc.ok());
+
+    std::vector<uint8_t> buffer(4 * RAW_SECTOR_SIZE);
+    ASSERT_TRUE(disc->readSectorsInto(18, 4, buffer)); // Two sectors from each file
+    EXPECT_FALSE(disc->readSectorInto(40, buffer));
+
+    if (!TRACING_ENABLED) {
+        EXPECT_TRUE(observer.events().empty());
+        return;
+    }
+    std::vector<std::string> expected = {
+        "open:data.bin,0,1",
+        "begin:18,2,0,42336,4704",
+        "end:18,2,0,42336,4704",
+        "open:audio.bin,1,1",
+        "begin:20,2,1,0,4704",
+        "end:20,2,1,0,4704",
+        "error:40,1," + std::to_string(static_cast<int>(ErrorCode::LBAOutOfRange)),
+    };
+    EXPECT_EQ(without(observer.events(), "parse"), expected);
+}
+
+TEST_F(TraceTest, UserDataReads) {
+    DiscOptions options;
+    options.ioBackend = IoBackend::Positional;
+    auto disc = Disc::fromCue(cue, options);
+    ASSERT_TRUE(disc.ok());
+
+    std::vector<uint8_t> buffer(RAW_SECTOR_SIZE);
+    size_t written = 0;
+    ASSERT_TRUE(disc->readUserDataInto(25, 1, buffer, &written));
+
+    if (!TRACING_ENABLED) {
+        EXPECT_TRUE(observer.events().empty());
+        return;
+    }
+    std::vector<std::string> expected = {
+        "open:audio.bin,1,1",
+        "begin:25,1,1,11760,2352",
+        "end:25,1,1,11760,2352",
+    };
+    EXPECT_EQ(without(observer.events(), "parse"), expected);
+}
+
+TEST_F(TraceTest, BlockCacheLookups) {
+    BlockCache::clear();
+    DiscOptions options;
+    options.ioBackend = IoBackend::Positional;
+    options.useBlockCache = true;
+    auto disc = Disc::fromCue(cue, options);
+    ASSERT_TRUE(disc.ok());
+
+    std::array<uint8_t, RAW_SECTOR_SIZE> buffer;
+    ASSERT_TRUE(disc->readSectorInto(1, buffer));
+    ASSERT_TRUE(disc->readSectorInto(2, buffer));
+
+    if (!TRACING_ENABLED) {
+        EXPECT_TRUE(observer.events().empty());
+        return;
+    }
+    std::vector<std::string> expected = {"miss:0,0", "hit:0,0"};
+    auto events = observer.events();
+    std::erase_if(events, [](const std::string& e) { return !e.starts_with("miss") && !e.starts_with("hit"); });
+    EXPECT_EQ(events, expected);
+}
+
+TEST_F(TraceTest, AsyncReads) {
+    for (auto backend : {AsyncBackend::ThreadPool, AsyncBackend::IoUring}) {
+        auto reader = AsyncReader::create({backend});
+        if (!reader && reader.error().code == ErrorCode::Unsupported) continue;
+        ASSERT_TRUE(reader.ok()) << reader.error().message;
+
+        DiscOptions options;
+        options.ioBackend = IoBackend::Positional;
+        auto disc = Disc::fromCue(cue, options);
+        ASSERT_TRUE(disc.ok());
+        observer.clear();
+
+        std::vector<uint8_t> buffer(4 * RAW_SECTOR_SIZE);
+        std::array<AsyncCompletion, 1> done{};
+        ASSERT_TRUE(reader->submit(*disc, 18, 4, buffer).ok()); // Two sectors from each file
+        ASSERT_EQ(reader->wait(done, 1), 1u);
+        ASSERT_TRUE(done[0].status);
+
+        if (!TRACING_ENABLED) {
+            EXPECT_TRUE(observer.events().empty());
+            continue;
+        }
+        // io_uring completes the two reads in either order
+        std::vector<std::string> expected = {
+            "begin:18,2,0,42336,4704", "begin:20,2,1,0,4704",
+            "end:18,2,0,42336,4704", "end:20,2,1,0,4704",
+        };
+        auto events = without(observer.events(), "open");
+        std::sort(events.begin(), events.end());
+        EXPECT_EQ(events, expected) << static_cast<int>(backend);
+
+#ifdef LIBCUEBIN_HAS_IO_URING
+        if (backend != AsyncBackend::IoUring) continue;
+
+        // Reads that never reach the kernel end unread, then fail the request
+        observer.clear();
+        detail::failIoUringSubmit();
+        ASSERT_TRUE(reader->submit(*disc, 18, 4, buffer).ok());
+        ASSERT_EQ(reader->wait(done, 1), 1u);
+        EXPECT_FALSE(done[0].status);
+        expected = {
+            "begin:18,2,0,42336,4704", "begin:20,2,1,0,4704",
+            "end:18,2,0,42336,-1", "end:20,2,1,0,-1",
+            "error:18,4," + std::to_string(static_cast<int>(ErrorCode::FileReadError)),
+        };
+        EXPECT_EQ(observer.events(), expected);
+#endif
+    }
+}